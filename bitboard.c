@@ -0,0 +1,193 @@
+/**
+ * @file bitboard.c
+ * @brief Plateau de jeu en bits et ses noyaux de parcours en largeur, scalaire et AVX2
+ * @author Noah Le Goff, Sacha Mace
+ */
+
+/* Fichiers inclus */
+#include <string.h>
+#include "bitboard.h"
+
+// noyaux du plateau en bits, choisis à l'exécution par initNoyauCollision
+void (*etendreBitboard)(const tBitboard *frontiere, const tBitboard *libres, tBitboard *suivante) = etendreBitboardScalaire;
+bool (*avancerCouche)(tBitboard *frontiere, tBitboard *restantes, const tPortails *portails) = avancerCoucheScalaire;
+
+// Un parcours en largeur case par case passe son temps dans la file. Sur le plateau en
+// bits, une colonne de HAUTEUR_PLATEAU cases tient dans un mot de 64 bits (bit y pour la
+// case (x, y)) : les voisines verticales de toute une colonne sont deux décalages du mot,
+// les voisines horizontales les mots des colonnes d'à côté, et les trous du bord relient
+// le premier et le dernier bit d'une colonne, la première et la dernière colonne. Une
+// couche entière du parcours coûte ainsi quelques opérations par colonne, quatre colonnes
+// à la fois avec AVX2 ; les portails d'une carte échangent ensuite leurs deux bouts, un
+// bit à la fois, en dehors des noyaux et seulement pour une partie qui en a.
+
+/**
+ * @brief Procédure qui range les cases libres du plateau de jeu dans un plateau en bits.
+ * @param cases de type char*, Entrée : le plateau à plat, BORDURE pour une case bloquée
+ * @param libres de type tBitboard, Sortie : un bit à 1 pour chaque case libre
+ */
+void rangerBitboard(const char *cases, tBitboard *libres)
+{
+	memset(libres, 0, sizeof(*libres));
+	for (int x = 1; x <= LARGEUR_PLATEAU; x++)
+	{
+		const char *colonne = &cases[cellule_80x40(&GEOMETRIE_PLATEAU, x, 0)];
+		for (int y = 1; y <= HAUTEUR_PLATEAU; y++)
+		{
+			libres->colonnes[x] |= (uint64_t)(colonne[y] != BORDURE) << y;
+		}
+	}
+}
+
+/**
+ * @brief Procédure qui ajoute une case à un plateau en bits.
+ * @param bitboard de type tBitboard, Entrée/Sortie : le plateau en bits
+ * @param c de type int, Entrée : l'indice à plat de la case
+ */
+void poserBit(tBitboard *bitboard, int c)
+{
+	bitboard->colonnes[c / (HAUTEUR_PLATEAU + 1)] |= 1ULL << (c % (HAUTEUR_PLATEAU + 1));
+}
+
+/**
+ * @brief Fonction qui dit si une case est dans un plateau en bits.
+ * @param bitboard de type tBitboard, Entrée : le plateau en bits
+ * @param c de type int, Entrée : l'indice à plat de la case
+ */
+bool testerBit(const tBitboard *bitboard, int c)
+{
+	return (bitboard->colonnes[c / (HAUTEUR_PLATEAU + 1)] >> (c % (HAUTEUR_PLATEAU + 1))) & 1;
+}
+
+/**
+ * @brief Fonction qui compte les cases d'un plateau en bits.
+ * @param bitboard de type tBitboard, Entrée : le plateau en bits
+ */
+int compterBits(const tBitboard *bitboard)
+{
+	int nombre = 0;
+	for (int x = 1; x <= LARGEUR_PLATEAU; x++)
+	{
+		nombre += __builtin_popcountll(bitboard->colonnes[x]);
+	}
+	return nombre;
+}
+
+/**
+ * @brief Procédure qui calcule les cases libres voisines d'une frontière, une colonne à la fois.
+ * @param frontiere de type tBitboard, Entrée : la frontière
+ * @param libres de type tBitboard, Entrée : les cases où le parcours peut aller
+ * @param suivante de type tBitboard, Sortie : les voisines libres de la frontière (distincte de frontiere)
+ */
+void etendreBitboardScalaire(const tBitboard *frontiere, const tBitboard *libres, tBitboard *suivante)
+{
+	const uint64_t *f = frontiere->colonnes;
+	for (int x = 1; x <= LARGEUR_PLATEAU; x++)
+	{
+		uint64_t voisines = (f[x] << 1) | (f[x] >> 1) | f[x - 1] | f[x + 1]
+						  | (((f[x] >> 1) & 1) << HAUTEUR_PLATEAU) | (((f[x] >> HAUTEUR_PLATEAU) & 1) << 1);
+		suivante->colonnes[x] = voisines & libres->colonnes[x];
+	}
+	// les trous de gauche et de droite
+	suivante->colonnes[1] |= f[LARGEUR_PLATEAU] & libres->colonnes[1];
+	suivante->colonnes[LARGEUR_PLATEAU] |= f[1] & libres->colonnes[LARGEUR_PLATEAU];
+}
+
+/**
+ * @brief Procédure qui fait passer les portails de la carte à une couche : la frontière qui
+ * entre dans un bout ressort par l'autre, au même tour. On ne s'arrête jamais sur un bout
+ * en y entrant, seulement en sortant de l'autre.
+ * @param portails de type tPortails, Entrée : les portails de la partie
+ * @param frontiere de type tBitboard, Entrée : la frontière d'où part la couche
+ * @param libres de type tBitboard, Entrée : les cases où le parcours peut aller
+ * @param suivante de type tBitboard, Entrée/Sortie : la couche
+ */
+void passerPortailsBitboard(const tPortails *portails, const tBitboard *frontiere, const tBitboard *libres, tBitboard *suivante)
+{
+	const int pas = HAUTEUR_PLATEAU + 1;
+	for (int p = 0; p < portails->nbPaires; p++)
+	{
+		int a = portails->bouts[2 * p], b = portails->bouts[2 * p + 1];
+		// les bouts ne sont jamais sur le bord : leurs quatre voisines sont à côté à plat
+		bool versB = testerBit(frontiere, a - 1) || testerBit(frontiere, a + 1) || testerBit(frontiere, a - pas) || testerBit(frontiere, a + pas);
+		bool versA = testerBit(frontiere, b - 1) || testerBit(frontiere, b + 1) || testerBit(frontiere, b - pas) || testerBit(frontiere, b + pas);
+		uint64_t bitA = 1ULL << (a % pas), bitB = 1ULL << (b % pas);
+		suivante->colonnes[a / pas] &= ~bitA;
+		suivante->colonnes[b / pas] &= ~bitB;
+		suivante->colonnes[a / pas] |= versA ? bitA & libres->colonnes[a / pas] : 0;
+		suivante->colonnes[b / pas] |= versB ? bitB & libres->colonnes[b / pas] : 0;
+	}
+}
+
+/**
+ * @brief Fonction qui avance un parcours en largeur d'une couche : la nouvelle frontière
+ * est faite des cases restantes voisines de l'ancienne, qui ne sont plus restantes. Les
+ * cases atteintes se comptent à la fin, par les cases qui ne sont plus restantes.
+ * @param frontiere de type tBitboard, Entrée/Sortie : la frontière du parcours
+ * @param restantes de type tBitboard, Entrée/Sortie : les cases libres pas encore atteintes
+ * @param portails de type tPortails, Entrée : les portails de la partie, ou NULL
+ * @return false quand la nouvelle frontière est vide : le parcours est fini
+ */
+bool avancerCoucheScalaire(tBitboard *frontiere, tBitboard *restantes, const tPortails *portails)
+{
+	tBitboard suivante;
+	etendreBitboardScalaire(frontiere, restantes, &suivante);
+	if (portails != NULL)
+	{
+		passerPortailsBitboard(portails, frontiere, restantes, &suivante);
+	}
+	uint64_t avance = 0;
+	for (int x = 1; x <= LARGEUR_PLATEAU; x++)
+	{
+		restantes->colonnes[x] &= ~suivante.colonnes[x];
+		frontiere->colonnes[x] = suivante.colonnes[x];
+		avance |= suivante.colonnes[x];
+	}
+	return avance != 0;
+}
+
+#ifdef NOYAU_X86
+/**
+ * @brief Version AVX2 de etendreBitboardScalaire : quatre colonnes par registre.
+ */
+__attribute__((target("avx2"))) void etendreBitboardAVX2(const tBitboard *frontiere, const tBitboard *libres, tBitboard *suivante)
+{
+	const uint64_t *f = frontiere->colonnes;
+	const __m256i un = _mm256_set1_epi64x(1);
+	for (int x = 1; x <= LARGEUR_PLATEAU; x += 4)
+	{
+		__m256i centre = _mm256_loadu_si256((const __m256i *)&f[x]);
+		__m256i voisines = _mm256_or_si256(_mm256_slli_epi64(centre, 1), _mm256_srli_epi64(centre, 1));
+		voisines = _mm256_or_si256(voisines, _mm256_loadu_si256((const __m256i *)&f[x - 1]));
+		voisines = _mm256_or_si256(voisines, _mm256_loadu_si256((const __m256i *)&f[x + 1]));
+		voisines = _mm256_or_si256(voisines, _mm256_slli_epi64(_mm256_and_si256(_mm256_srli_epi64(centre, 1), un), HAUTEUR_PLATEAU));
+		voisines = _mm256_or_si256(voisines, _mm256_slli_epi64(_mm256_and_si256(_mm256_srli_epi64(centre, HAUTEUR_PLATEAU), un), 1));
+		_mm256_storeu_si256((__m256i *)&suivante->colonnes[x], _mm256_and_si256(voisines, _mm256_loadu_si256((const __m256i *)&libres->colonnes[x])));
+	}
+	suivante->colonnes[1] |= f[LARGEUR_PLATEAU] & libres->colonnes[1];
+	suivante->colonnes[LARGEUR_PLATEAU] |= f[1] & libres->colonnes[LARGEUR_PLATEAU];
+}
+
+/**
+ * @brief Version AVX2 de avancerCoucheScalaire.
+ */
+__attribute__((target("avx2"))) bool avancerCoucheAVX2(tBitboard *frontiere, tBitboard *restantes, const tPortails *portails)
+{
+	tBitboard suivante;
+	etendreBitboardAVX2(frontiere, restantes, &suivante);
+	if (portails != NULL)
+	{
+		passerPortailsBitboard(portails, frontiere, restantes, &suivante);
+	}
+	__m256i avance = _mm256_setzero_si256();
+	for (int x = 1; x <= LARGEUR_PLATEAU; x += 4)
+	{
+		__m256i couche = _mm256_loadu_si256((const __m256i *)&suivante.colonnes[x]);
+		__m256i *restantesX = (__m256i *)&restantes->colonnes[x];
+		_mm256_storeu_si256(restantesX, _mm256_andnot_si256(couche, _mm256_loadu_si256(restantesX)));
+		_mm256_storeu_si256((__m256i *)&frontiere->colonnes[x], couche);
+		avance = _mm256_or_si256(avance, couche);
+	}
+	return !_mm256_testz_si256(avance, avance);
+}
+#endif
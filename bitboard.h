@@ -0,0 +1,33 @@
+/**
+ * @file bitboard.h
+ * @brief Plateau de jeu en bits et ses noyaux de parcours en largeur, scalaire et AVX2
+ * @author Noah Le Goff, Sacha Mace
+ *
+ * Une colonne du plateau tient dans un mot (tBitboard, déclaré par jeu.h avec les
+ * territoires de Voronoi qui s'en servent) : un pas de parcours en largeur étend
+ * toute la frontière à la fois par décalages et masques. etendreBitboard et
+ * avancerCouche sont choisis à l'exécution par initNoyauCollision.
+ */
+
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include "jeu.h"
+
+void rangerBitboard(const char *cases, tBitboard *libres);
+void poserBit(tBitboard *bitboard, int c);
+bool testerBit(const tBitboard *bitboard, int c);
+int compterBits(const tBitboard *bitboard);
+void etendreBitboardScalaire(const tBitboard *frontiere, const tBitboard *libres, tBitboard *suivante);
+void passerPortailsBitboard(const tPortails *portails, const tBitboard *frontiere, const tBitboard *libres, tBitboard *suivante);
+bool avancerCoucheScalaire(tBitboard *frontiere, tBitboard *restantes, const tPortails *portails);
+#ifdef NOYAU_X86
+__attribute__((target("avx2"))) void etendreBitboardAVX2(const tBitboard *frontiere, const tBitboard *libres, tBitboard *suivante);
+__attribute__((target("avx2"))) bool avancerCoucheAVX2(tBitboard *frontiere, tBitboard *restantes, const tPortails *portails);
+#endif
+
+// noyaux du plateau en bits, choisis à l'exécution par initNoyauCollision
+extern void (*etendreBitboard)(const tBitboard *frontiere, const tBitboard *libres, tBitboard *suivante);
+extern bool (*avancerCouche)(tBitboard *frontiere, tBitboard *restantes, const tPortails *portails);
+
+#endif
@@ -0,0 +1,607 @@
+/**
+ * @file cartes.c
+ * @brief Cartes du jeu snake : lecture d'un fichier de carte, contexte des parties et bancs sur plusieurs cartes
+ * @author Noah Le Goff, Sacha Mace
+ */
+
+/* Fichiers inclus */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include "cartes.h"
+#include "planificateur.h"
+#include "tournoi.h"
+
+/**
+ * @brief Procédure qui prépare une carte vide : bordure fermée, sans trou ni pavé, serpents
+ * à leur départ habituel et pommes tirées au hasard.
+ * @param carte de type tCarte, Sortie : la carte vide
+ */
+void initCarte(tCarte *carte)
+{
+	memset(carte, 0, sizeof(*carte));
+	for (int x = 1; x <= LARGEUR_PLATEAU; x++)
+	{
+		for (int y = 1; y <= HAUTEUR_PLATEAU; y++)
+		{
+			bool bord = (x == 1 || x == LARGEUR_PLATEAU || y == 1 || y == HAUTEUR_PLATEAU);
+			carte->plateau[x][y] = bord ? BORDURE : VIDE;
+		}
+	}
+	carte->departX[0] = X_INITIAL_SERPENT1;
+	carte->departY[0] = Y_INITIAL_SERPENT1;
+	carte->directions[0] = indiceDirection(DROITE);
+	carte->departX[1] = X_INITIAL_SERPENT2;
+	carte->departY[1] = Y_INITIAL_SERPENT2;
+	carte->directions[1] = indiceDirection(GAUCHE);
+}
+
+/**
+ * @brief Fonction qui applique une ligne d'un fichier de carte. Les instructions, une par
+ * ligne, sont appliquées dans l'ordre du fichier (un mur peut refermer un trou ouvert plus
+ * haut) ; ce qui suit un '#' est un commentaire :
+ *   pave X Y              pavé de TAILLE_PAVE de côté, coin haut-gauche en (X, Y)
+ *   mur X Y [LARGEUR HAUTEUR]   rectangle de murs (une case par défaut)
+ *   trou X Y              ouverture du bord en (X, Y) et en face, sur le bord opposé
+ *   serpent N X Y DIRECTION   tête du serpent N (1 ou 2), qui part vers haut, bas, gauche
+ *                         ou droite, ses anneaux derrière elle
+ *   pomme X Y             pomme suivante du calendrier (les autres sont tirées au hasard)
+ *   portail X1 Y1 X2 Y2   portail entre deux cases hors du bord : un serpent qui entre dans
+ *                         l'une ressort par l'autre
+ * @param carte de type tCarte, Entrée/Sortie : la carte en cours de lecture
+ * @param ligne de type char tableau, Entrée : la ligne, sans son commentaire
+ * @return NULL si la ligne est correcte ou vide, sinon le message d'erreur
+ */
+const char *lireInstructionCarte(tCarte *carte, const char *ligne)
+{
+	static const char *NOMS_DIRECTIONS[4] = {"haut", "bas", "gauche", "droite"};
+	char mot[16], nom[16];
+	int a, b, c, d;
+	int lus = sscanf(ligne, "%15s %d %d %d %d", mot, &a, &b, &c, &d);
+	if (lus < 1)
+	{
+		return NULL;
+	}
+	bool dedans = (lus >= 3 && a >= 1 && a <= LARGEUR_PLATEAU && b >= 1 && b <= HAUTEUR_PLATEAU);
+
+	if (strcmp(mot, "pave") == 0 || strcmp(mot, "mur") == 0)
+	{
+		bool pave = (mot[0] == 'p');
+		if ((pave && lus != 3) || (!pave && lus != 3 && lus != 5))
+		{
+			return pave ? "attendu : pave X Y" : "attendu : mur X Y [LARGEUR HAUTEUR]";
+		}
+		int largeur = pave ? TAILLE_PAVE : (lus == 5) ? c : 1;
+		int hauteur = pave ? TAILLE_PAVE : (lus == 5) ? d : 1;
+		if (!dedans || largeur < 1 || hauteur < 1 || a + largeur - 1 > LARGEUR_PLATEAU || b + hauteur - 1 > HAUTEUR_PLATEAU)
+		{
+			return "rectangle hors du plateau";
+		}
+		if (pave && carte->nbPaves == MAX_PAVES)
+		{
+			return "trop de pavés";
+		}
+		if (pave)
+		{
+			carte->lesPavesX[carte->nbPaves] = a;
+			carte->lesPavesY[carte->nbPaves] = b;
+			carte->nbPaves++;
+		}
+		for (int x = a; x < a + largeur; x++)
+		{
+			memset(&carte->plateau[x][b], BORDURE, hauteur);
+		}
+	}
+	else if (strcmp(mot, "trou") == 0)
+	{
+		// le plateau se referme sur lui-même : un trou n'a de sens qu'avec sa case d'en face
+		if (lus != 3)
+		{
+			return "attendu : trou X Y";
+		}
+		if (dedans && (a == 1 || a == LARGEUR_PLATEAU) && b > 1 && b < HAUTEUR_PLATEAU)
+		{
+			carte->plateau[1][b] = carte->plateau[LARGEUR_PLATEAU][b] = VIDE;
+		}
+		else if (dedans && (b == 1 || b == HAUTEUR_PLATEAU) && a > 1 && a < LARGEUR_PLATEAU)
+		{
+			carte->plateau[a][1] = carte->plateau[a][HAUTEUR_PLATEAU] = VIDE;
+		}
+		else
+		{
+			return "un trou doit être sur le bord, hors des coins";
+		}
+	}
+	else if (strcmp(mot, "serpent") == 0)
+	{
+		if (sscanf(ligne, "%15s %d %d %d %15s", mot, &a, &b, &c, nom) != 5 || (a != 1 && a != 2))
+		{
+			return "attendu : serpent 1|2 X Y haut|bas|gauche|droite";
+		}
+		int direction = 0;
+		while (direction < 4 && strcmp(nom, NOMS_DIRECTIONS[direction]) != 0)
+		{
+			direction++;
+		}
+		if (direction == 4)
+		{
+			return "direction inconnue";
+		}
+		carte->departX[a - 1] = b;
+		carte->departY[a - 1] = c;
+		carte->directions[a - 1] = direction;
+	}
+	else if (strcmp(mot, "portail") == 0)
+	{
+		if (lus != 5)
+		{
+			return "attendu : portail X1 Y1 X2 Y2";
+		}
+		if (a <= 1 || a >= LARGEUR_PLATEAU || b <= 1 || b >= HAUTEUR_PLATEAU || c <= 1 || c >= LARGEUR_PLATEAU
+			|| d <= 1 || d >= HAUTEUR_PLATEAU || (a == c && b == d))
+		{
+			return "un portail relie deux cases distinctes, hors du bord";
+		}
+		if (carte->nbPortails == MAX_PORTAILS)
+		{
+			return "trop de portails";
+		}
+		int bout = 2 * carte->nbPortails;
+		carte->portailsX[bout] = a;
+		carte->portailsY[bout] = b;
+		carte->portailsX[bout + 1] = c;
+		carte->portailsY[bout + 1] = d;
+		carte->nbPortails++;
+	}
+	else if (strcmp(mot, "pomme") == 0)
+	{
+		if (lus != 3 || !dedans)
+		{
+			return "attendu : pomme X Y, dans le plateau";
+		}
+		if (carte->nbPommes == NB_POMMES)
+		{
+			return "trop de pommes prévues";
+		}
+		carte->lesPommesX[carte->nbPommes] = a;
+		carte->lesPommesY[carte->nbPommes] = b;
+		carte->nbPommes++;
+	}
+	else
+	{
+		return "instruction inconnue";
+	}
+	return NULL;
+}
+
+/**
+ * @brief Fonction qui vérifie une carte lue en entier : les portails doivent être sur des
+ * cases libres et distinctes, et pas plus de MAX_PORTAILS avec les paires de trous ; les
+ * serpents doivent tenir dans le plateau sans toucher un mur, un portail ni l'autre
+ * serpent, et la première pomme prévue doit être sur une case libre (les suivantes, hors
+ * d'un portail, sont vérifiées quand elles apparaissent).
+ * @param carte de type tCarte, Entrée : la carte
+ * @param erreur de type char*, Sortie : le message d'erreur
+ * @return true si la carte est jouable
+ */
+bool verifierCarte(const tCarte *carte, const char **erreur)
+{
+	tPlateau occupe;
+	int portails[2 * MAX_PORTAILS];
+	memcpy(occupe, carte->plateau, sizeof(tPlateau));
+	for (int b = 0; b < 2 * carte->nbPortails; b++)
+	{
+		char *bout = &occupe[carte->portailsX[b]][carte->portailsY[b]];
+		if (*bout != VIDE)
+		{
+			*erreur = (*bout == PORTAIL) ? "deux portails partagent une case" : "un portail est muré";
+			return false;
+		}
+		*bout = PORTAIL;
+	}
+	if (releverPortails(&GEOMETRIE_PLATEAU, &carte->plateau[0][0], portails) + carte->nbPortails > MAX_PORTAILS)
+	{
+		*erreur = "trop de paires de trous et de portails";
+		return false;
+	}
+	for (int s = 0; s < 2; s++)
+	{
+		int d = carte->directions[s];
+		for (int i = 0; i < TAILLE; i++)
+		{
+			int x = carte->departX[s] - i * DECALAGE_X[d], y = carte->departY[s] - i * DECALAGE_Y[d];
+			if (x <= 1 || x >= LARGEUR_PLATEAU || y <= 1 || y >= HAUTEUR_PLATEAU || occupe[x][y] != VIDE)
+			{
+				*erreur = (s == 0) ? "le serpent 1 ne tient pas à son départ" : "le serpent 2 ne tient pas à son départ";
+				return false;
+			}
+			occupe[x][y] = CORPS;
+		}
+	}
+	if (carte->nbPommes > 0 && occupe[carte->lesPommesX[0]][carte->lesPommesY[0]] != VIDE)
+	{
+		*erreur = "la première pomme n'est pas sur une case libre";
+		return false;
+	}
+	for (int p = 1; p < carte->nbPommes; p++)
+	{
+		if (occupe[carte->lesPommesX[p]][carte->lesPommesY[p]] == PORTAIL)
+		{
+			*erreur = "une pomme est sur un portail";
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Fonction qui charge une carte en un seul passage sur le fichier : chaque ligne est
+ * appliquée directement au plateau, sans représentation intermédiaire.
+ * @param chemin de type char tableau, Entrée : le fichier de la carte
+ * @param carte de type tCarte, Sortie : la carte chargée
+ * @return false si le fichier est illisible ou incorrect (l'erreur est affichée avec sa ligne)
+ */
+bool chargerCarte(const char *chemin, tCarte *carte)
+{
+	FILE *fichier = fopen(chemin, "r");
+	if (fichier == NULL)
+	{
+		perror(chemin);
+		return false;
+	}
+	initCarte(carte);
+	char ligne[256];
+	const char *erreur = NULL;
+	int numero = 0;
+	while (erreur == NULL && fgets(ligne, sizeof(ligne), fichier) != NULL)
+	{
+		numero++;
+		char *commentaire = strchr(ligne, '#');
+		if (commentaire != NULL)
+		{
+			*commentaire = '\0';
+		}
+		erreur = lireInstructionCarte(carte, ligne);
+	}
+	fclose(fichier);
+	if (erreur != NULL)
+	{
+		fprintf(stderr, "%s:%d : %s\n", chemin, numero, erreur);
+		return false;
+	}
+	if (!verifierCarte(carte, &erreur))
+	{
+		fprintf(stderr, "%s : %s\n", chemin, erreur);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Procédure qui ajoute un chemin de l'IA habituelle : à la place de son côté s'il
+ * n'a pas encore de trou, sinon à la suite.
+ * @param portails de type tPortails, Entrée/Sortie : les portails du plateau
+ * @param cote de type int, Entrée : le côté (CHEMIN_HAUT - CHEMIN_HAUT ... CHEMIN_DROITE -
+ * CHEMIN_HAUT), -1 pour un portail
+ * @param entreeX, entreeY de type int, Entrée : la case visée pour entrer
+ * @param sortieX, sortieY de type int, Entrée : la case d'où l'on compte après le passage
+ */
+void ajouterChemin(tPortails *portails, int cote, int entreeX, int entreeY, int sortieX, int sortieY)
+{
+	int rang = (cote >= 0 && portails->entreesX[cote] < 0) ? cote : portails->nbChemins;
+	if (rang == MAX_CHEMINS)
+	{
+		return;
+	}
+	portails->nbChemins += (rang == portails->nbChemins);
+	portails->entreesX[rang] = entreeX;
+	portails->entreesY[rang] = entreeY;
+	portails->sortiesX[rang] = sortieX;
+	portails->sortiesY[rang] = sortieY;
+}
+
+/**
+ * @brief Procédure qui prépare le contexte d'une série de parties : initEtatJeu part du
+ * plateau de la carte, et la table des portails reçoit ses portails et les chemins de l'IA
+ * habituelle par ses trous. Seules les stratégies intégrées sont connues. Le contexte ne
+ * change plus tant qu'une de ses parties tourne.
+ * @param contexte de type tContexte, Sortie : le contexte
+ * @param carte de type tCarte, Entrée : la carte, qui doit rester en place aussi longtemps
+ * que le contexte, ou NULL pour le plateau habituel
+ * @param modele de type tModele, Entrée : la politique, qui doit rester en place aussi
+ * longtemps que le contexte, ou NULL
+ */
+void initContexte(tContexte *contexte, const tCarte *carte, const tModele *modele)
+{
+	static const tStrategie INTEGREES[NB_STRATEGIES] = {{"version2", NULL}, {"version3", NULL}, {"version4", NULL},
+														{"jps", NULL}, {"voronoi", NULL}, {"politique", NULL}};
+	tPortails *portails = &contexte->portails;
+	const int pas = HAUTEUR_PLATEAU + 1;
+	contexte->carte = carte;
+	contexte->modele = modele;
+	memcpy(contexte->strategies, INTEGREES, sizeof(INTEGREES));
+	contexte->nbStrategies = NB_STRATEGIES;
+
+	// murs de la carte hors du bord et des pavés, cumulés pour compter ceux d'un rectangle
+	memset(contexte->mursCumules, 0, sizeof(contexte->mursCumules));
+	contexte->nbMurs = 0;
+	for (int x = 1; carte != NULL && x <= LARGEUR_PLATEAU; x++)
+	{
+		for (int y = 1; y <= HAUTEUR_PLATEAU; y++)
+		{
+			bool mur = x > 1 && x < LARGEUR_PLATEAU && y > 1 && y < HAUTEUR_PLATEAU && carte->plateau[x][y] == BORDURE;
+			for (int p = 0; mur && p < carte->nbPaves; p++)
+			{
+				mur = x < carte->lesPavesX[p] || x >= carte->lesPavesX[p] + TAILLE_PAVE || y < carte->lesPavesY[p] || y >= carte->lesPavesY[p] + TAILLE_PAVE;
+			}
+			contexte->nbMurs += mur;
+			contexte->mursCumules[x][y] = mur + contexte->mursCumules[x - 1][y] + contexte->mursCumules[x][y - 1] - contexte->mursCumules[x - 1][y - 1];
+		}
+	}
+
+	if (carte == NULL)
+	{
+		*portails = (tPortails)PORTAILS_HABITUELS;
+		return;
+	}
+
+	memset(portails, 0, sizeof(*portails));
+	for (int cote = 0; cote < 4; cote++)
+	{
+		portails->entreesX[cote] = portails->entreesY[cote] = -1;
+	}
+	portails->nbChemins = 4;
+	// trous du bord : on vise la case juste au-delà du trou et l'on compte depuis le bord opposé
+	for (int x = 2; x < LARGEUR_PLATEAU; x++)
+	{
+		if (carte->plateau[x][1] != BORDURE && carte->plateau[x][HAUTEUR_PLATEAU] != BORDURE)
+		{
+			ajouterChemin(portails, CHEMIN_HAUT - CHEMIN_HAUT, x, 0, x, HAUTEUR_PLATEAU);
+			ajouterChemin(portails, CHEMIN_BAS - CHEMIN_HAUT, x, HAUTEUR_PLATEAU, x, 0);
+		}
+	}
+	for (int y = 2; y < HAUTEUR_PLATEAU; y++)
+	{
+		if (carte->plateau[1][y] != BORDURE && carte->plateau[LARGEUR_PLATEAU][y] != BORDURE)
+		{
+			ajouterChemin(portails, CHEMIN_GAUCHE - CHEMIN_HAUT, 0, y, LARGEUR_PLATEAU, y);
+			ajouterChemin(portails, CHEMIN_DROITE - CHEMIN_HAUT, LARGEUR_PLATEAU, y, 0, y);
+		}
+	}
+	// portails : chaque bout renvoie à l'autre
+	portails->nbPaires = carte->nbPortails;
+	for (int b = 0; b < 2 * carte->nbPortails; b++)
+	{
+		int c = cellule_80x40(&GEOMETRIE_PLATEAU, carte->portailsX[b], carte->portailsY[b]);
+		portails->bouts[b] = c;
+		portails->sorties[c] = cellule_80x40(&GEOMETRIE_PLATEAU, carte->portailsX[b ^ 1], carte->portailsY[b ^ 1]);
+		// un bout est un obstacle pour qui le longe : ses huit voisines sont des points de saut
+		for (int dx = -1; dx <= 1; dx++)
+		{
+			memset(&portails->proches[c + dx * pas - 1], true, 3);
+		}
+		ajouterChemin(portails, -1, carte->portailsX[b], carte->portailsY[b], carte->portailsX[b ^ 1], carte->portailsY[b ^ 1]);
+	}
+}
+
+/**
+ * @brief Fonction qui mesure les stratégies sur un ensemble de cartes : pour chaque carte de
+ * la liste (un chemin par ligne), nbParties parties de graines graine, graine + 1, ...
+ * sont jouées sur nbFils fils comme celles d'un tournoi, puis une ligne résume la carte :
+ * les moyennes des parties terminées, et à part le nombre de parties arrêtées après
+ * LIMITE_TOURS_TOURNOI tours.
+ * Une carte sans pomme prévue tire toutes ses pommes au hasard.
+ * @param base de type tContexte, Entrée : le contexte dont chaque carte reprend la politique
+ * et les stratégies
+ * @param liste de type char tableau, Entrée : le fichier de la liste des cartes
+ * @param nbParties de type int, Entrée : le nombre de parties par carte
+ * @param graine de type uint64_t, Entrée : la graine de la première partie
+ * @param nbFils de type int, Entrée : le nombre de fils
+ * @param strategies de type int tableau, Entrée : la stratégie de chaque serpent
+ * @return EXIT_SUCCESS, ou EXIT_FAILURE si une carte, un fichier ou la mémoire fait défaut
+ */
+int lancerBancCartes(const tContexte *base, const char *liste, int nbParties, uint64_t graine, int nbFils, const int strategies[2])
+{
+	FILE *fichier = fopen(liste, "r");
+	tCarte *carte = malloc(sizeof(tCarte));
+	tContexte *contexte = malloc(sizeof(tContexte));
+	tPartieTournoi *parties = malloc(nbParties * sizeof(tPartieTournoi));
+	bool pret = fichier != NULL && carte != NULL && contexte != NULL && parties != NULL;
+	if (fichier == NULL)
+	{
+		perror(liste);
+	}
+	else if (!pret)
+	{
+		fprintf(stderr, "Mémoire insuffisante pour %d parties\n", nbParties);
+	}
+
+	signal(SIGINT, demanderArret);
+	signal(SIGTERM, demanderArret);
+	if (pret)
+	{
+		printf("Cartes de %s, %d parties par carte, %s contre %s\n", liste, nbParties, base->strategies[strategies[0]].nom, base->strategies[strategies[1]].nom);
+		printf("%-30s %12s %9s %9s %11s %9s %11s\n", "Carte", "dépl./pomme", "pommes 1", "pommes 2", "collisions", "arrêtées", "lecture µs");
+	}
+	char chemin[1024];
+	int nbCartes = 0, erreurs = 0;
+	long long totalDeplacements = 0, totalPommes = 0, totalCollisions = 0, totalLecture = 0;
+	int totalTerminees = 0, totalArretees = 0;
+	while (pret && !arretDemande && fgets(chemin, sizeof(chemin), fichier) != NULL)
+	{
+		chemin[strcspn(chemin, "\r\n")] = '\0';
+		if (chemin[0] == '\0' || chemin[0] == '#')
+		{
+			continue;
+		}
+		long long debut = maintenantNano();
+		bool chargee = chargerCarte(chemin, carte);
+		long long lecture = maintenantNano() - debut;
+		if (!chargee)
+		{
+			erreurs++;
+			continue;
+		}
+
+		// les stratégies enregistrées gardent leurs numéros d'une carte à l'autre
+		initContexte(contexte, carte, base->modele);
+		memcpy(contexte->strategies, base->strategies, sizeof(contexte->strategies));
+		contexte->nbStrategies = base->nbStrategies;
+		for (int p = 0; p < nbParties; p++)
+		{
+			parties[p].strategies[0] = strategies[0];
+			parties[p].strategies[1] = strategies[1];
+			parties[p].graine = graine + p;
+		}
+		tTournoi tournoi = {.contexte = contexte, .parties = parties, .nbParties = nbParties, .pommesProcedurales = (carte->nbPommes == 0)};
+		int lances = jouerTournoi(&tournoi, nbFils);
+		if (lances == 0 || arretDemande)
+		{
+			erreurs++;
+			break;
+		}
+
+		// les parties arrêtées après LIMITE_TOURS_TOURNOI tours sont comptées à part : leurs
+		// tours sans fin fausseraient les moyennes des parties terminées
+		long long deplacements = 0, pommes[2] = {0, 0}, collisions = 0;
+		int arretees = 0;
+		for (int p = 0; p < nbParties; p++)
+		{
+			if (parties[p].arretee)
+			{
+				arretees++;
+				continue;
+			}
+			deplacements += parties[p].deplacements;
+			pommes[0] += parties[p].pommes[0];
+			pommes[1] += parties[p].pommes[1];
+			collisions += parties[p].collisions[0] + parties[p].collisions[1];
+		}
+		long long mangees = pommes[0] + pommes[1];
+		int terminees = (nbParties > arretees) ? nbParties - arretees : 1;
+		// "é", "ê" et "µ" comptent deux octets pour une seule colonne
+		printf("%-30s %11.1f %9.2f %9.2f %11.2f %8d %10.1f\n", chemin, mangees > 0 ? (double)deplacements / mangees : 0.0,
+			   (double)pommes[0] / terminees, (double)pommes[1] / terminees, (double)collisions / terminees, arretees, lecture / 1e3);
+		nbCartes++;
+		totalTerminees += nbParties - arretees;
+		totalArretees += arretees;
+		totalDeplacements += deplacements;
+		totalPommes += mangees;
+		totalCollisions += collisions;
+		totalLecture += lecture;
+	}
+	if (fichier != NULL)
+	{
+		fclose(fichier);
+	}
+
+	if (nbCartes > 0)
+	{
+		int terminees = (totalTerminees > 0) ? totalTerminees : 1;
+		printf("%-30s %11.1f %19.2f %11.2f %8d %10.1f\n", "Total", totalPommes > 0 ? (double)totalDeplacements / totalPommes : 0.0,
+			   (double)totalPommes / terminees, (double)totalCollisions / terminees, totalArretees, totalLecture / 1e3 / nbCartes);
+	}
+	if (pret)
+	{
+		printf("%d cartes jouées, %d en erreur\n", nbCartes, erreurs);
+	}
+	free(carte);
+	free(contexte);
+	free(parties);
+	return (pret && erreurs == 0 && nbCartes > 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Fonction qui vérifie les portails sur une carte à deux portails dont l'un a la
+ * première pomme juste derrière lui : portail 10 10 70 30, pomme 70 31, serpent 2 parti de
+ * (70, 27) vers le bas. Pour l'IA habituelle, le mode --jps et le mode --voronoi, le serpent 2
+ * doit manger cette pomme sans collision et sans passer par le portail, qu'un chemin direct
+ * naïf lui ferait prendre en (70, 30). Puis nbParties parties à pommes procédurales (plusieurs
+ * à la fois) sont jouées avec l'IA habituelle : aucune pomme ne doit apparaître sur un bout
+ * de portail.
+ * @param nbParties de type int, Entrée : le nombre de parties à pommes procédurales
+ * @param graine de type uint64_t, Entrée : la graine de la première partie
+ * @return EXIT_SUCCESS si toutes les vérifications passent, EXIT_FAILURE sinon
+ */
+int lancerVerificationPortails(int nbParties, uint64_t graine)
+{
+	static const char *LIGNES[] = {"portail 10 10 70 30", "portail 10 30 70 10", "pomme 70 31", "serpent 2 70 27 bas"};
+	static const int STRATEGIES[] = {STRATEGIE_VERSION4, STRATEGIE_JPS, STRATEGIE_VORONOI};
+	tCarte *carte = malloc(sizeof(tCarte));
+	tContexte *contexte = malloc(sizeof(tContexte));
+	tEtatJeu *etat = malloc(sizeof(tEtatJeu));
+	if (carte == NULL || contexte == NULL || etat == NULL)
+	{
+		fprintf(stderr, "Mémoire insuffisante pour la vérification des portails\n");
+		free(carte);
+		free(contexte);
+		free(etat);
+		return EXIT_FAILURE;
+	}
+	const char *erreur = NULL;
+	initCarte(carte);
+	for (int i = 0; erreur == NULL && i < (int)(sizeof(LIGNES) / sizeof(LIGNES[0])); i++)
+	{
+		erreur = lireInstructionCarte(carte, LIGNES[i]);
+	}
+	if (erreur != NULL || !verifierCarte(carte, &erreur))
+	{
+		fprintf(stderr, "Carte de vérification : %s\n", erreur);
+		free(carte);
+		free(contexte);
+		free(etat);
+		return EXIT_FAILURE;
+	}
+	initContexte(contexte, carte, NULL);
+	const tPortails *portails = &contexte->portails;
+	const char directionsIA[2] = {0, 0};
+	int echecs = 0;
+
+	// la pomme derrière le portail, pour chaque stratégie
+	for (int i = 0; i < (int)(sizeof(STRATEGIES) / sizeof(STRATEGIES[0])); i++)
+	{
+		initEtatJeu(etat, contexte, graine, false, false, 1);
+		etat->serpents[0].strategie = etat->serpents[1].strategie = STRATEGIES[i];
+		tSerpent *serpent = &etat->serpents[1];
+		bool teleporte = false;
+		while (!partieFinie(etat) && etat->nbPommesMangee == 0 && serpent->deplacements < 50)
+		{
+			jouerTourSimultane(etat, directionsIA);
+			// un serpent n'est sur un bout de portail qu'après y être ressorti
+			teleporte |= portails->sorties[cellule_80x40(&GEOMETRIE_PLATEAU, anneauxX(&serpent->corps)[0], anneauxY(&serpent->corps)[0])] != 0;
+		}
+		if (serpent->nbPommesMangees != 1 || serpent->collision || teleporte)
+		{
+			printf("%s : le serpent 2 %s après %d tours\n", contexte->strategies[STRATEGIES[i]].nom,
+				   teleporte ? "est passé par le portail" : serpent->collision ? "est entré en collision" : "n'a pas mangé la pomme", serpent->deplacements);
+			echecs++;
+		}
+	}
+
+	// aucune pomme sur un bout de portail
+	int pommesSurPortail = 0;
+	for (int p = 0; p < nbParties; p++)
+	{
+		initEtatJeu(etat, contexte, graine + p, true, false, MAX_POMMES_SIMULTANEES);
+		do
+		{
+			for (int b = 0; b < 2 * portails->nbPaires; b++)
+			{
+				pommesSurPortail += (&etat->plateau[0][0])[portails->bouts[b]] == POMME;
+			}
+			jouerTourSimultane(etat, directionsIA);
+		} while (!partieFinie(etat) && etat->serpents[0].deplacements < LIMITE_TOURS_TOURNOI);
+	}
+	if (pommesSurPortail > 0)
+	{
+		printf("%d pommes apparues sur un portail\n", pommesSurPortail);
+		echecs++;
+	}
+
+	printf("Portails : %d vérifications en échec sur %d\n", echecs, (int)(sizeof(STRATEGIES) / sizeof(STRATEGIES[0])) + 1);
+	free(carte);
+	free(contexte);
+	free(etat);
+	return (echecs == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
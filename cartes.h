@@ -0,0 +1,44 @@
+/**
+ * @file cartes.h
+ * @brief Cartes du jeu snake : lecture d'un fichier de carte, contexte des parties et bancs sur plusieurs cartes
+ * @author Noah Le Goff, Sacha Mace
+ *
+ * Une carte décrit le plateau, le départ des serpents, les pommes prévues et les
+ * portails ; initContexte en tire le contexte des parties et les chemins de l'IA
+ * habituelle (version4 --carte, --cartes, --verifier-portails).
+ */
+
+#ifndef CARTES_H
+#define CARTES_H
+
+#include "jeu.h"
+
+// partie affichée sur une carte : tours au-delà desquels elle est arrêtée, l'IA habituelle
+// pouvant tourner sans fin entre les murs d'une carte
+#define LIMITE_TOURS_CARTE 5000
+
+// carte chargée par chargerCarte : le plateau complet (bordure, trous, murs et pavés), les
+// pavés vus par l'IA habituelle, le départ des serpents, les pommes prévues et les portails
+struct tCarte
+{
+	tPlateau plateau;
+	int nbPaves;
+	int lesPavesX[MAX_PAVES], lesPavesY[MAX_PAVES];
+	int departX[2], departY[2];			// tête de chaque serpent au départ
+	int directions[2];					// indice de la direction de départ, les anneaux suivent derrière
+	int nbPommes;
+	int lesPommesX[NB_POMMES], lesPommesY[NB_POMMES];
+	int nbPortails;
+	int portailsX[2 * MAX_PORTAILS], portailsY[2 * MAX_PORTAILS];	// les deux bouts de chaque portail
+};
+
+void initCarte(tCarte *carte);
+const char *lireInstructionCarte(tCarte *carte, const char *ligne);
+bool verifierCarte(const tCarte *carte, const char **erreur);
+bool chargerCarte(const char *chemin, tCarte *carte);
+void ajouterChemin(tPortails *portails, int cote, int entreeX, int entreeY, int sortieX, int sortieY);
+void initContexte(tContexte *contexte, const tCarte *carte, const tModele *modele);
+int lancerBancCartes(const tContexte *base, const char *liste, int nbParties, uint64_t graine, int nbFils, const int strategies[2]);
+int lancerVerificationPortails(int nbParties, uint64_t graine);
+
+#endif
@@ -0,0 +1,187 @@
+/**
+ * @file hote.c
+ * @brief Mode hôte du jeu snake : de nombreuses parties sans affichage dans un seul processus (version4 --hote)
+ * @author Noah Le Goff, Sacha Mace
+ */
+
+/* Fichiers inclus */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include "hote.h"
+
+/**
+ * @brief Fonction qui joue de nombreuses parties en même temps dans un seul processus.
+ * Chaque partie a son propre rythme, donné par un minuteur timerfd ; les parties sont
+ * réparties en tranches sur quelques fils, et chaque fil attend les minuteurs de sa tranche
+ * dans sa propre boucle epoll (boucleHote) : il y a une boucle epoll par fil, pas une seule
+ * boucle partagée, si bien qu'une partie n'est jamais jouée par deux fils. Avec un seul fil,
+ * toutes les parties sont dans une seule boucle. Cela remplace un processus endormi par
+ * usleep pour chaque partie. Les serpents jouent en
+ * même temps, comme en mode parallèle, et rien n'est affiché avant le bilan final.
+ * @param contexte de type tContexte, Entrée : la carte et les portails des parties
+ * @param nbParties de type int, Entrée : le nombre de parties
+ * @param nbFils de type int, Entrée : le nombre de fils
+ * @param periodeMin de type long, Entrée : la plus courte durée d'un tour, en millisecondes
+ * @param periodeMax de type long, Entrée : la plus longue durée d'un tour, en millisecondes
+ * @param graine de type uint64_t, Entrée : la graine de la première partie, les suivantes
+ * prennent graine + 1, graine + 2, ...
+ * @param pommesProcedurales de type bool, Entrée : pommes tirées parmi les cases libres
+ * @param croissance de type bool, Entrée : serpents qui grandissent
+ * @return EXIT_SUCCESS, ou EXIT_FAILURE si un fil n'a pas pu être lancé
+ */
+int lancerHote(const tContexte *contexte, int nbParties, int nbFils, long periodeMin, long periodeMax, uint64_t graine, bool pommesProcedurales, bool croissance)
+{
+	if (nbFils > nbParties)
+	{
+		nbFils = nbParties;
+	}
+	tPartieHebergee *parties = malloc(nbParties * sizeof(tPartieHebergee));
+	tFilHote *fils = calloc(nbFils, sizeof(tFilHote));
+	if (parties == NULL || fils == NULL)
+	{
+		fprintf(stderr, "Mémoire insuffisante pour %d parties\n", nbParties);
+		return EXIT_FAILURE;
+	}
+	tGenerateur generateur;
+	initGenerateur(&generateur, graine);
+	for (int p = 0; p < nbParties; p++)
+	{
+		initEtatJeu(&parties[p].etat, contexte, graine + p, pommesProcedurales, croissance, 1);
+		parties[p].periode = periodeMin + tirerBorne(&generateur, periodeMax - periodeMin + 1);
+	}
+
+	signal(SIGINT, demanderArret);
+	signal(SIGTERM, demanderArret);
+	long long debut = maintenantNano();
+	// chaque fil prend une tranche contiguë de parties
+	int lances = 0;
+	for (int f = 0; f < nbFils; f++)
+	{
+		int premiere = (int)((long long)nbParties * f / nbFils);
+		fils[f].parties = &parties[premiere];
+		fils[f].nbParties = (int)((long long)nbParties * (f + 1) / nbFils) - premiere;
+		if (pthread_create(&fils[f].fil, NULL, boucleHote, &fils[f]) != 0)
+		{
+			fprintf(stderr, "Impossible de lancer le fil %d\n", f);
+			arretDemande = true;
+			break;
+		}
+		lances++;
+	}
+
+	tFilHote total = {0};
+	for (int f = 0; f < lances; f++)
+	{
+		pthread_join(fils[f].fil, NULL);
+		total.tours += fils[f].tours;
+		total.retards += fils[f].retards;
+		total.pommes[0] += fils[f].pommes[0];
+		total.pommes[1] += fils[f].pommes[1];
+	}
+	double duree = (maintenantNano() - debut) / 1e9;
+	int terminees = 0;
+	for (int p = 0; p < nbParties; p++)
+	{
+		terminees += partieFinie(&parties[p].etat);
+	}
+
+	printf("%d parties sur %d fils, %d terminées en %.2f s\n", nbParties, lances, terminees, duree);
+	printf("%lld tours joués (%.0f par seconde), dont %lld en retard sur leur minuteur\n", total.tours, total.tours / duree, total.retards);
+	printf("Pommes mangées en moyenne par partie : %.2f pour le serpent 1, %.2f pour le serpent 2\n",
+		   (double)total.pommes[0] / nbParties, (double)total.pommes[1] / nbParties);
+	free(parties);
+	free(fils);
+	return lances == nbFils ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Fonction exécutée par chaque fil du mode hôte : arme un minuteur par partie,
+ * puis joue un tour de la partie dont le minuteur expire, jusqu'à ce que toutes ses
+ * parties soient terminées ou que l'arrêt soit demandé.
+ * @param argument de type tFilHote, Entrée/Sortie : les parties du fil et son bilan
+ * @return NULL
+ */
+void *boucleHote(void *argument)
+{
+	tFilHote *fil = argument;
+	int epoll = epoll_create1(EPOLL_CLOEXEC);
+	int enCours = 0;
+	for (int p = 0; p < fil->nbParties; p++)
+	{
+		tPartieHebergee *partie = &fil->parties[p];
+		struct itimerspec rythme = {0};
+		rythme.it_interval.tv_sec = partie->periode / 1000;
+		rythme.it_interval.tv_nsec = (partie->periode % 1000) * 1000000;
+		rythme.it_value = rythme.it_interval;
+		partie->minuteur = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+		struct epoll_event evenement = {.events = EPOLLIN, .data.ptr = partie};
+		if (partie->minuteur < 0 || timerfd_settime(partie->minuteur, 0, &rythme, NULL) < 0
+			|| epoll_ctl(epoll, EPOLL_CTL_ADD, partie->minuteur, &evenement) < 0)
+		{
+			perror("timerfd");
+			if (partie->minuteur >= 0)
+			{
+				close(partie->minuteur);
+				partie->minuteur = -1;
+			}
+			continue;
+		}
+		enCours++;
+	}
+
+	struct epoll_event prets[EVENEMENTS_HOTE];
+	const char directionsIA[2] = {0, 0};
+	while (enCours > 0 && !arretDemande)
+	{
+		// délai borné pour voir l'arrêt demandé même si le signal arrive sur un autre fil
+		int nbPrets = epoll_wait(epoll, prets, EVENEMENTS_HOTE, 200);
+		for (int i = 0; i < nbPrets; i++)
+		{
+			tPartieHebergee *partie = prets[i].data.ptr;
+			uint64_t expirations;
+			if (read(partie->minuteur, &expirations, sizeof(expirations)) != sizeof(expirations))
+			{
+				continue;
+			}
+			// un minuteur en retard compte plusieurs expirations : la partie les rattrape
+			// pour garder son rythme
+			for (uint64_t e = 0; e < expirations && !partieFinie(&partie->etat); e++)
+			{
+				jouerTourSimultane(&partie->etat, directionsIA);
+				fil->tours++;
+				fil->retards += (e > 0);
+			}
+			if (partieFinie(&partie->etat))
+			{
+				epoll_ctl(epoll, EPOLL_CTL_DEL, partie->minuteur, NULL);
+				close(partie->minuteur);
+				partie->minuteur = -1;
+				fil->pommes[0] += partie->etat.serpents[0].nbPommesMangees;
+				fil->pommes[1] += partie->etat.serpents[1].nbPommesMangees;
+				enCours--;
+			}
+		}
+	}
+
+	// parties interrompues par l'arrêt : leurs pommes comptent quand même
+	for (int p = 0; p < fil->nbParties; p++)
+	{
+		tPartieHebergee *partie = &fil->parties[p];
+		if (!partieFinie(&partie->etat))
+		{
+			if (partie->minuteur >= 0)
+			{
+				close(partie->minuteur);
+			}
+			fil->pommes[0] += partie->etat.serpents[0].nbPommesMangees;
+			fil->pommes[1] += partie->etat.serpents[1].nbPommesMangees;
+		}
+	}
+	close(epoll);
+	return NULL;
+}
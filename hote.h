@@ -0,0 +1,42 @@
+/**
+ * @file hote.h
+ * @brief Mode hôte du jeu snake : de nombreuses parties sans affichage dans un seul processus (version4 --hote)
+ * @author Noah Le Goff, Sacha Mace
+ *
+ * Les parties sont réparties entre des fils ayant chacun sa propre boucle epoll sur
+ * les minuteurs (timerfd) de ses parties, qui cadencent leurs tours ; chaque fil fait
+ * son bilan, réuni par lancerHote à la fin.
+ */
+
+#ifndef HOTE_H
+#define HOTE_H
+
+#include "jeu.h"
+
+// mode hôte : nombre de fils par défaut, et nombre maximal de minuteurs rendus par epoll_wait
+#define FILS_HOTE_DEFAUT 4
+#define EVENEMENTS_HOTE 64
+
+// partie du mode hôte : son état et le minuteur (timerfd) qui cadence ses tours
+typedef struct
+{
+	tEtatJeu etat;
+	int minuteur;
+	long periode;						// durée d'un tour, en millisecondes
+} tPartieHebergee;
+
+// fil du mode hôte : il joue ses parties dans sa propre boucle epoll et fait son bilan
+typedef struct
+{
+	pthread_t fil;
+	tPartieHebergee *parties;
+	int nbParties;
+	long long tours;					// tours joués par le fil
+	long long retards;					// tours joués en rattrapage d'un minuteur en retard
+	long long pommes[2];				// pommes mangées par chaque serpent, toutes parties confondues
+} tFilHote;
+
+int lancerHote(const tContexte *contexte, int nbParties, int nbFils, long periodeMin, long periodeMax, uint64_t graine, bool pommesProcedurales, bool croissance);
+void *boucleHote(void *argument);
+
+#endif
@@ -0,0 +1,668 @@
+/**
+ * @file jeu.h
+ * @brief Types, constantes et noyaux du plateau du jeu snake autonome, communs à version4.c et à ses modules
+ * @author Noah Le Goff, Sacha Mace
+ *
+ * L'état d'une partie (tEtatJeu) et son contexte (tContexte), les noyaux du plateau
+ * générés par DEFINIR_NOYAUX_PLATEAU et les prototypes des fonctions du jeu. Les modes
+ * et les IA développés dans leurs propres fichiers ont chacun un en-tête qui inclut
+ * celui-ci ; version4.c les inclut tous.
+ */
+
+#ifndef JEU_H
+#define JEU_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <pthread.h>
+#include <signal.h>
+#include "telemetrie.h"
+#include "protocole.h"
+
+// noyaux vectorisés disponibles uniquement sur les processeurs x86
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define NOYAU_X86
+#endif
+
+// taille du serpent au départ
+#define TAILLE 10
+// capacité du corps d'un serpent : le nombre de cases du plateau, qu'un corps, bordure
+// exclue, ne peut pas remplir ; il reste donc toujours une case devant la tête recopiée
+#define CAPACITE_CORPS NB_CASES
+// dimensions du plateau
+#define LARGEUR_PLATEAU 80
+#define HAUTEUR_PLATEAU 40
+// position initiale de la tête du serpent
+#define X_INITIAL_SERPENT1 40
+#define Y_INITIAL_SERPENT1 13
+#define X_INITIAL_SERPENT2 40
+#define Y_INITIAL_SERPENT2 27
+// position des trous
+#define TROU_HAUT_X 40
+#define TROU_HAUT_Y 0
+#define TROU_BAS_X 40
+#define TROU_BAS_Y 40
+#define TROU_GAUCHE_X 0
+#define TROU_GAUCHE_Y 20
+#define TROU_DROITE_X 80
+#define TROU_DROITE_Y 20
+// nombre de pommes à manger pour gagner
+#define NB_POMMES 10
+// nombre maximal de pommes présentes en même temps sur le plateau (--pommes)
+#define MAX_POMMES_SIMULTANEES 16
+// temporisation entre deux déplacements du serpent (en microsecondes)
+#define ATTENTE 100000
+// caractères pour représenter le serpent
+#define CORPS 'X'
+#define TETE_SERPENT1 '1'
+#define TETE_SERPENT2 '2'
+// touches de direction ou d'arrêt du jeu
+#define HAUT 'z'
+#define BAS 's'
+#define GAUCHE 'q'
+#define DROITE 'd'
+#define STOP 'a'
+// caractères pour les éléments du plateau
+#define BORDURE '#'
+#define VIDE ' '
+#define POMME '6'
+#define PORTAIL '@'
+// pavés
+#define NB_PAVES 6
+#define TAILLE_PAVE 5
+// nombre maximal de pavés d'une carte (--carte)
+#define MAX_PAVES 64
+// valeur renvoyer en fonction de la distance
+#define CHEMIN_HAUT 1
+#define CHEMIN_BAS 2
+#define CHEMIN_GAUCHE 3
+#define CHEMIN_DROITE 4
+#define CHEMIN_POMME 5
+// chemins par les autres trous du bord et par les portails de la carte : CHEMIN_PORTAIL + k
+// pour le (k + 4)-ième chemin de la table des portails (tPortails)
+#define CHEMIN_PORTAIL 6
+// pénalité ajoutée au score d'une direction bloquée
+#define PENALITE_BLOCAGE 100000
+// pénalité d'un pas dans un portail que l'IA habituelle ne vise pas, sous celle d'un blocage
+#define PENALITE_PORTAIL (PENALITE_BLOCAGE / 2)
+// nombre de cases du plateau vu à plat, ligne 0 et colonne 0 comprises
+#define NB_CASES ((LARGEUR_PLATEAU + 1) * (HAUTEUR_PLATEAU + 1))
+// répartiteur de tâches : nombre maximal d'ouvriers et capacité de la file de chaque ouvrier
+#define MAX_OUVRIERS 64
+#define CAPACITE_FILE 256
+// issue d'une décision du mode ordonnanceur, fixée par le premier qui la règle : la tâche
+// qui a décidé, ou le fil principal qui l'annule à l'échéance
+#define DECISION_EN_COURS 0
+#define DECISION_PRISE 1
+#define DECISION_ANNULEE 2
+// clé 32 bits d'une case : X dans les 16 bits de poids fort, Y dans les 16 bits de poids faible
+#define CLE_CASE(x, y) (((x) << 16) | (y))
+// journal d'annulation : nombre maximal de modifications notées pendant un tour (un tour en
+// note moins d'une centaine), et taille maximale d'un champ noté
+#define CAPACITE_JOURNAL 256
+#define TAILLE_CHAMP_JOURNAL 16
+// note l'ancienne valeur d'un champ avant de le modifier (sans effet si le journal est NULL)
+#define NOTER(journal, champ) noterModification((journal), &(champ), sizeof(champ))
+// nombre maximal de paires de trous dont le minorant de distance tient compte ; sur le
+// plateau de jeu, les portails d'une carte comptent avec ses paires de trous
+#define MAX_PORTAILS 16
+// chemins vers la pomme de l'IA habituelle : les quatre côtés, puis les autres trous et
+// les portails, chacun dans les deux sens
+#define MAX_CHEMINS (4 + 2 * MAX_PORTAILS)
+// tournoi entre stratégies : les stratégies engagées et les tours au-delà desquels une
+// partie est arrêtée et jugée aux pommes
+#define STRATEGIE_VERSION2 0				// chemin par quart du plateau de version2Sacha.c
+#define STRATEGIE_VERSION3 1				// chemin par les trous et pavés de version3Sacha.c
+#define STRATEGIE_VERSION4 2				// IA habituelle de version4.c
+#define STRATEGIE_JPS 3
+#define STRATEGIE_VORONOI 4
+#define STRATEGIE_POLITIQUE 5
+#define NB_STRATEGIES 6						// stratégies intégrées
+#define MAX_STRATEGIES 16					// intégrées et enregistrées
+#define LIMITE_TOURS_TOURNOI 5000
+
+// définition d'un type pour le plateau : tPlateau
+// Attention, pour que les indices du tableau 2D (qui commencent à 0) coincident
+// avec les coordonées à l'écran (qui commencent à 1), on ajoute 1 aux dimensions
+// et on neutralise la ligne 0 et la colonne 0 du tableau 2D (elles ne sont jamais
+// utilisées)
+typedef char tPlateau[LARGEUR_PLATEAU + 1][HAUTEUR_PLATEAU + 1];
+
+// corps d'un serpent. Les anneaux sont rangés à partir de l'indice tete, la tête en
+// premier : &lesX[tete] s'utilise comme un tableau lesX[] classique et reste contigu
+// pour les noyaux vectorisés. Un déplacement écrit la nouvelle tête juste devant
+// l'ancienne sans décaler les anneaux ; quand il n'y a plus de place devant, le corps
+// est recopié une seule fois au fond du tampon.
+typedef struct
+{
+	int lesX[CAPACITE_CORPS];
+	int lesY[CAPACITE_CORPS];
+	int tete;							// indice de la tête dans lesX/lesY
+	int taille;							// nombre d'anneaux, tête comprise
+	int aGrandir;						// anneaux à ajouter aux prochains déplacements
+} tCorps;
+
+// générateur pseudo-aléatoire propre à une partie (xoshiro128**) : il est initialisé
+// par une graine explicite, donc une partie se rejoue à l'identique, et deux parties
+// jouées en même temps ne partagent jamais d'état aléatoire
+typedef struct
+{
+	uint32_t etat[4];
+} tGenerateur;
+
+// index des cases libres du plateau, pour tirer une pomme en temps constant même
+// sur un plateau presque plein. Toutes les cases qui ne sont pas des murs sont dans
+// dense : les nbLibres premières sont libres, les suivantes occupées (serpent ou pomme).
+// Une case change de côté par un simple échange avec la frontière. Les indices, tous
+// inférieurs à NB_CASES, tiennent sur 16 bits : l'index pèse 16,6 Ko au lieu de 30.
+typedef struct
+{
+	int16_t dense[NB_CASES];
+	int16_t position[NB_CASES];			// indice de la case dans dense, -1 pour un mur
+	unsigned char occupation[NB_CASES];	// nombre d'éléments posés sur la case
+	int nbLibres;
+} tCasesLibres;
+
+// mémoire d'un serpent des stratégies des versions 2 et 3 : le chemin choisi à
+// l'apparition de la pomme et le passage par un trou, vu au saut de la tête
+typedef struct
+{
+	int pommeX, pommeY;					// pomme pour laquelle le chemin a été choisi
+	int chemin;							// CHEMIN_HAUT ... CHEMIN_POMME
+	bool passe;							// trou traversé depuis
+	bool changement;					// version 3 : horizontalité d'abord
+	int teteX, teteY;					// tête au tour précédent
+} tMemoireRoute;
+
+// état d'un serpent : son corps, sa stratégie et les variables de décision qui le suivent
+// d'un tour à l'autre
+typedef struct
+{
+	tCorps corps;
+	char direction;						// direction courante (HAUT, BAS, GAUCHE ou DROITE)
+	int meilleureDistance;				// meilleur chemin vers la pomme (CHEMIN_HAUT ... CHEMIN_POMME)
+	bool teleporter, changement, sortieDuTrou;
+	bool collision, pommeMangee;
+	int deplacements;					// total des déplacements
+	int nbPommesMangees;
+	int recherchesJPS;					// stratégie jps : recherches de chemin et cases développées
+	long long expansionsJPS, expansionsAEtoile;
+	int strategie;						// STRATEGIE_* ou stratégie enregistrée
+	tMemoireRoute memoire;				// stratégies version2 et version3
+} tSerpent;
+
+// contexte d'une série de parties (voir plus bas), partagé en lecture par les parties
+typedef struct tContexte tContexte;
+// politique neuronale (voir reseau.h), que le contexte désigne
+typedef struct tModele tModele;
+
+// état complet d'une partie, d'un seul bloc et sans autre pointeur que celui de son
+// contexte, qui ne change pas pendant la partie : une copie par memcpy est un instantané
+// indépendant que l'on peut rejouer ou restaurer, et plusieurs parties peuvent tourner
+// dans le même processus sans rien partager d'autre. Le bloc pèse environ 74 Ko, dont
+// 53 pour les deux corps et 17 pour l'index des cases libres : une copie coûte quelques
+// microsecondes, et une recherche qui explore beaucoup de coups passe plutôt par le
+// journal d'annulation (tJournal), qui ne touche que les champs modifiés.
+typedef struct
+{
+	const tContexte *contexte;			// carte et portails de la partie
+	tPlateau plateau;
+	tSerpent serpents[2];
+	tCasesLibres casesLibres;
+	tGenerateur generateur;
+	int lesPommesX[NB_POMMES], lesPommesY[NB_POMMES];	// pommes prévues
+	int nbPommesPrevues;
+	int lesPavesX[MAX_PAVES], lesPavesY[MAX_PAVES];
+	int nbPaves;
+	int pommeX, pommeY;					// pomme à manger
+	int DistancePommePave;				// indice du pavé le plus proche de la pomme
+	int nbPommesMangee;
+	int nbPommesPlateau;				// pommes présentes en même temps sur le plateau
+	bool pommesProcedurales, croissance;
+	bool comparerAEtoile;				// stratégie jps : recherches comparées à A*
+	bool gagne;
+	bool affichage;						// false pour une partie simulée, qui ne dessine rien
+} tEtatJeu;
+
+// stratégie d'un serpent : decider(etat, numero, direction) donne le coup du serpent numero
+// sur l'état du début du tour, ou renvoie false sans rien changer s'il n'en trouve aucun
+// (l'IA habituelle joue alors). Une stratégie intégrée n'a pas de fonction : deciderSerpent
+// l'appelle directement selon son numéro, seules les stratégies enregistrées passent par
+// leur pointeur.
+typedef bool (*tDecider)(tEtatJeu *etat, int numero, char *direction);
+
+typedef struct
+{
+	const char *nom;					// nom donné à --strategies
+	tDecider decider;					// NULL pour une stratégie intégrée
+} tStrategie;
+
+// carte chargée par chargerCarte (voir cartes.h), que le contexte désigne
+typedef struct tCarte tCarte;
+
+// portails d'une carte. Un serpent qui entre dans la case d'un portail ressort aussitôt par
+// la case de l'autre bout, sans compter de pas : sorties donne pour chaque case la case où
+// il ressort (0 si ce n'est pas un portail), en un seul accès pendant le déplacement. Les
+// trous du bord restent des passages d'un bord au bord opposé, calculés par les noyaux du
+// plateau ; les portails, par projeterCasePortails et celluleSuivantePortails. Les chemins
+// sont ceux que compare l'IA habituelle : entrer en (entreesX, entreesY) et ressortir en
+// (sortiesX, sortiesY), rangés comme les codes CHEMIN_* (un côté sans trou a une entrée à -1).
+typedef struct
+{
+	int16_t sorties[NB_CASES];
+	bool proches[NB_CASES];				// bout d'un portail ou l'une de ses huit voisines : point de saut pour jps
+	int nbPaires;
+	int bouts[2 * MAX_PORTAILS];		// les deux bouts de chaque paire, à plat
+	int nbChemins;
+	int entreesX[MAX_CHEMINS], entreesY[MAX_CHEMINS];
+	int sortiesX[MAX_CHEMINS], sortiesY[MAX_CHEMINS];
+} tPortails;
+
+// portails du plateau habituel : ses quatre trous et aucun portail
+#define PORTAILS_HABITUELS                                                                        \
+	{                                                                                             \
+		.nbChemins = 4,                                                                           \
+		.entreesX = {TROU_HAUT_X, TROU_BAS_X, TROU_GAUCHE_X, TROU_DROITE_X},                      \
+		.entreesY = {TROU_HAUT_Y, TROU_BAS_Y, TROU_GAUCHE_Y, TROU_DROITE_Y},                      \
+		.sortiesX = {TROU_BAS_X, TROU_HAUT_X, TROU_DROITE_X, TROU_GAUCHE_X},                      \
+		.sortiesY = {TROU_BAS_Y, TROU_HAUT_Y, TROU_DROITE_Y, TROU_GAUCHE_Y},                      \
+	}
+
+// contexte d'une série de parties : ce que toutes ses parties lisent sans jamais l'écrire.
+// initContexte le prépare avant la première partie, enregistrerStrategie y ajoute des
+// stratégies ; chaque partie le désigne (tEtatJeu.contexte), si bien que des parties de
+// contextes différents, sur des cartes ou avec des politiques différentes, tournent en
+// même temps dans le même processus.
+struct tContexte
+{
+	const tCarte *carte;				// NULL pour le plateau habituel
+	tPortails portails;					// portails de la carte et chemins de l'IA habituelle
+	int nbMurs;							// murs de la carte hors du bord et des pavés
+	int mursCumules[LARGEUR_PLATEAU + 1][HAUTEUR_PLATEAU + 1];	// ces murs dans [1, x] x [1, y]
+	const tModele *modele;				// politique de la stratégie politique, NULL sans elle
+	tStrategie strategies[MAX_STRATEGIES];	// les intégrées dans l'ordre de leurs numéros
+										// STRATEGIE_*, puis les enregistrées
+	int nbStrategies;
+};
+
+// journal d'annulation d'une simulation : avant chaque modification de l'état, le
+// déplacement et la gestion de la pomme y notent l'adresse et l'ancienne valeur du
+// champ modifié (case de tête, case de queue, case de la pomme, indicateurs...).
+// Un tour ne note que quelques dizaines de champs, et l'annuler ne fait que les
+// remettre en place dans l'ordre inverse, pour un coût proportionnel au nombre de champs
+// notés : une recherche peut jouer un tour, l'évaluer et revenir en arrière sans recopier
+// le plateau ni l'état entier. Le journal est dimensionné pour un tour : il est vidé
+// (annulerJournal jusqu'au repère 0) avant le suivant. --verifier-journal le contrôle.
+typedef struct
+{
+	void *adresse;						// champ modifié
+	int taille;							// taille du champ en octets, RECOPIE_CORPS pour une recopie de corps
+	unsigned char ancienne[TAILLE_CHAMP_JOURNAL];
+} tModification;
+
+// repère pris avant un tour, pour coder ensuite ce qui a changé pendant le tour
+typedef struct
+{
+	bool finie;							// partie déjà terminée avant le tour
+	int queueX[2], queueY[2];			// dernier anneau de chaque serpent
+	int taille[2];
+	int nbPommes[2];					// pommes mangées par chaque serpent
+} tAvantTour;
+
+// taille notée pour une recopie du corps au fond de son tampon
+#define RECOPIE_CORPS (-1)
+
+typedef struct
+{
+	int nbModifications;
+	tModification modifications[CAPACITE_JOURNAL];
+} tJournal;
+
+// fil de décision d'un serpent en mode parallèle. L'état de la partie n'est modifié
+// par le fil principal qu'entre deux barrières : pendant la phase de décision il sert
+// d'instantané commun, sans copie. Chaque fil n'écrit que dans les variables de
+// décision de son propre serpent.
+typedef struct
+{
+	int numero;							// 1 ou 2
+	tEtatJeu *etat;
+	pthread_barrier_t *debutTour;		// franchie quand l'instantané du tour est prêt
+	pthread_barrier_t *finTour;			// franchie quand les deux décisions sont prises
+	bool *finPartie;
+} tDecideur;
+
+// Répartiteur de tâches par vol de travail : chaque ouvrier a sa propre file à deux
+// bouts (Chase-Lev). Il empile et dépile ses tâches par le bas sans verrou, les
+// ouvriers inoccupés volent par le haut avec une seule comparaison-échange.
+// Le fil principal est l'ouvrier 0 : il soumet les tâches et surveille l'échéance sans en
+// exécuter aucune, une tâche exécutée sur place ne lui rendant la main qu'à sa fin.
+typedef struct tRepartiteur tRepartiteur;
+
+typedef struct
+{
+	void (*fonction)(tRepartiteur *repartiteur, int ouvrier, void *argument);
+	void *argument;
+	atomic_int *groupe;					// compteur du groupe, décrémenté à la fin de la tâche
+} tTache;
+
+typedef struct
+{
+	atomic_long haut;					// prochaine tâche à voler
+	atomic_long bas;					// prochaine case libre du propriétaire
+	tTache *_Atomic taches[CAPACITE_FILE];
+} tFileTaches;
+
+struct tRepartiteur
+{
+	int nbOuvriers;						// fil principal compris
+	pthread_t fils[MAX_OUVRIERS + 1];
+	tFileTaches files[MAX_OUVRIERS + 1];
+	atomic_bool arret;
+	atomic_uint generation;				// incrémentée pour annuler les tâches en cours
+};
+
+// arguments d'un fil ouvrier
+typedef struct
+{
+	tRepartiteur *repartiteur;
+	int indice;
+} tOuvrier;
+
+// décision d'un serpent pour un tour, exécutée comme une tâche du répartiteur :
+// elle lance un remplissage par direction pour mesurer l'espace libre derrière chaque coup
+typedef struct
+{
+	tDecideur *decideur;
+	unsigned generation;				// génération du tour, pour savoir si la tâche est annulée
+	long long echeance;					// échéance du tour, en microsecondes
+	int direction;						// direction évaluée par la sous-tâche
+	int espace;							// nombre de cases accessibles après ce coup
+} tRemplissage;
+
+// décision d'un serpent en mode ordonnanceur. La tâche décide sur son propre instantané
+// du début du tour, une copie de tEtatJeu par serpent et par tour : si elle est annulée, le fil principal joue le tour sans l'attendre,
+// et elle finit sans rien toucher d'autre que cet instantané.
+typedef struct
+{
+	tDecideur decideur;					// le serpent, et l'instantané comme état
+	unsigned generation;
+	long long echeance;					// échéance du tour, en microsecondes
+	atomic_int issue;					// DECISION_EN_COURS, DECISION_PRISE ou DECISION_ANNULEE
+	tEtatJeu instantane;
+	tRemplissage remplissages[4];
+	tTache sousTaches[4];
+} tDecisionTour;
+
+// directions dans l'ordre utilisé par les tableaux de scores, et leurs décalages
+static const char LES_DIRECTIONS[4] = {HAUT, BAS, GAUCHE, DROITE};
+static const int DECALAGE_X[4] = {0, 0, -1, 1};
+static const int DECALAGE_Y[4] = {-1, 1, 0, 0};
+
+// coordonnées des pommes, recopiées dans l'état de chaque partie
+static const int POMMES_X[NB_POMMES] = {40, 75, 78, 2, 9, 78, 74, 2, 72, 5};
+static const int POMMES_Y[NB_POMMES] = {20, 38, 2, 2, 5, 38, 32, 38, 32, 2};
+
+// coordonnées des pavés, recopiées dans l'état de chaque partie
+static const int PAVES_X[NB_PAVES] = { 4, 73, 4, 73, 38, 38};
+static const int PAVES_Y[NB_PAVES] = { 4, 4, 33, 33, 14, 22};
+
+/************************************************/
+/*		 NOYAUX DU PLATEAU SPECIALISES 			*/
+/************************************************/
+
+// Les noyaux du plateau voient la grille comme un tableau à plat : la case (x, y)
+// est à l'indice x * (hauteur + 1) + y, ce qui est exactement la disposition
+// mémoire de tPlateau. DEFINIR_NOYAUX_PLATEAU les génère pour des dimensions
+// données : avec des constantes (80x40), les décalages, les sauts des trous et
+// les boucles des pavés sont résolus à la compilation ; la version générique
+// lit les dimensions dans une tGeometrie pour les plateaux de taille quelconque.
+
+// dimensions d'un plateau connues seulement à l'exécution
+typedef struct
+{
+	int largeur;
+	int hauteur;
+} tGeometrie;
+
+#define DEFINIR_NOYAUX_PLATEAU(SUFFIXE, LARGEUR, HAUTEUR)                                         \
+                                                                                                  \
+	/* indice à plat de la case (x, y) */                                                         \
+	static inline int cellule##SUFFIXE(const tGeometrie *geo, int x, int y)                       \
+	{                                                                                             \
+		(void)geo;                                                                                \
+		return x * ((HAUTEUR) + 1) + y;                                                           \
+	}                                                                                             \
+                                                                                                  \
+	/* case voisine de (x, y) dans la direction d, en ressortant par le bord opposé */           \
+	static inline bool projeterCase##SUFFIXE(const tGeometrie *geo, int x, int y, int d, int *nx, int *ny) \
+	{                                                                                             \
+		(void)geo;                                                                                \
+		int px = x + DECALAGE_X[d];                                                               \
+		int py = y + DECALAGE_Y[d];                                                               \
+		*nx = (px <= 0) ? (LARGEUR) : (px > (LARGEUR)) ? 1 : px;                                  \
+		*ny = (py <= 0) ? (HAUTEUR) : (py > (HAUTEUR)) ? 1 : py;                                  \
+		return *nx != px || *ny != py;                                                            \
+	}                                                                                             \
+                                                                                                  \
+	/* indice de la case voisine dans la direction d, sans aucun test de bornes */               \
+	static inline int celluleSuivante##SUFFIXE(const tGeometrie *geo, int c, int d, bool *teleporte) \
+	{                                                                                             \
+		(void)geo;                                                                                \
+		const int pas = (HAUTEUR) + 1;                                                            \
+		const int decalage[4] = {-1, 1, -pas, pas};                                               \
+		const int saut[4] = {(HAUTEUR) - 1, 1 - (HAUTEUR), ((LARGEUR) - 1) * pas, (1 - (LARGEUR)) * pas}; \
+		int x = c / pas;                                                                          \
+		int y = c % pas;                                                                          \
+		*teleporte = (d == 0) ? (y == 1) : (d == 1) ? (y == (HAUTEUR)) : (d == 2) ? (x == 1) : (x == (LARGEUR)); \
+		return *teleporte ? c + saut[d] : c + decalage[d];                                        \
+	}                                                                                             \
+                                                                                                  \
+	/* bordure percée de quatre trous au milieu des côtés, puis pavés de TAILLE_PAVE cases */    \
+	static inline void initCases##SUFFIXE(const tGeometrie *geo, char *cases, const int pavesX[], const int pavesY[], int nbPaves) \
+	{                                                                                             \
+		(void)geo;                                                                                \
+		const int pas = (HAUTEUR) + 1;                                                            \
+		memset(cases, VIDE, ((LARGEUR) + 1) * pas);                                               \
+		for (int x = 1; x <= (LARGEUR); x++)                                                      \
+		{                                                                                         \
+			cases[x * pas + 1] = BORDURE;                                                         \
+			cases[x * pas + (HAUTEUR)] = BORDURE;                                                 \
+		}                                                                                         \
+		memset(&cases[1 * pas + 1], BORDURE, (HAUTEUR));                                          \
+		memset(&cases[(LARGEUR) * pas + 1], BORDURE, (HAUTEUR));                                  \
+		cases[((LARGEUR) / 2) * pas + 1] = VIDE;          /* trou du haut */                      \
+		cases[((LARGEUR) / 2) * pas + (HAUTEUR)] = VIDE;  /* trou du bas */                       \
+		cases[1 * pas + (HAUTEUR) / 2] = VIDE;            /* trou de gauche */                    \
+		cases[(LARGEUR) * pas + (HAUTEUR) / 2] = VIDE;    /* trou de droite */                    \
+		for (int p = 0; p < nbPaves; p++)                                                         \
+		{                                                                                         \
+			/* une colonne de pavé est contiguë en mémoire */                                     \
+			for (int i = 0; i < TAILLE_PAVE; i++)                                                 \
+			{                                                                                     \
+				memset(&cases[(pavesX[p] + i) * pas + pavesY[p]], BORDURE, TAILLE_PAVE);          \
+			}                                                                                     \
+		}                                                                                         \
+	}
+
+// plateau du jeu, dimensions constantes
+DEFINIR_NOYAUX_PLATEAU(_80x40, LARGEUR_PLATEAU, HAUTEUR_PLATEAU)
+// plateau de taille quelconque
+DEFINIR_NOYAUX_PLATEAU(_generique, geo->largeur, geo->hauteur)
+
+static const tGeometrie GEOMETRIE_PLATEAU = {LARGEUR_PLATEAU, HAUTEUR_PLATEAU};
+
+// Les portails d'une carte restent hors des noyaux, dont le plateau 80x40 est entièrement
+// résolu à la compilation. Les deux fonctions suivantes appellent le noyau puis, si la
+// partie a des portails, consultent leur table ; sinon elles reçoivent NULL, choisi une
+// fois par décision ou par tour (portailsPartie), et ne font rien de plus que le noyau.
+
+/* case voisine de (x, y) dans la direction d, en ressortant par le bord opposé ou par
+   l'autre bout d'un portail ; true si le serpent passe par un trou ou un portail */
+static inline bool projeterCasePortails(const tPortails *portails, int x, int y, int d, int *nx, int *ny)
+{
+	bool passe = projeterCase_80x40(&GEOMETRIE_PLATEAU, x, y, d, nx, ny);
+	int sortie = (portails != NULL) ? portails->sorties[cellule_80x40(&GEOMETRIE_PLATEAU, *nx, *ny)] : 0;
+	if (sortie == 0)
+	{
+		return passe;
+	}
+	*nx = sortie / (HAUTEUR_PLATEAU + 1);
+	*ny = sortie % (HAUTEUR_PLATEAU + 1);
+	return true;
+}
+
+/* indice de la case voisine dans la direction d, ou de l'autre bout si c'est un portail */
+static inline int celluleSuivantePortails(const tPortails *portails, int c, int d, bool *teleporte)
+{
+	int suivante = celluleSuivante_80x40(&GEOMETRIE_PLATEAU, c, d, teleporte);
+	int sortie = (portails != NULL) ? portails->sorties[suivante] : 0;
+	*teleporte |= (sortie != 0);
+	return (sortie != 0) ? sortie : suivante;
+}
+
+// plateau de jeu en bits : un mot par colonne, le bit y pour la case (x, y). Les colonnes
+// 0 et LARGEUR_PLATEAU + 1 restent vides pour les voisines des colonnes du bord, et il y
+// a assez de colonnes après pour lire quatre mots à la fois jusqu'à la dernière
+#define COLONNES_BITBOARD (LARGEUR_PLATEAU + 4)
+_Static_assert(LARGEUR_PLATEAU % 4 == 0 && HAUTEUR_PLATEAU < 63, "plateau en bits : colonnes par 4, une colonne par mot");
+typedef struct
+{
+	uint64_t colonnes[COLONNES_BITBOARD];
+} tBitboard;
+
+// partage du plateau entre deux têtes : cases atteintes les premières par chacune et
+// distance de chacune à la case visée (-1 si elle ne l'atteint pas)
+typedef struct
+{
+	int territoires[2];
+	int distances[2];
+} tVoronoi;
+
+void initEtatJeu(tEtatJeu *etat, const tContexte *contexte, uint64_t graine, bool pommesProcedurales, bool croissance, int nbPommes);
+void initPlateau(tPlateau plateau, const int pavesX[], const int pavesY[], int nbPaves);
+void initCasesPlateau(const tGeometrie *geo, char *cases, const int pavesX[], const int pavesY[], int nbPaves);
+void dessinerPlateau(tPlateau plateau, const tPortails *portails);
+bool ajouterPomme(tEtatJeu *etat, tJournal *journal);
+void initCasesLibres(tCasesLibres *casesLibres, tPlateau plateau);
+void occuperCase(tCasesLibres *casesLibres, int x, int y, tJournal *journal);
+void libererCase(tCasesLibres *casesLibres, int x, int y, tJournal *journal);
+void echangerCases(tCasesLibres *casesLibres, int c, int indice, tJournal *journal);
+void afficher(int, int, char);
+void effacer(int x, int y, const tPortails *portails);
+void initCorps(tCorps *corps, int xTete, int yTete, int pasX, int pasY);
+int *anneauxX(tCorps *corps);
+int *anneauxY(tCorps *corps);
+void ajouterTete(tCorps *corps, int x, int y, bool grandir, tJournal *journal);
+void dessinerSerpent1(tCorps *corps);
+void dessinerSerpent2(tCorps *corps);
+void directionSerpentVersObjectif1(tCorps *corps_S1, tCorps *corps_S2, tPlateau plateau, const tPortails *portails, char *direction, int objectifX, int objectifY, bool changement);
+void directionSerpentVersObjectif2(tCorps *corps_S2, tCorps *corps_S1, tPlateau plateau, const tPortails *portails, char *direction, int objectifX, int objectifY, bool changement);
+void rangDirections(int dx, int dy, bool changement, char directionCourante, int rang[4]);
+void evaluerDirections(tCorps *corps, tCorps *corpsAutre, tPlateau plateau, const tPortails *portails, int objectifX, int objectifY, const int rang[4], int scores[4]);
+int meilleureDirection(const int scores[4]);
+int indiceDirection(char direction);
+void choisirObjectif(const tPortails *portails, int meilleureDistance, bool teleporter, int pommeX, int pommeY, int *objectifX, int *objectifY);
+void deciderSerpent(tEtatJeu *etat, int numero, char *direction, bool *changement, bool *sortieDuTrou);
+void deciderVersion4(tEtatJeu *etat, int numero, char *direction, bool *changement, bool *sortieDuTrou);
+int compterMurs(const tContexte *contexte, int x1, int y1, int x2, int y2);
+bool contournerMurs(const tEtatJeu *etat, int numero, int objectifX, int objectifY, char *direction);
+void *filDecision(void *decideur);
+void resoudreConflits(tEtatJeu *etat, tJournal *journal);
+bool verifierCollision1(tCorps *corps_S1, tCorps *corps_S2, tPlateau plateau, const tPortails *portails, char directionProchaine);
+bool verifierCollision2(tCorps *corps_S2, tCorps *corps_S1, tPlateau plateau, const tPortails *portails, char directionProchaine);
+int calculerDistance1(int lesX_S1[], int lesY_S1[], int pommeX, int pommeY, const tPortails *portails);
+int calculerDistance2(int lesX_S2[], int lesY_S2[], int pommeX, int pommeY, const tPortails *portails);
+int meilleurChemin(const tPortails *portails, int teteX, int teteY, int pommeX, int pommeY);
+int distanceHorsPortails(const tPortails *portails, int x1, int y1, int x2, int y2);
+int rangDuChemin(int chemin);
+bool teteSurUnCorps(tEtatJeu *etat, int numero);
+void progresser1(tEtatJeu *etat, tJournal *journal);
+void progresser2(tEtatJeu *etat, tJournal *journal);
+void traiterPommeMangee(tEtatJeu *etat, tJournal *journal);
+void noterModification(tJournal *journal, void *adresse, int taille);
+void noterRecopieCorps(tJournal *journal, tCorps *corps, int debut);
+void annulerJournal(tJournal *journal, int repere);
+void normaliserCorps(tEtatJeu *etat);
+int lancerVerificationJournal(const tContexte *contexte, int nbParties, uint64_t graine, bool pommesProcedurales, bool croissance, int nbPommes, const int strategies[2]);
+void bloquerCorps(const tEtatJeu *etat, char cases[]);
+int parcourirDepuisTete(const char *cases, const tPortails *portails, int tete, int distances[], signed char premiers[], int file[]);
+bool directionPommes(const tEtatJeu *etat, int numero, char *direction);
+void partagerTerritoires(const tBitboard *libres, const tPortails *portails, const int sources[2], int visee, tVoronoi *voronoi);
+bool directionVoronoi(const tEtatJeu *etat, int numero, char *direction);
+void observerReels(const tEtatJeu *etat, int numero, float *sortie);
+void observerOctets(const tEtatJeu *etat, int numero, uint8_t *sortie);
+void observerLotReels(const tEtatJeu *const parties[], int nbParties, float *sortie, size_t pas);
+void observerLotOctets(const tEtatJeu *const parties[], int nbParties, uint8_t *sortie, size_t pas);
+int lancerJeuDeDonnees(const tContexte *contexte, const char *chemin, int nbParties, uint64_t graine, bool pommesProcedurales, bool croissance, int nbPommes, const int strategies[2]);
+int distanceParTrou(const tPortails *portails, int chemin, int teteX, int teteY, int pommeX, int pommeY);
+int cheminVersion2(const tPortails *portails, int teteX, int teteY, int pommeX, int pommeY);
+bool collisionVersionPrecedente(tEtatJeu *etat, int numero, char directionProchaine);
+void directionVersion2(tEtatJeu *etat, int numero, char *direction, int objectifX, int objectifY);
+void directionVersion3(tEtatJeu *etat, int numero, char *direction, int objectifX, int objectifY, bool changement);
+bool changementPaves(const tEtatJeu *etat, int teteX);
+void directionVersionPrecedente(tEtatJeu *etat, int numero, char *direction);
+int enregistrerStrategie(tContexte *contexte, const char *nom, tDecider decider);
+int trouverStrategie(const tContexte *contexte, const char *nom);
+bool lireStrategies(const tContexte *contexte, const char *liste, int strategies[2]);
+bool directionPrudente(tEtatJeu *etat, int numero, char *direction);
+bool partieFinie(const tEtatJeu *etat);
+const tPortails *portailsPartie(const tEtatJeu *etat);
+void jouerTourSimultane(tEtatJeu *etat, const char directions[2]);
+void deciderTour(tEtatJeu *etat, const char directions[2]);
+void appliquerTour(tEtatJeu *etat, tJournal *journal);
+void noterAvantTour(tEtatJeu *etat, tAvantTour *avant);
+void coderDelta(tEtatJeu *etat, const tAvantTour *avant, tDelta *delta);
+void coderEtatInitial(tEtatJeu *etat, tEtatInitial *initial);
+void demanderArret(int signal);
+int ouvrirFlux(const char *chemin, tEtatJeu *etat);
+bool ecrireFlux(int flux, const void *octets, size_t taille);
+bool publierDelta(int flux, const tDelta *delta);
+int calculerDistancePommePave(const tEtatJeu *etat);
+bool changementDirection(tEtatJeu *etat, int numero);
+bool changementDirectionCasIsole(tCorps *corps_S2, tCorps *corps_S1);
+bool initRepartiteur(tRepartiteur *repartiteur, int nbFils);
+void arreterRepartiteur(tRepartiteur *repartiteur);
+void soumettreTache(tRepartiteur *repartiteur, int ouvrier, tTache *tache);
+bool attendreGroupe(tRepartiteur *repartiteur, int ouvrier, atomic_int *groupe, long long echeance);
+bool surveillerGroupe(tRepartiteur *repartiteur, atomic_int *groupe, long long echeance);
+bool tacheAnnulee(tRepartiteur *repartiteur, unsigned generation);
+tTache *depilerTache(tFileTaches *file);
+tTache *volerTache(tFileTaches *file);
+void executerTache(tRepartiteur *repartiteur, int ouvrier, tTache *tache);
+tTache *trouverTache(tRepartiteur *repartiteur, int ouvrier, unsigned *graine);
+void *filOuvrier(void *ouvrier);
+void tacheDecision(tRepartiteur *repartiteur, int ouvrier, void *argument);
+void tacheRemplissage(tRepartiteur *repartiteur, int ouvrier, void *argument);
+int compterEspaceLibre(tDecideur *decideur, int direction, tRepartiteur *repartiteur, unsigned generation, long long echeance);
+long long maintenantMicro();
+long long maintenantNano();
+tSegmentTelemetrie *ouvrirTelemetrie(const char *nom);
+void mesurerPartie(const tEtatJeu *etat, uint64_t tour, long long latence, tMesures *mesures);
+void fermerTelemetrie(tSegmentTelemetrie *segment, const char *nom);
+void initGenerateur(tGenerateur *generateur, uint64_t graine);
+uint32_t tirerAleatoire(tGenerateur *generateur);
+uint32_t tirerBorne(tGenerateur *generateur, uint32_t borne);
+void initNoyauCollision();
+bool collisionCorpsScalaire(const int lesX[], const int lesY[], int taille, int x, int y);
+int collisionCandidatsScalaire(const int lesX[], const int lesY[], int taille, const int candidatsX[4], const int candidatsY[4]);
+#ifdef NOYAU_X86
+__attribute__((target("sse2"))) bool collisionCorpsSSE2(const int lesX[], const int lesY[], int taille, int x, int y);
+__attribute__((target("sse2"))) int collisionCandidatsSSE2(const int lesX[], const int lesY[], int taille, const int candidatsX[4], const int candidatsY[4]);
+__attribute__((target("avx2"))) bool collisionCorpsAVX2(const int lesX[], const int lesY[], int taille, int x, int y);
+__attribute__((target("avx2"))) int collisionCandidatsAVX2(const int lesX[], const int lesY[], int taille, const int candidatsX[4], const int candidatsY[4]);
+#endif
+void gotoxy(int x, int y);
+int kbhit();
+void disable_echo();
+void enable_echo();
+
+// noyau de collision choisi à l'exécution selon le jeu d'instructions du processeur
+extern bool (*collisionCorps)(const int lesX[], const int lesY[], int taille, int x, int y);
+extern int (*collisionCandidats)(const int lesX[], const int lesY[], int taille, const int candidatsX[4], const int candidatsY[4]);
+// passe à true sur SIGINT ou SIGTERM (demanderArret) pour arrêter proprement une boucle longue
+extern volatile sig_atomic_t arretDemande;
+
+#endif
@@ -0,0 +1,291 @@
+/**
+ * @file jps.c
+ * @brief Recherche de chemin par points de saut (JPS) sur le plateau de jeu, et stratégie jps (version4 --jps)
+ * @author Noah Le Goff, Sacha Mace
+ */
+
+/* Fichiers inclus */
+#include <stdlib.h>
+#include <string.h>
+#include "jps.h"
+#include "planificateur.h"
+
+// Recherche par points de saut (JPS) sur le plateau de jeu, en quatre directions. Parmi
+// les plus courts chemins, on ne garde que ceux qui avancent horizontalement et ne
+// tournent que lorsqu'ils y sont forcés : un saut vertical file tout droit jusqu'à
+// l'arrivée, un trou du bord ou une case voisine qui ne s'ouvre que là (voisin forcé) ;
+// un saut horizontal joue le rôle du déplacement en diagonale de JPS et s'arrête aussi
+// dès qu'un saut vertical lancé de la case trouve quelque chose. Seuls les points où un
+// saut s'arrête entrent dans la file de priorité, ce qui en développe bien moins qu'un A*
+// case par case. Les cases libres du bord (les trous) sont toujours des points de saut :
+// on en repart dans les quatre directions, y compris vers le trou d'en face. Il en va de
+// même des bouts des portails de la carte et de leurs huit voisines : un saut s'arrête
+// avant d'entrer dans un portail, d'où la recherche le traverse en un pas, et les voisins
+// forcés que crée un bout, infranchissable à pied, ne sont jamais manqués.
+
+/**
+ * @brief Fonction qui dit si une case du plateau de jeu est sur le bord (les seules cases
+ * libres du bord sont les trous).
+ * @param c de type int, Entrée : l'indice à plat de la case
+ */
+bool caseDuBord(int c)
+{
+	int x = c / (HAUTEUR_PLATEAU + 1), y = c % (HAUTEUR_PLATEAU + 1);
+	return x == 1 || x == LARGEUR_PLATEAU || y == 1 || y == HAUTEUR_PLATEAU;
+}
+
+/**
+ * @brief Fonction qui dit si une case est toujours un point de saut : sur le bord, bout d'un
+ * portail ou voisine d'un bout, diagonales comprises.
+ * @param portails de type tPortails, Entrée : les portails de la partie, ou NULL
+ * @param c de type int, Entrée : l'indice à plat de la case
+ */
+bool pointDeSaut(const tPortails *portails, int c)
+{
+	return (portails != NULL && portails->proches[c]) || caseDuBord(c);
+}
+
+/**
+ * @brief Fonction qui file verticalement depuis une case jusqu'au prochain point de saut.
+ * @param cases de type char*, Entrée : le plateau à plat, BORDURE pour une case bloquée
+ * @param portails de type tPortails, Entrée : les portails de la partie, ou NULL
+ * @param c de type int, Entrée : la case de départ du saut
+ * @param d de type int, Entrée : l'indice de la direction (HAUT ou BAS)
+ * @param arrivee de type int, Entrée : la case d'arrivée de la recherche
+ * @return le point de saut atteint, -1 si le saut finit contre un obstacle
+ */
+int sauterVertical(const char *cases, const tPortails *portails, int c, int d, int arrivee)
+{
+	const int pas = HAUTEUR_PLATEAU + 1;
+	while (true)
+	{
+		int suivante = c + DECALAGE_Y[d];
+		if (cases[suivante] == BORDURE)
+		{
+			return -1;
+		}
+		if (suivante == arrivee || pointDeSaut(portails, suivante))
+		{
+			return suivante;
+		}
+		// voisin forcé : la colonne d'à côté s'ouvre ici alors qu'elle était bloquée juste avant
+		if ((cases[suivante - pas] != BORDURE && cases[c - pas] == BORDURE)
+			|| (cases[suivante + pas] != BORDURE && cases[c + pas] == BORDURE))
+		{
+			return suivante;
+		}
+		c = suivante;
+	}
+}
+
+/**
+ * @brief Fonction qui file horizontalement depuis une case jusqu'au prochain point de
+ * saut : l'arrivée, un trou, ou une case d'où un saut vertical trouve un point de saut.
+ * @param cases de type char*, Entrée : le plateau à plat, BORDURE pour une case bloquée
+ * @param portails de type tPortails, Entrée : les portails de la partie, ou NULL
+ * @param c de type int, Entrée : la case de départ du saut
+ * @param d de type int, Entrée : l'indice de la direction (GAUCHE ou DROITE)
+ * @param arrivee de type int, Entrée : la case d'arrivée de la recherche
+ * @return le point de saut atteint, -1 si le saut finit contre un obstacle
+ */
+int sauterHorizontal(const char *cases, const tPortails *portails, int c, int d, int arrivee)
+{
+	const int decalage = DECALAGE_X[d] * (HAUTEUR_PLATEAU + 1);
+	while (true)
+	{
+		int suivante = c + decalage;
+		if (cases[suivante] == BORDURE)
+		{
+			return -1;
+		}
+		if (suivante == arrivee || pointDeSaut(portails, suivante)
+			|| sauterVertical(cases, portails, suivante, 0, arrivee) >= 0 || sauterVertical(cases, portails, suivante, 1, arrivee) >= 0)
+		{
+			return suivante;
+		}
+		c = suivante;
+	}
+}
+
+/**
+ * @brief Fonction qui dit si la recherche par points de saut doit repartir d'un point
+ * dans une direction, selon la direction par laquelle elle y est arrivée.
+ * @param cases de type char*, Entrée : le plateau à plat, BORDURE pour une case bloquée
+ * @param portails de type tPortails, Entrée : les portails de la partie, ou NULL
+ * @param c de type int, Entrée : le point de saut
+ * @param arrivee de type int, Entrée : l'indice de la direction d'arrivée en c, -1 pour le départ
+ * @param d de type int, Entrée : l'indice de la direction à essayer
+ */
+bool directionNaturelle(const char *cases, const tPortails *portails, int c, int arrivee, int d)
+{
+	if (arrivee < 0 || pointDeSaut(portails, c))
+	{
+		return true;
+	}
+	if (arrivee >= 2)
+	{
+		// après un déplacement horizontal : tout droit, ou en haut et en bas
+		return d == arrivee || d < 2;
+	}
+	// après un déplacement vertical : tout droit, ou sur le côté si le voisin est forcé
+	const int pas = HAUTEUR_PLATEAU + 1;
+	int cote = DECALAGE_X[d] * pas;
+	return d == arrivee || (d >= 2 && cases[c + cote] != BORDURE && cases[c - DECALAGE_Y[arrivee] + cote] == BORDURE);
+}
+
+/**
+ * @brief Fonction qui cherche un plus court chemin sur le plateau de jeu, par points de
+ * saut, ou case par case (A* ordinaire) pour comparer. Les trous du bord se traversent en
+ * un pas, les portails de la carte sans en compter, et le minorant de la distance restante
+ * tient compte des uns et des autres.
+ * @param cases de type char*, Entrée : le plateau à plat, BORDURE pour une case bloquée
+ * (les corps des serpents compris) ; la case de départ peut être bloquée
+ * @param portails de type tPortails, Entrée : les portails de la partie, ou NULL
+ * @param depart, arrivee de type int, Entrée : les cases de départ et d'arrivée
+ * @param sauts de type bool, Entrée : true pour sauter de point en point, false pour un A* case par case
+ * @param premiereDirection de type int*, Sortie : l'indice de la première direction du
+ * chemin, inchangé si le départ est l'arrivée
+ * @param expansions de type int*, Sortie : le nombre de cases développées par la recherche
+ * @return la longueur du chemin, -1 si l'arrivée est inaccessible
+ */
+int chercherCheminJPS(const char *cases, const tPortails *portails, int depart, int arrivee, bool sauts, int *premiereDirection, int *expansions)
+{
+	const tGeometrie *geo = &GEOMETRIE_PLATEAU;
+	const int pas = HAUTEUR_PLATEAU + 1;
+	int couts[NB_CASES];
+	int parents[NB_CASES];
+	signed char directions[NB_CASES];	// direction par laquelle la recherche est arrivée sur la case
+	bool fermes[NB_CASES];
+	tElementTas tas[4 * NB_CASES + 1];	// au plus quatre ajouts par case développée
+	int tailleTas = 0;
+	int bouts[2 * MAX_PORTAILS], minorants[2 * MAX_PORTAILS], passages[MAX_PORTAILS];
+	int xArrivee = arrivee / pas, yArrivee = arrivee % pas;
+	bool teleporte;
+
+	*expansions = 0;
+	if (cases[arrivee] == BORDURE && arrivee != depart)
+	{
+		return -1;
+	}
+	int nbPortails = releverPortails(geo, cases, bouts);
+	for (int p = 0; p < nbPortails && p < MAX_PORTAILS; p++)
+	{
+		passages[p] = 1;
+	}
+	// les portails de la carte suivent les trous (chargerCarte les compte ensemble)
+	for (int p = 0; portails != NULL && p < portails->nbPaires && nbPortails < MAX_PORTAILS; p++, nbPortails++)
+	{
+		bouts[2 * nbPortails] = portails->bouts[2 * p];
+		bouts[2 * nbPortails + 1] = portails->bouts[2 * p + 1];
+		passages[nbPortails] = 0;
+	}
+	minorerPortails(geo, bouts, passages, nbPortails, xArrivee, yArrivee, minorants);
+	for (int c = 0; c < NB_CASES; c++)
+	{
+		couts[c] = INT32_MAX;
+	}
+	memset(fermes, false, sizeof(fermes));
+	couts[depart] = 0;
+	directions[depart] = -1;
+	ajouterTas(tas, &tailleTas, (tElementTas){minorerDistance(geo, bouts, minorants, nbPortails, depart, xArrivee, yArrivee), depart});
+
+	while (tailleTas > 0)
+	{
+		int c = extraireTas(tas, &tailleTas).noeud;
+		if (fermes[c])
+		{
+			continue;
+		}
+		fermes[c] = true;
+		(*expansions)++;
+		if (c == arrivee)
+		{
+			break;
+		}
+		for (int d = 0; d < 4; d++)
+		{
+			if (sauts && !directionNaturelle(cases, portails, c, directions[c], d))
+			{
+				continue;
+			}
+			int voisine = celluleSuivantePortails(portails, c, d, &teleporte);
+			if (cases[voisine] == BORDURE)
+			{
+				continue;
+			}
+			// un passage par un trou ou un portail compte pour un pas ; sinon le saut file en ligne droite
+			int longueur = 1;
+			if (sauts && !teleporte)
+			{
+				voisine = (d < 2) ? sauterVertical(cases, portails, c, d, arrivee) : sauterHorizontal(cases, portails, c, d, arrivee);
+				if (voisine < 0)
+				{
+					continue;
+				}
+				longueur = abs(voisine / pas - c / pas) + abs(voisine % pas - c % pas);
+			}
+			int cout = couts[c] + longueur;
+			if (cout < couts[voisine])
+			{
+				couts[voisine] = cout;
+				parents[voisine] = c;
+				directions[voisine] = d;
+				int minorant = minorerDistance(geo, bouts, minorants, nbPortails, voisine, xArrivee, yArrivee);
+				ajouterTas(tas, &tailleTas, (tElementTas){cout + minorant, voisine});
+			}
+		}
+	}
+	if (couts[arrivee] == INT32_MAX)
+	{
+		return -1;
+	}
+
+	// le premier tronçon part du départ en ligne droite : sa direction est celle du premier pas
+	if (arrivee != depart)
+	{
+		int c = arrivee;
+		while (parents[c] != depart)
+		{
+			c = parents[c];
+		}
+		*premiereDirection = directions[c];
+	}
+	return couts[arrivee];
+}
+
+/**
+ * @brief Fonction qui choisit la direction d'un serpent en mode --jps : le premier pas du
+ * plus court chemin vers la pomme, les corps des deux serpents étant des murs. Les
+ * recherches et leurs cases développées sont comptées dans le serpent.
+ * @param etat de type tEtatJeu, Entrée/Sortie : la partie ; seuls les compteurs du serpent changent
+ * @param numero de type int, Entrée : le numéro du serpent (1 ou 2)
+ * @param direction de type char, Sortie : la direction du serpent, inchangée sans chemin
+ * @return false si la pomme est inaccessible : la décision revient alors à l'IA habituelle
+ */
+bool directionJPS(tEtatJeu *etat, int numero, char *direction)
+{
+	char cases[NB_CASES];
+	tSerpent *serpent = &etat->serpents[numero - 1];
+	int premiere = -1, expansions;
+	const tPortails *portails = portailsPartie(etat);
+
+	bloquerCorps(etat, cases);
+	int depart = cellule_80x40(&GEOMETRIE_PLATEAU, anneauxX(&serpent->corps)[0], anneauxY(&serpent->corps)[0]);
+	int arrivee = cellule_80x40(&GEOMETRIE_PLATEAU, etat->pommeX, etat->pommeY);
+
+	int longueur = chercherCheminJPS(cases, portails, depart, arrivee, true, &premiere, &expansions);
+	serpent->recherchesJPS++;
+	serpent->expansionsJPS += expansions;
+	if (etat->comparerAEtoile)
+	{
+		int autre;
+		chercherCheminJPS(cases, portails, depart, arrivee, false, &autre, &expansions);
+		serpent->expansionsAEtoile += expansions;
+	}
+	if (longueur <= 0)
+	{
+		return false;
+	}
+	*direction = LES_DIRECTIONS[premiere];
+	return true;
+}
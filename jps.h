@@ -0,0 +1,25 @@
+/**
+ * @file jps.h
+ * @brief Recherche de chemin par points de saut (JPS) sur le plateau de jeu, et stratégie jps (version4 --jps)
+ * @author Noah Le Goff, Sacha Mace
+ *
+ * La recherche ne développe que les points de saut : elle longe les lignes droites
+ * sans s'arrêter sur leurs cases, les trous du bord et les abords des portails d'une
+ * carte restant des points de saut. Avec sauts à false, c'est un A* case par case,
+ * qui sert de référence au mode --jps comparer.
+ */
+
+#ifndef JPS_H
+#define JPS_H
+
+#include "jeu.h"
+
+bool caseDuBord(int c);
+bool pointDeSaut(const tPortails *portails, int c);
+int sauterVertical(const char *cases, const tPortails *portails, int c, int d, int arrivee);
+int sauterHorizontal(const char *cases, const tPortails *portails, int c, int d, int arrivee);
+bool directionNaturelle(const char *cases, const tPortails *portails, int c, int arrivee, int d);
+int chercherCheminJPS(const char *cases, const tPortails *portails, int depart, int arrivee, bool sauts, int *premiereDirection, int *expansions);
+bool directionJPS(tEtatJeu *etat, int numero, char *direction);
+
+#endif
@@ -0,0 +1,117 @@
+/**
+ * @file moniteur.c
+ * @brief Moniteur de la télémétrie du jeu snake autonome (version4 --telemetrie)
+ * @author Noah Le Goff, Sacha Mace
+ *
+ * Le moniteur ouvre en lecture seule le segment de mémoire partagée publié par le jeu
+ * et affiche ses mesures à la période demandée, sans jamais ralentir la partie.
+ * Il attend que le segment existe et s'arrête à la fin de la partie.
+ * Utilisation : moniteur [NOM] [PERIODE_MS]
+ */
+
+/* Fichiers inclus */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "telemetrie.h"
+
+// période d'affichage par défaut (en millisecondes)
+#define PERIODE_DEFAUT 200
+// valeurs de l'objectif publiées par le jeu (CHEMIN_HAUT ... CHEMIN_POMME)
+#define CHEMIN_HAUT 1
+#define CHEMIN_POMME 5
+
+const char *NOMS_OBJECTIFS[CHEMIN_POMME + 1] = {"?", "trou haut", "trou bas", "trou gauche", "trou droite", "pomme"};
+
+const tSegmentTelemetrie *ouvrirSegment(const char *nom);
+const char *nomObjectif(int objectif);
+
+/**
+ * @brief  Entrée du programme
+ * @param argc de type int, Entrée : le nombre d'arguments
+ * @param argv de type char tableau, Entrée : le nom du segment puis la période d'affichage en millisecondes
+ * @return EXIT_SUCCESS à la fin de la partie, EXIT_FAILURE si le segment est illisible
+ */
+int main(int argc, char *argv[])
+{
+	const char *nom = (argc > 1) ? argv[1] : TELEMETRIE_NOM_DEFAUT;
+	int periode = (argc > 2) ? atoi(argv[2]) : PERIODE_DEFAUT;
+	if (periode <= 0)
+	{
+		periode = PERIODE_DEFAUT;
+	}
+
+	// attend que le jeu ait créé le segment
+	const tSegmentTelemetrie *segment;
+	while ((segment = ouvrirSegment(nom)) == NULL)
+	{
+		usleep(periode * 1000);
+	}
+	// le jeu pose la marque une fois le segment initialisé
+	while (segment->magique == 0)
+	{
+		usleep(periode * 1000);
+	}
+	if (segment->magique != TELEMETRIE_MAGIQUE)
+	{
+		fprintf(stderr, "%s n'est pas un segment de télémétrie du jeu\n", nom);
+		return EXIT_FAILURE;
+	}
+	printf("Partie du processus %d\n", segment->pid);
+
+	tMesures mesures;
+	do
+	{
+		lireMesures(segment, &mesures);
+		printf("\rTour %6llu | S1 : %3u pommes, %5u dépl., taille %4u, vers %-11s | S2 : %3u pommes, %5u dépl., taille %4u, vers %-11s | décision %7.1f µs (max %7.1f)",
+			   (unsigned long long)mesures.tour,
+			   mesures.pommes[0], mesures.deplacements[0], mesures.tailles[0], nomObjectif(mesures.objectifs[0]),
+			   mesures.pommes[1], mesures.deplacements[1], mesures.tailles[1], nomObjectif(mesures.objectifs[1]),
+			   mesures.latenceDecision / 1000.0, mesures.latenceMax / 1000.0);
+		fflush(stdout);
+		if (mesures.enCours || mesures.tour == 0)
+		{
+			usleep(periode * 1000);
+		}
+	} while (mesures.enCours || mesures.tour == 0);
+	printf("\nFin de la partie\n");
+
+	return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Fonction qui projette en lecture seule le segment de télémétrie.
+ * @param nom de type char tableau, Entrée : le nom POSIX du segment
+ * @return le segment projeté, ou NULL s'il n'existe pas (encore)
+ */
+const tSegmentTelemetrie *ouvrirSegment(const char *nom)
+{
+	int descripteur = shm_open(nom, O_RDONLY, 0);
+	if (descripteur < 0)
+	{
+		return NULL;
+	}
+	struct stat infos;
+	if (fstat(descripteur, &infos) < 0 || infos.st_size < (off_t)sizeof(tSegmentTelemetrie))
+	{
+		// segment en cours de création par le jeu
+		close(descripteur);
+		return NULL;
+	}
+	const tSegmentTelemetrie *segment = mmap(NULL, sizeof(tSegmentTelemetrie), PROT_READ, MAP_SHARED, descripteur, 0);
+	close(descripteur);
+	return (segment == MAP_FAILED) ? NULL : segment;
+}
+
+/**
+ * @brief Fonction qui donne le nom lisible d'un objectif publié par le jeu.
+ * @param objectif de type int, Entrée : CHEMIN_HAUT ... CHEMIN_POMME
+ */
+const char *nomObjectif(int objectif)
+{
+	return (objectif >= CHEMIN_HAUT && objectif <= CHEMIN_POMME) ? NOMS_OBJECTIFS[objectif] : NOMS_OBJECTIFS[0];
+}
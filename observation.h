@@ -0,0 +1,59 @@
+/**
+ * @file observation.h
+ * @brief Observations du plateau pour des contrôleurs appris, communes au jeu (version4.c)
+ * et aux programmes qui lisent ses jeux de données (version4 --jeu-de-donnees)
+ * @author Noah Le Goff, Sacha Mace
+ *
+ * Une observation décrit une partie du point de vue d'un serpent : NB_CANAUX grilles de
+ * OBSERVATION_LARGEUR x OBSERVATION_HAUTEUR valeurs, rangées canal par canal, puis colonne
+ * par colonne (x de 1 à 80), puis ligne par ligne (y de 1 à 40) : la valeur du canal k
+ * pour la case (x, y) est à l'indice k * OBSERVATION_CASES + (x - 1) * OBSERVATION_HAUTEUR + (y - 1).
+ * Une case vaut 1 (ou 255 en octets) quand l'élément du canal y est, 0 sinon ; le canal
+ * du serpent observé donne en plus l'âge de l'anneau : 1 pour la tête, puis de moins en
+ * moins jusqu'à la queue, sans jamais atteindre 0.
+ *
+ * Fichier d'un jeu de données :
+ *   tEnteteDonnees, puis des tExemple jusqu'à la fin du fichier, un par serpent et par tour
+ *   tant que la partie dure ; les deux serpents d'une même partie se suivent.
+ */
+
+#ifndef OBSERVATION_H
+#define OBSERVATION_H
+
+#include <stdint.h>
+
+// dimensions d'une observation
+#define OBSERVATION_LARGEUR 80
+#define OBSERVATION_HAUTEUR 40
+#define OBSERVATION_CASES (OBSERVATION_LARGEUR * OBSERVATION_HAUTEUR)
+
+// canaux d'une observation
+#define CANAL_MURS 0						// bordure et pavés
+#define CANAL_CORPS 1						// serpent observé, avec l'âge de chaque anneau
+#define CANAL_AUTRE 2						// l'autre serpent
+#define CANAL_POMMES 3
+#define CANAL_TROUS 4						// ouvertures du bord, qui mènent au bord opposé, et bouts des portails
+#define NB_CANAUX 5
+#define OBSERVATION_TAILLE (NB_CANAUX * OBSERVATION_CASES)
+
+// marque de reconnaissance d'un fichier de jeu de données
+#define DONNEES_MAGIQUE 0x534E4B4F
+
+// entête d'un fichier de jeu de données
+typedef struct
+{
+	uint32_t magique;
+	uint16_t nbCanaux, largeur, hauteur;
+	uint16_t tailleExemple;				// sizeof(tExemple)
+} tEnteteDonnees;
+
+// exemple d'un serpent pour un tour : ce qu'il voyait avant le tour, le coup qu'il a
+// joué et ce qui est arrivé pendant le tour
+typedef struct
+{
+	uint8_t observation[OBSERVATION_TAILLE];
+	uint8_t direction;					// 0 haut, 1 bas, 2 gauche, 3 droite
+	uint8_t evenements;					// EVENEMENT_* de protocole.h, du point de vue de la partie
+} tExemple;
+
+#endif
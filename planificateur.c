@@ -0,0 +1,940 @@
+/**
+ * @file planificateur.c
+ * @brief Planificateur hiérarchique de chemins sur un plateau de taille quelconque (version4 --hierarchique)
+ * @author Noah Le Goff, Sacha Mace
+ */
+
+/* Fichiers inclus */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "planificateur.h"
+
+// Sur un très grand plateau, une recherche case par case à chaque décision est trop
+// lente. Le planificateur découpe le plateau en secteurs de TAILLE_SECTEUR cases de côté ;
+// chaque passage libre entre deux secteurs voisins donne une ou deux entrées, et les
+// distances entre les entrées d'un même secteur sont gardées d'une recherche à l'autre.
+// Une recherche A* sur ce graphe d'entrées, bien plus petit que le plateau, choisit les
+// secteurs à traverser, puis chaque tronçon est détaillé par un parcours limité à son
+// secteur. Quand une case change (pavé, corps d'un serpent), seul son secteur est marqué :
+// ses entrées sont recalculées à la recherche suivante, et ses distances seulement quand
+// une recherche y entre de nouveau. Les distances de tout le plateau ne sont donc jamais
+// calculées d'un coup, pas même à la préparation.
+
+/**
+ * @brief Fonction qui prépare le planificateur d'un plateau : entrées de tous les bords ;
+ * les distances à l'intérieur des secteurs attendent la première recherche qui y passe.
+ * @param planificateur de type tPlanificateur, Sortie : le planificateur
+ * @param geo de type tGeometrie, Entrée : les dimensions du plateau
+ * @param cases de type char tableau, Entrée : le plateau à plat, gardé par le planificateur
+ * (ses cases ne doivent plus changer que par modifierCasePlanificateur)
+ * @return false si la mémoire manque ou si le plateau a trop de secteurs
+ */
+bool initPlanificateur(tPlanificateur *planificateur, const tGeometrie *geo, char *cases)
+{
+	memset(planificateur, 0, sizeof(*planificateur));
+	planificateur->geo = *geo;
+	planificateur->cases = cases;
+	planificateur->nbSecteursX = (geo->largeur + TAILLE_SECTEUR - 1) / TAILLE_SECTEUR;
+	planificateur->nbSecteursY = (geo->hauteur + TAILLE_SECTEUR - 1) / TAILLE_SECTEUR;
+	int nbSecteurs = planificateur->nbSecteursX * planificateur->nbSecteursY;
+	// un noeud est numéroté par son bord, son entrée et son côté
+	if ((uint64_t)nbSecteurs * 4 * MAX_ENTREES_BORD >= NOEUD_DEPART)
+	{
+		return false;
+	}
+	planificateur->secteurs = calloc(nbSecteurs, sizeof(tSecteur));
+	planificateur->bords = calloc(2 * (size_t)nbSecteurs, sizeof(tBordSecteur));
+	planificateur->sales = malloc(nbSecteurs * sizeof(int));
+	planificateur->distancesLocales = malloc(TAILLE_SECTEUR * TAILLE_SECTEUR * sizeof(int));
+	planificateur->fileLocale = malloc(TAILLE_SECTEUR * TAILLE_SECTEUR * sizeof(int));
+	if (planificateur->secteurs == NULL || planificateur->bords == NULL || planificateur->sales == NULL
+		|| planificateur->distancesLocales == NULL || planificateur->fileLocale == NULL)
+	{
+		libererPlanificateur(planificateur);
+		return false;
+	}
+	trouverPortails(planificateur);
+	for (int b = 0; b < 2 * nbSecteurs; b++)
+	{
+		calculerBord(planificateur, b);
+	}
+	for (int s = 0; s < nbSecteurs; s++)
+	{
+		planificateur->secteurs[s].interieurSale = true;
+	}
+	return true;
+}
+
+/**
+ * @brief Procédure qui libère la mémoire du planificateur (pas celle du plateau).
+ * @param planificateur de type tPlanificateur, Entrée/Sortie : le planificateur
+ */
+void libererPlanificateur(tPlanificateur *planificateur)
+{
+	int nbSecteurs = planificateur->nbSecteursX * planificateur->nbSecteursY;
+	for (int s = 0; s < nbSecteurs && planificateur->secteurs != NULL; s++)
+	{
+		free(planificateur->secteurs[s].noeuds);
+		free(planificateur->secteurs[s].distances);
+	}
+	for (int b = 0; b < 2 * nbSecteurs && planificateur->bords != NULL; b++)
+	{
+		free(planificateur->bords[b].noeuds);
+	}
+	free(planificateur->secteurs);
+	free(planificateur->bords);
+	free(planificateur->sales);
+	free(planificateur->distancesLocales);
+	free(planificateur->fileLocale);
+	free(planificateur->tas);
+	memset(planificateur, 0, sizeof(*planificateur));
+}
+
+/**
+ * @brief Procédure qui donne les cases extrêmes d'un secteur.
+ * @param planificateur de type tPlanificateur, Entrée : le planificateur
+ * @param secteur de type int, Entrée : le numéro du secteur
+ * @param x0, y0, x1, y1 de type int, Sortie : les coins haut-gauche et bas-droite, inclus
+ */
+void limitesSecteur(const tPlanificateur *planificateur, int secteur, int *x0, int *y0, int *x1, int *y1)
+{
+	*x0 = 1 + (secteur % planificateur->nbSecteursX) * TAILLE_SECTEUR;
+	*y0 = 1 + (secteur / planificateur->nbSecteursX) * TAILLE_SECTEUR;
+	*x1 = (*x0 + TAILLE_SECTEUR - 1 < planificateur->geo.largeur) ? *x0 + TAILLE_SECTEUR - 1 : planificateur->geo.largeur;
+	*y1 = (*y0 + TAILLE_SECTEUR - 1 < planificateur->geo.hauteur) ? *y0 + TAILLE_SECTEUR - 1 : planificateur->geo.hauteur;
+}
+
+/**
+ * @brief Fonction qui donne le secteur d'une case.
+ */
+int secteurDeCase(const tPlanificateur *planificateur, int x, int y)
+{
+	return ((y - 1) / TAILLE_SECTEUR) * planificateur->nbSecteursX + (x - 1) / TAILLE_SECTEUR;
+}
+
+/**
+ * @brief Fonction qui donne le voisin d'un secteur, en ressortant par le bord opposé.
+ * @param planificateur de type tPlanificateur, Entrée : le planificateur
+ * @param secteur de type int, Entrée : le numéro du secteur
+ * @param orientation de type int, Entrée : 0 pour le voisin de droite, 1 pour celui du dessous
+ * @param pas de type int, Entrée : 1 pour le voisin suivant, -1 pour le précédent
+ */
+int secteurVoisin(const tPlanificateur *planificateur, int secteur, int orientation, int pas)
+{
+	int nx = planificateur->nbSecteursX, ny = planificateur->nbSecteursY;
+	int sx = secteur % nx, sy = secteur / nx;
+	if (orientation == 0)
+	{
+		sx = (sx + pas + nx) % nx;
+	}
+	else
+	{
+		sy = (sy + pas + ny) % ny;
+	}
+	return sy * nx + sx;
+}
+
+/**
+ * @brief Fonction qui retrouve un noeud du graphe des entrées par son numéro.
+ */
+tNoeudHierarchique *noeudHierarchique(const tPlanificateur *planificateur, uint32_t noeud)
+{
+	uint32_t bord = noeud / (2 * MAX_ENTREES_BORD);
+	return &planificateur->bords[bord].noeuds[noeud % (2 * MAX_ENTREES_BORD)];
+}
+
+/**
+ * @brief Fonction qui donne le secteur d'un noeud : celui de son bord pour le côté 0,
+ * le voisin pour le côté 1.
+ */
+int secteurDuNoeud(const tPlanificateur *planificateur, uint32_t noeud)
+{
+	uint32_t bord = noeud / (2 * MAX_ENTREES_BORD);
+	return (noeud & 1) ? secteurVoisin(planificateur, bord / 2, bord % 2, 1) : (int)(bord / 2);
+}
+
+/**
+ * @brief Procédure qui recalcule les entrées d'un bord : une au milieu de chaque passage
+ * libre, ou une à chaque bout si le passage est long.
+ * @param planificateur de type tPlanificateur, Entrée/Sortie : le planificateur
+ * @param bord de type int, Entrée : le numéro du bord (2 * secteur + orientation)
+ */
+void calculerBord(tPlanificateur *planificateur, int bord)
+{
+	int secteur = bord / 2, orientation = bord % 2;
+	int voisin = secteurVoisin(planificateur, secteur, orientation, 1);
+	int x0, y0, x1, y1, vx0, vy0, vx1, vy1;
+	limitesSecteur(planificateur, secteur, &x0, &y0, &x1, &y1);
+	limitesSecteur(planificateur, voisin, &vx0, &vy0, &vx1, &vy1);
+	// le long du bord : côté secteur (x1, y) et côté voisin (vx0, y), ou (x, y1) et (x, vy0)
+	int longueur = (orientation == 0) ? y1 - y0 + 1 : x1 - x0 + 1;
+	int cotes[2][TAILLE_SECTEUR];
+	bool libres[TAILLE_SECTEUR + 1];
+	for (int k = 0; k < longueur; k++)
+	{
+		cotes[0][k] = (orientation == 0) ? cellule_generique(&planificateur->geo, x1, y0 + k) : cellule_generique(&planificateur->geo, x0 + k, y1);
+		cotes[1][k] = (orientation == 0) ? cellule_generique(&planificateur->geo, vx0, y0 + k) : cellule_generique(&planificateur->geo, x0 + k, vy0);
+		libres[k] = planificateur->cases[cotes[0][k]] != BORDURE && planificateur->cases[cotes[1][k]] != BORDURE;
+	}
+	libres[longueur] = false;
+
+	int entrees[MAX_ENTREES_BORD];
+	int nbEntrees = 0;
+	int debut = -1;
+	for (int k = 0; k <= longueur; k++)
+	{
+		if (libres[k] && debut < 0)
+		{
+			debut = k;
+		}
+		else if (!libres[k] && debut >= 0)
+		{
+			if (k - debut >= PASSAGE_LONG)
+			{
+				entrees[nbEntrees++] = debut;
+				entrees[nbEntrees++] = k - 1;
+			}
+			else
+			{
+				entrees[nbEntrees++] = (debut + k - 1) / 2;
+			}
+			debut = -1;
+		}
+	}
+
+	tBordSecteur *leBord = &planificateur->bords[bord];
+	free(leBord->noeuds);
+	leBord->nbEntrees = nbEntrees;
+	leBord->noeuds = (nbEntrees > 0) ? calloc(2 * nbEntrees, sizeof(tNoeudHierarchique)) : NULL;
+	for (int e = 0; e < nbEntrees; e++)
+	{
+		leBord->noeuds[2 * e].cellule = cotes[0][entrees[e]];
+		leBord->noeuds[2 * e + 1].cellule = cotes[1][entrees[e]];
+	}
+}
+
+/**
+ * @brief Procédure qui recalcule la liste des noeuds d'un secteur et leurs distances
+ * sans sortir du secteur.
+ * @param planificateur de type tPlanificateur, Entrée/Sortie : le planificateur
+ * @param secteur de type int, Entrée : le numéro du secteur
+ */
+void calculerSecteur(tPlanificateur *planificateur, int secteur)
+{
+	tSecteur *leSecteur = &planificateur->secteurs[secteur];
+	uint32_t noeuds[4 * MAX_ENTREES_BORD];
+	int nbNoeuds = 0;
+	// côté 0 de ses bords de droite et du dessous, côté 1 des bords de ses voisins de
+	// gauche et du dessus
+	for (int cote = 0; cote < 2; cote++)
+	{
+		for (int orientation = 0; orientation < 2; orientation++)
+		{
+			int bord = 2 * ((cote == 0) ? secteur : secteurVoisin(planificateur, secteur, orientation, -1)) + orientation;
+			for (int e = 0; e < planificateur->bords[bord].nbEntrees; e++)
+			{
+				noeuds[nbNoeuds++] = ((uint32_t)bord * MAX_ENTREES_BORD + e) * 2 + cote;
+			}
+		}
+	}
+
+	free(leSecteur->noeuds);
+	free(leSecteur->distances);
+	leSecteur->nbNoeuds = nbNoeuds;
+	leSecteur->noeuds = malloc(nbNoeuds * sizeof(uint32_t));
+	leSecteur->distances = malloc(nbNoeuds * nbNoeuds * sizeof(uint16_t));
+	memcpy(leSecteur->noeuds, noeuds, nbNoeuds * sizeof(uint32_t));
+	for (int i = 0; i < nbNoeuds; i++)
+	{
+		noeudHierarchique(planificateur, noeuds[i])->indice = i;
+	}
+	for (int i = 0; i < nbNoeuds; i++)
+	{
+		parcourirSecteur(planificateur, secteur, noeudHierarchique(planificateur, noeuds[i])->cellule);
+		for (int j = 0; j < nbNoeuds; j++)
+		{
+			int distance = distanceLocale(planificateur, secteur, noeudHierarchique(planificateur, noeuds[j])->cellule);
+			leSecteur->distances[i * nbNoeuds + j] = (distance < 0) ? DISTANCE_INFINIE : distance;
+		}
+	}
+}
+
+/**
+ * @brief Procédure qui calcule les distances depuis une case sans sortir de son secteur
+ * (parcours en largeur).
+ * @param planificateur de type tPlanificateur, Entrée/Sortie : le planificateur, dont les distances locales
+ * @param secteur de type int, Entrée : le numéro du secteur
+ * @param depart de type int, Entrée : l'indice à plat de la case de départ
+ */
+void parcourirSecteur(tPlanificateur *planificateur, int secteur, int depart)
+{
+	int x0, y0, x1, y1;
+	limitesSecteur(planificateur, secteur, &x0, &y0, &x1, &y1);
+	int *distances = planificateur->distancesLocales;
+	int *file = planificateur->fileLocale;
+	for (int i = 0; i < TAILLE_SECTEUR * TAILLE_SECTEUR; i++)
+	{
+		distances[i] = -1;
+	}
+	int pas = planificateur->geo.hauteur + 1;
+	int debut = 0, fin = 0;
+	distances[(depart / pas - x0) * TAILLE_SECTEUR + depart % pas - y0] = 0;
+	file[fin++] = depart;
+	while (debut < fin)
+	{
+		int c = file[debut++];
+		int x = c / pas, y = c % pas;
+		int distance = distances[(x - x0) * TAILLE_SECTEUR + y - y0];
+		for (int d = 0; d < 4; d++)
+		{
+			int nx = x + DECALAGE_X[d], ny = y + DECALAGE_Y[d];
+			int voisin = nx * pas + ny;
+			if (nx >= x0 && nx <= x1 && ny >= y0 && ny <= y1 && planificateur->cases[voisin] != BORDURE
+				&& distances[(nx - x0) * TAILLE_SECTEUR + ny - y0] < 0)
+			{
+				distances[(nx - x0) * TAILLE_SECTEUR + ny - y0] = distance + 1;
+				file[fin++] = voisin;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Fonction qui lit une distance du dernier parcours d'un secteur.
+ * @return la distance, ou -1 si la case n'a pas été atteinte
+ */
+int distanceLocale(const tPlanificateur *planificateur, int secteur, int cellule)
+{
+	int x0, y0, x1, y1;
+	limitesSecteur(planificateur, secteur, &x0, &y0, &x1, &y1);
+	int pas = planificateur->geo.hauteur + 1;
+	return planificateur->distancesLocales[(cellule / pas - x0) * TAILLE_SECTEUR + cellule % pas - y0];
+}
+
+/**
+ * @brief Procédure qui change une case du plateau et marque son secteur pour qu'il soit
+ * réparé à la prochaine recherche, seulement si la case devient libre ou bloquée.
+ * @param planificateur de type tPlanificateur, Entrée/Sortie : le planificateur
+ * @param x, y de type int, Entrée : la case
+ * @param car de type char, Entrée : son nouveau contenu (BORDURE pour la bloquer)
+ */
+void modifierCasePlanificateur(tPlanificateur *planificateur, int x, int y, char car)
+{
+	char *ancien = &planificateur->cases[cellule_generique(&planificateur->geo, x, y)];
+	bool changement = (*ancien == BORDURE) != (car == BORDURE);
+	*ancien = car;
+	if (!changement)
+	{
+		return;
+	}
+	int secteur = secteurDeCase(planificateur, x, y);
+	int x0, y0, x1, y1;
+	limitesSecteur(planificateur, secteur, &x0, &y0, &x1, &y1);
+	marquerSecteur(planificateur, secteur, x == x0 || x == x1 || y == y0 || y == y1);
+	if (x == 1 || x == planificateur->geo.largeur || y == 1 || y == planificateur->geo.hauteur)
+	{
+		// un trou du bord s'ouvre ou se ferme
+		trouverPortails(planificateur);
+	}
+}
+
+/**
+ * @brief Procédure qui relève les paires de trous face à face sur les bords opposés.
+ * @param planificateur de type tPlanificateur, Entrée/Sortie : le planificateur
+ */
+void trouverPortails(tPlanificateur *planificateur)
+{
+	planificateur->nbPortails = releverPortails(&planificateur->geo, planificateur->cases, planificateur->portails);
+}
+
+/**
+ * @brief Fonction qui relève les paires de trous face à face sur les bords opposés d'un
+ * plateau : chaque paire est un portail, que l'on traverse en un pas.
+ * @param geo de type tGeometrie, Entrée : les dimensions du plateau
+ * @param cases de type char*, Entrée : le plateau à plat, BORDURE pour une case bloquée
+ * @param portails de type int tableau, Sortie : les deux bouts de chaque paire (2 * MAX_PORTAILS cases)
+ * @return le nombre de paires, MAX_PORTAILS + 1 s'il y en a trop pour les relever toutes
+ */
+int releverPortails(const tGeometrie *geo, const char *cases, int portails[])
+{
+	int nbPortails = 0;
+	for (int orientation = 0; orientation < 2; orientation++)
+	{
+		int longueur = (orientation == 0) ? geo->hauteur : geo->largeur;
+		for (int k = 1; k <= longueur && nbPortails <= MAX_PORTAILS; k++)
+		{
+			int a = (orientation == 0) ? cellule_generique(geo, 1, k) : cellule_generique(geo, k, 1);
+			int b = (orientation == 0) ? cellule_generique(geo, geo->largeur, k) : cellule_generique(geo, k, geo->hauteur);
+			if (cases[a] != BORDURE && cases[b] != BORDURE)
+			{
+				if (nbPortails < MAX_PORTAILS)
+				{
+					portails[2 * nbPortails] = a;
+					portails[2 * nbPortails + 1] = b;
+				}
+				nbPortails++;
+			}
+		}
+	}
+	return nbPortails;
+}
+
+/**
+ * @brief Procédure qui calcule, pour une arrivée, le minorant de la distance restante en
+ * entrant dans chaque bout de portail : le coût du passage, puis le mieux entre aller
+ * directement à l'arrivée et reprendre un autre portail.
+ * @param geo de type tGeometrie, Entrée : les dimensions du plateau
+ * @param portails de type int tableau, Entrée : les bouts des portails (releverPortails)
+ * @param couts de type int tableau, Entrée : le nombre de pas pour passer chaque portail, ou
+ * NULL pour un pas chacun (les trous du bord)
+ * @param nbPortails de type int, Entrée : leur nombre
+ * @param xArrivee, yArrivee de type int, Entrée : l'arrivée
+ * @param minorants de type int tableau, Sortie : le minorant de chaque bout
+ */
+void minorerPortails(const tGeometrie *geo, const int portails[], const int couts[], int nbPortails, int xArrivee, int yArrivee, int minorants[])
+{
+	int nbBouts = 2 * nbPortails;
+	if (nbPortails > MAX_PORTAILS)
+	{
+		return;
+	}
+	int pas = geo->hauteur + 1;
+	for (int e = 0; e < nbBouts; e++)
+	{
+		int sortie = portails[e ^ 1];
+		int cout = (couts != NULL) ? couts[e / 2] : 1;
+		minorants[e] = cout + abs(sortie / pas - xArrivee) + abs(sortie % pas - yArrivee);
+	}
+	// quelques trous seulement : on itère jusqu'à stabilité
+	bool change = true;
+	while (change)
+	{
+		change = false;
+		for (int e = 0; e < nbBouts; e++)
+		{
+			int sortie = portails[e ^ 1];
+			int cout = (couts != NULL) ? couts[e / 2] : 1;
+			for (int f = 0; f < nbBouts; f++)
+			{
+				int entree = portails[f];
+				int parAutre = cout + abs(sortie / pas - entree / pas) + abs(sortie % pas - entree % pas) + minorants[f];
+				if (parAutre < minorants[e])
+				{
+					minorants[e] = parAutre;
+					change = true;
+				}
+			}
+		}
+	}
+}
+
+/**
+ * @brief Procédure qui marque un secteur à réparer.
+ * @param planificateur de type tPlanificateur, Entrée/Sortie : le planificateur
+ * @param secteur de type int, Entrée : le numéro du secteur
+ * @param bords de type bool, Entrée : true si les entrées de ses bords sont aussi à recalculer
+ */
+void marquerSecteur(tPlanificateur *planificateur, int secteur, bool bords)
+{
+	tSecteur *leSecteur = &planificateur->secteurs[secteur];
+	if (bords && !leSecteur->bordsSales)
+	{
+		planificateur->sales[planificateur->nbSales++] = secteur;
+		leSecteur->bordsSales = true;
+	}
+	leSecteur->interieurSale = true;
+}
+
+/**
+ * @brief Procédure qui recalcule les entrées des bords marqués ; les secteurs qui
+ * partagent ces bords devront recalculer leurs distances avant d'être traversés.
+ * @param planificateur de type tPlanificateur, Entrée/Sortie : le planificateur
+ */
+void reparerPlanificateur(tPlanificateur *planificateur)
+{
+	for (int i = 0; i < planificateur->nbSales; i++)
+	{
+		int secteur = planificateur->sales[i];
+		for (int orientation = 0; orientation < 2; orientation++)
+		{
+			int precedent = secteurVoisin(planificateur, secteur, orientation, -1);
+			calculerBord(planificateur, 2 * secteur + orientation);
+			calculerBord(planificateur, 2 * precedent + orientation);
+			planificateur->secteurs[precedent].interieurSale = true;
+			planificateur->secteurs[secteurVoisin(planificateur, secteur, orientation, 1)].interieurSale = true;
+		}
+		planificateur->secteurs[secteur].bordsSales = false;
+	}
+	planificateur->nbSales = 0;
+}
+
+/**
+ * @brief Fonction qui donne un secteur prêt à être traversé, en recalculant ses distances
+ * s'il a changé depuis.
+ * @param planificateur de type tPlanificateur, Entrée/Sortie : le planificateur
+ * @param secteur de type int, Entrée : le numéro du secteur
+ */
+tSecteur *preparerSecteur(tPlanificateur *planificateur, int secteur)
+{
+	tSecteur *leSecteur = &planificateur->secteurs[secteur];
+	if (leSecteur->interieurSale)
+	{
+		calculerSecteur(planificateur, secteur);
+		leSecteur->interieurSale = false;
+	}
+	return leSecteur;
+}
+
+/**
+ * @brief Fonction qui minore la distance d'une case à l'arrivée : distance de Manhattan,
+ * directe ou en passant par un portail ; avec trop de trous, distance de Manhattan en
+ * comptant qu'on peut ressortir n'importe où par le bord opposé.
+ * @param geo de type tGeometrie, Entrée : les dimensions du plateau
+ * @param portails, minorants de type int tableau, Entrée : les portails et leurs minorants (minorerPortails)
+ * @param nbPortails de type int, Entrée : le nombre de portails
+ * @param cellule de type int, Entrée : la case
+ * @param xArrivee, yArrivee de type int, Entrée : l'arrivée
+ */
+int minorerDistance(const tGeometrie *geo, const int portails[], const int minorants[], int nbPortails, int cellule, int xArrivee, int yArrivee)
+{
+	int pas = geo->hauteur + 1;
+	int x = cellule / pas, y = cellule % pas;
+	int dx = abs(x - xArrivee), dy = abs(y - yArrivee);
+	if (nbPortails > MAX_PORTAILS)
+	{
+		dx = (dx < geo->largeur - dx) ? dx : geo->largeur - dx;
+		dy = (dy < geo->hauteur - dy) ? dy : geo->hauteur - dy;
+		return dx + dy;
+	}
+	int minorant = dx + dy;
+	for (int e = 0; e < 2 * nbPortails; e++)
+	{
+		int entree = portails[e];
+		int parPortail = abs(x - entree / pas) + abs(y - entree % pas) + minorants[e];
+		minorant = (parPortail < minorant) ? parPortail : minorant;
+	}
+	return minorant;
+}
+
+/**
+ * @brief Procédure qui propose un chemin plus court vers un noeud pendant la recherche.
+ * @param planificateur de type tPlanificateur, Entrée/Sortie : le planificateur
+ * @param noeud de type uint32_t, Entrée : le noeud atteint
+ * @param cout de type int, Entrée : la distance depuis le départ par ce chemin
+ * @param parent de type uint32_t, Entrée : le noeud précédent (NOEUD_DEPART pour le départ)
+ * @param xArrivee, yArrivee de type int, Entrée : l'arrivée
+ */
+void relaxerNoeud(tPlanificateur *planificateur, uint32_t noeud, int cout, uint32_t parent, int xArrivee, int yArrivee)
+{
+	tNoeudHierarchique *leNoeud = noeudHierarchique(planificateur, noeud);
+	if (leNoeud->generation != planificateur->generation)
+	{
+		leNoeud->generation = planificateur->generation;
+		leNoeud->cout = INT32_MAX;
+		leNoeud->ferme = false;
+	}
+	if (cout >= leNoeud->cout)
+	{
+		return;
+	}
+	leNoeud->cout = cout;
+	leNoeud->parent = parent;
+
+	// ajout au tas, trié par coût plus minorant
+	if (planificateur->tailleTas == planificateur->capaciteTas)
+	{
+		planificateur->capaciteTas = planificateur->capaciteTas ? 2 * planificateur->capaciteTas : 1024;
+		planificateur->tas = realloc(planificateur->tas, planificateur->capaciteTas * sizeof(tElementTas));
+	}
+	int minorant = minorerDistance(&planificateur->geo, planificateur->portails, planificateur->minorantsPortails,
+								   planificateur->nbPortails, leNoeud->cellule, xArrivee, yArrivee);
+	ajouterTas(planificateur->tas, &planificateur->tailleTas, (tElementTas){cout + minorant, noeud});
+}
+
+/**
+ * @brief Procédure qui ajoute un élément à un tas binaire (la place doit être réservée).
+ * @param tas de type tElementTas tableau, Entrée/Sortie : le tas
+ * @param tailleTas de type int*, Entrée/Sortie : son nombre d'éléments
+ * @param element de type tElementTas, Entrée : l'élément à ajouter
+ */
+void ajouterTas(tElementTas tas[], int *tailleTas, tElementTas element)
+{
+	int i = (*tailleTas)++;
+	while (i > 0 && tas[(i - 1) / 2].priorite > element.priorite)
+	{
+		tas[i] = tas[(i - 1) / 2];
+		i = (i - 1) / 2;
+	}
+	tas[i] = element;
+}
+
+/**
+ * @brief Fonction qui retire d'un tas binaire non vide l'élément de plus petite priorité.
+ * @param tas de type tElementTas tableau, Entrée/Sortie : le tas
+ * @param tailleTas de type int*, Entrée/Sortie : son nombre d'éléments
+ */
+tElementTas extraireTas(tElementTas tas[], int *tailleTas)
+{
+	tElementTas premier = tas[0];
+	tElementTas dernier = tas[--(*tailleTas)];
+	int i = 0;
+	while (2 * i + 1 < *tailleTas)
+	{
+		int enfant = 2 * i + 1;
+		if (enfant + 1 < *tailleTas && tas[enfant + 1].priorite < tas[enfant].priorite)
+		{
+			enfant++;
+		}
+		if (tas[enfant].priorite >= dernier.priorite)
+		{
+			break;
+		}
+		tas[i] = tas[enfant];
+		i = enfant;
+	}
+	tas[i] = dernier;
+	return premier;
+}
+
+/**
+ * @brief Fonction qui ajoute au chemin le plus court trajet entre deux cases d'un même
+ * secteur, sans en sortir.
+ * @param planificateur de type tPlanificateur, Entrée/Sortie : le planificateur
+ * @param secteur de type int, Entrée : le secteur des deux cases
+ * @param de de type int, Entrée : la case de départ, qui n'est pas ajoutée
+ * @param vers de type int, Entrée : la case d'arrivée
+ * @param chemin de type int tableau, Sortie : le chemin, rempli au plus jusqu'à capacite cases
+ * @param capacite de type int, Entrée : la taille du tableau chemin
+ * @param longueur de type int, Entrée : le nombre de cases déjà dans le chemin
+ * @return la nouvelle longueur du chemin
+ */
+int ajouterCheminLocal(tPlanificateur *planificateur, int secteur, int de, int vers, int chemin[], int capacite, int longueur)
+{
+	int x0, y0, x1, y1;
+	limitesSecteur(planificateur, secteur, &x0, &y0, &x1, &y1);
+	parcourirSecteur(planificateur, secteur, vers);
+	int pas = planificateur->geo.hauteur + 1;
+	int courante = de;
+	// descend les distances depuis l'arrivée : chaque pas rapproche d'une case
+	while (courante != vers)
+	{
+		int x = courante / pas, y = courante % pas;
+		int suivante = -1, plusPetite = -1;
+		for (int d = 0; d < 4; d++)
+		{
+			int nx = x + DECALAGE_X[d], ny = y + DECALAGE_Y[d];
+			if (nx >= x0 && nx <= x1 && ny >= y0 && ny <= y1)
+			{
+				int distance = planificateur->distancesLocales[(nx - x0) * TAILLE_SECTEUR + ny - y0];
+				if (distance >= 0 && (plusPetite < 0 || distance < plusPetite))
+				{
+					plusPetite = distance;
+					suivante = nx * pas + ny;
+				}
+			}
+		}
+		if (suivante < 0)
+		{
+			break; // ne peut pas arriver : les deux cases sont reliées dans le secteur
+		}
+		if (longueur < capacite)
+		{
+			chemin[longueur] = suivante;
+		}
+		longueur++;
+		courante = suivante;
+	}
+	return longueur;
+}
+
+/**
+ * @brief Fonction qui cherche un chemin entre deux cases : recherche A* sur le graphe des
+ * entrées des secteurs, puis détail de chaque tronçon dans son secteur. Le chemin est
+ * presque toujours le plus court ; il ne passe que par des entrées.
+ * @param planificateur de type tPlanificateur, Entrée/Sortie : le planificateur, réparé au besoin
+ * @param xDepart, yDepart de type int, Entrée : le départ, une case libre (un serpent bloque
+ * les cases de son corps, mais pas celle de sa tête)
+ * @param xArrivee, yArrivee de type int, Entrée : l'arrivée, une case libre
+ * @param chemin de type int tableau, Sortie : les indices à plat des cases du chemin, sans le
+ * départ et jusqu'à l'arrivée, au plus capacite cases
+ * @param capacite de type int, Entrée : la taille du tableau chemin
+ * @return le nombre de cases du chemin (éventuellement plus que capacite), ou -1 si
+ * l'arrivée est inaccessible ou si le départ est bloqué
+ */
+int chercherCheminHierarchique(tPlanificateur *planificateur, int xDepart, int yDepart, int xArrivee, int yArrivee, int chemin[], int capacite)
+{
+	reparerPlanificateur(planificateur);
+	int depart = cellule_generique(&planificateur->geo, xDepart, yDepart);
+	int arrivee = cellule_generique(&planificateur->geo, xArrivee, yArrivee);
+	if (planificateur->cases[depart] == BORDURE || planificateur->cases[arrivee] == BORDURE)
+	{
+		return -1;
+	}
+	int secteurDepart = secteurDeCase(planificateur, xDepart, yDepart);
+	int secteurArrivee = secteurDeCase(planificateur, xArrivee, yArrivee);
+	tSecteur *leDepart = preparerSecteur(planificateur, secteurDepart);
+	tSecteur *lArrivee = preparerSecteur(planificateur, secteurArrivee);
+	planificateur->generation++;
+	planificateur->tailleTas = 0;
+	minorerPortails(&planificateur->geo, planificateur->portails, NULL, planificateur->nbPortails, xArrivee, yArrivee, planificateur->minorantsPortails);
+
+	// l'arrivée et le départ sont reliés aux noeuds de leur secteur
+	parcourirSecteur(planificateur, secteurArrivee, arrivee);
+	for (int i = 0; i < lArrivee->nbNoeuds; i++)
+	{
+		planificateur->distancesArrivee[i] = distanceLocale(planificateur, secteurArrivee, noeudHierarchique(planificateur, lArrivee->noeuds[i])->cellule);
+	}
+	parcourirSecteur(planificateur, secteurDepart, depart);
+	int meilleur = INT32_MAX;
+	uint32_t parentArrivee = NOEUD_DEPART;
+	if (secteurDepart == secteurArrivee && distanceLocale(planificateur, secteurDepart, arrivee) >= 0)
+	{
+		meilleur = distanceLocale(planificateur, secteurDepart, arrivee);
+	}
+	for (int i = 0; i < leDepart->nbNoeuds; i++)
+	{
+		planificateur->distancesDepart[i] = distanceLocale(planificateur, secteurDepart, noeudHierarchique(planificateur, leDepart->noeuds[i])->cellule);
+	}
+	for (int i = 0; i < leDepart->nbNoeuds; i++)
+	{
+		if (planificateur->distancesDepart[i] >= 0)
+		{
+			relaxerNoeud(planificateur, leDepart->noeuds[i], planificateur->distancesDepart[i], NOEUD_DEPART, xArrivee, yArrivee);
+		}
+	}
+
+	// recherche A* sur le graphe des entrées
+	while (planificateur->tailleTas > 0)
+	{
+		tElementTas element = extraireTas(planificateur->tas, &planificateur->tailleTas);
+		if (element.priorite >= meilleur)
+		{
+			break;
+		}
+		tNoeudHierarchique *leNoeud = noeudHierarchique(planificateur, element.noeud);
+		if (leNoeud->ferme)
+		{
+			continue;
+		}
+		leNoeud->ferme = true;
+		int secteur = secteurDuNoeud(planificateur, element.noeud);
+		tSecteur *leSecteur = preparerSecteur(planificateur, secteur);
+		if (secteur == secteurArrivee && planificateur->distancesArrivee[leNoeud->indice] >= 0
+			&& leNoeud->cout + planificateur->distancesArrivee[leNoeud->indice] < meilleur)
+		{
+			meilleur = leNoeud->cout + planificateur->distancesArrivee[leNoeud->indice];
+			parentArrivee = element.noeud;
+		}
+		// l'autre côté de l'entrée, à un pas (peut-être par un trou du bord)
+		relaxerNoeud(planificateur, element.noeud ^ 1, leNoeud->cout + 1, element.noeud, xArrivee, yArrivee);
+		const uint16_t *distances = &leSecteur->distances[leNoeud->indice * leSecteur->nbNoeuds];
+		for (int j = 0; j < leSecteur->nbNoeuds; j++)
+		{
+			if (distances[j] != DISTANCE_INFINIE && j != leNoeud->indice)
+			{
+				relaxerNoeud(planificateur, leSecteur->noeuds[j], leNoeud->cout + distances[j], element.noeud, xArrivee, yArrivee);
+			}
+		}
+	}
+	if (meilleur == INT32_MAX)
+	{
+		return -1;
+	}
+
+	// noeuds du chemin, du départ vers l'arrivée
+	int nbEtapes = 0;
+	for (uint32_t n = parentArrivee; n != NOEUD_DEPART; n = noeudHierarchique(planificateur, n)->parent)
+	{
+		nbEtapes++;
+	}
+	uint32_t *etapes = malloc((nbEtapes + 1) * sizeof(uint32_t));
+	int k = nbEtapes;
+	for (uint32_t n = parentArrivee; n != NOEUD_DEPART; n = noeudHierarchique(planificateur, n)->parent)
+	{
+		etapes[--k] = n;
+	}
+
+	// détail de chaque tronçon
+	int longueur = 0;
+	int courante = depart;
+	for (int e = 0; e < nbEtapes; e++)
+	{
+		int cellule = noeudHierarchique(planificateur, etapes[e])->cellule;
+		if (e > 0 && (etapes[e - 1] ^ etapes[e]) == 1)
+		{
+			// passage d'un côté à l'autre d'une entrée
+			if (longueur < capacite)
+			{
+				chemin[longueur] = cellule;
+			}
+			longueur++;
+		}
+		else
+		{
+			longueur = ajouterCheminLocal(planificateur, secteurDuNoeud(planificateur, etapes[e]), courante, cellule, chemin, capacite, longueur);
+		}
+		courante = cellule;
+	}
+	longueur = ajouterCheminLocal(planificateur, secteurArrivee, courante, arrivee, chemin, capacite, longueur);
+	free(etapes);
+	return longueur;
+}
+
+/**
+ * @brief Fonction qui calcule la longueur exacte du plus court chemin par un parcours en
+ * largeur de tout le plateau, pour comparer avec le planificateur.
+ * @param geo de type tGeometrie, Entrée : les dimensions du plateau
+ * @param cases de type char tableau, Entrée : le plateau à plat
+ * @param depart, arrivee de type int, Entrée : les indices à plat des deux cases
+ * @return la longueur du chemin, ou -1 si l'arrivée est inaccessible
+ */
+int distanceExacte(const tGeometrie *geo, const char *cases, int depart, int arrivee)
+{
+	size_t nbCases = (size_t)(geo->largeur + 1) * (geo->hauteur + 1);
+	int *distances = malloc(nbCases * sizeof(int));
+	int *file = malloc(nbCases * sizeof(int));
+	for (size_t i = 0; i < nbCases; i++)
+	{
+		distances[i] = -1;
+	}
+	int debut = 0, fin = 0;
+	bool teleporte;
+	distances[depart] = 0;
+	file[fin++] = depart;
+	while (debut < fin && distances[arrivee] < 0)
+	{
+		int c = file[debut++];
+		for (int d = 0; d < 4; d++)
+		{
+			int voisin = celluleSuivante_generique(geo, c, d, &teleporte);
+			if (cases[voisin] != BORDURE && distances[voisin] < 0)
+			{
+				distances[voisin] = distances[c] + 1;
+				file[fin++] = voisin;
+			}
+		}
+	}
+	int distance = distances[arrivee];
+	free(distances);
+	free(file);
+	return distance;
+}
+
+/**
+ * @brief Fonction qui vérifie qu'un chemin avance d'une case libre voisine à chaque pas.
+ */
+bool cheminContinu(const tGeometrie *geo, const char *cases, int depart, const int chemin[], int longueur)
+{
+	bool teleporte;
+	int courante = depart;
+	for (int i = 0; i < longueur; i++)
+	{
+		bool voisine = false;
+		for (int d = 0; d < 4; d++)
+		{
+			voisine |= celluleSuivante_generique(geo, courante, d, &teleporte) == chemin[i];
+		}
+		if (!voisine || cases[chemin[i]] == BORDURE)
+		{
+			return false;
+		}
+		courante = chemin[i];
+	}
+	return true;
+}
+
+/**
+ * @brief Fonction qui mesure le planificateur hiérarchique sur un grand plateau carré
+ * semé de pavés : chemin d'un coin à l'autre, puis de nouveau après qu'un corps a barré
+ * ce chemin, comparé au plus court chemin quand le plateau n'est pas trop grand.
+ * @param taille de type int, Entrée : le côté du plateau
+ * @param graine de type uint64_t, Entrée : la graine du tirage des pavés
+ * @return EXIT_SUCCESS, ou EXIT_FAILURE si la mémoire manque
+ */
+int lancerBancHierarchique(int taille, uint64_t graine)
+{
+	tGeometrie geo = {taille, taille};
+	size_t nbCases = (size_t)(taille + 1) * (taille + 1);
+	// un pavé pour 200 cases, loin du bord
+	int nbPaves = (int)((long long)taille * taille / 200);
+	char *cases = malloc(nbCases);
+	int *pavesX = malloc((nbPaves + 1) * sizeof(int));
+	int *pavesY = malloc((nbPaves + 1) * sizeof(int));
+	int capacite = 4 * taille;
+	int *chemin = malloc(capacite * sizeof(int));
+	if (cases == NULL || pavesX == NULL || pavesY == NULL || chemin == NULL)
+	{
+		fprintf(stderr, "Mémoire insuffisante pour un plateau de %dx%d\n", taille, taille);
+		return EXIT_FAILURE;
+	}
+	tGenerateur generateur;
+	initGenerateur(&generateur, graine);
+	for (int p = 0; p < nbPaves; p++)
+	{
+		pavesX[p] = 3 + tirerBorne(&generateur, taille - TAILLE_PAVE - 4);
+		pavesY[p] = 3 + tirerBorne(&generateur, taille - TAILLE_PAVE - 4);
+	}
+	initCasesPlateau(&geo, cases, pavesX, pavesY, nbPaves);
+	int xDepart = 2, yDepart = 2, xArrivee = taille - 1, yArrivee = taille - 1;
+	cases[cellule_generique(&geo, xDepart, yDepart)] = VIDE;
+	cases[cellule_generique(&geo, xArrivee, yArrivee)] = VIDE;
+	int depart = cellule_generique(&geo, xDepart, yDepart), arrivee = cellule_generique(&geo, xArrivee, yArrivee);
+	// au-delà, le parcours de tout le plateau prend trop de mémoire
+	bool comparer = nbCases <= 16000000;
+
+	long long debut = maintenantNano();
+	tPlanificateur planificateur;
+	if (!initPlanificateur(&planificateur, &geo, cases))
+	{
+		fprintf(stderr, "Impossible de préparer le planificateur pour %dx%d\n", taille, taille);
+		return EXIT_FAILURE;
+	}
+	printf("Plateau %dx%d, %d pavés, %d secteurs de %dx%d : préparation en %.1f ms\n", taille, taille, nbPaves,
+		   planificateur.nbSecteursX * planificateur.nbSecteursY, TAILLE_SECTEUR, TAILLE_SECTEUR, (maintenantNano() - debut) / 1e6);
+
+	for (int essai = 0; essai < 2; essai++)
+	{
+		debut = maintenantNano();
+		int longueur = chercherCheminHierarchique(&planificateur, xDepart, yDepart, xArrivee, yArrivee, chemin, capacite);
+		double duree = (maintenantNano() - debut) / 1e6;
+		if (longueur < 0)
+		{
+			printf("Chemin hiérarchique : arrivée inaccessible (%.3f ms)\n", duree);
+		}
+		else
+		{
+			printf("Chemin hiérarchique : %d cases en %.3f ms, %s\n", longueur, duree,
+				   (longueur <= capacite && cheminContinu(&geo, cases, depart, chemin, longueur) && chemin[longueur - 1] == arrivee) ? "continu" : "INVALIDE");
+		}
+		if (comparer)
+		{
+			debut = maintenantNano();
+			int exacte = distanceExacte(&geo, cases, depart, arrivee);
+			printf("Plus court chemin (parcours de tout le plateau) : %d cases en %.1f ms\n", exacte, (maintenantNano() - debut) / 1e6);
+		}
+		if (essai == 0 && longueur >= 0 && longueur <= capacite)
+		{
+			// un corps barre le chemin en son milieu, sur trois secteurs de large
+			int pas = taille + 1;
+			int xMilieu = chemin[longueur / 2] / pas, yMilieu = chemin[longueur / 2] % pas;
+			int nbBloquees = 0;
+			for (int k = -3 * TAILLE_SECTEUR / 2; k <= 3 * TAILLE_SECTEUR / 2; k++)
+			{
+				if (xMilieu + k > 1 && xMilieu + k < taille && cases[cellule_generique(&geo, xMilieu + k, yMilieu)] != BORDURE)
+				{
+					modifierCasePlanificateur(&planificateur, xMilieu + k, yMilieu, BORDURE);
+					nbBloquees++;
+				}
+			}
+			printf("%d cases bloquées autour de (%d, %d), secteurs réparés à la recherche suivante\n", nbBloquees, xMilieu, yMilieu);
+		}
+	}
+
+	libererPlanificateur(&planificateur);
+	free(cases);
+	free(pavesX);
+	free(pavesY);
+	free(chemin);
+	return EXIT_SUCCESS;
+}
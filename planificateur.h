@@ -0,0 +1,113 @@
+/**
+ * @file planificateur.h
+ * @brief Planificateur hiérarchique de chemins sur un plateau de taille quelconque (version4 --hierarchique)
+ * @author Noah Le Goff, Sacha Mace
+ *
+ * Le plateau est découpé en secteurs carrés reliés par leurs entrées : une recherche
+ * traverse le graphe des entrées avant de détailler chaque secteur traversé, et une
+ * case modifiée ne fait recalculer que les secteurs qui la touchent. Le tas de
+ * priorités (tElementTas) sert aussi à la recherche par points de saut.
+ */
+
+#ifndef PLANIFICATEUR_H
+#define PLANIFICATEUR_H
+
+#include "jeu.h"
+
+// planificateur hiérarchique : côté d'un secteur, nombre maximal d'entrées d'un bord,
+// longueur de passage à partir de laquelle il a une entrée à chaque bout plutôt qu'au milieu
+#define TAILLE_SECTEUR 16
+#define MAX_ENTREES_BORD TAILLE_SECTEUR
+#define PASSAGE_LONG 6
+#define DISTANCE_INFINIE UINT16_MAX
+#define NOEUD_DEPART UINT32_MAX
+
+// planificateur hiérarchique : le plateau est découpé en secteurs carrés reliés par
+// leurs entrées, et une recherche de chemin traverse le graphe des entrées avant de
+// détailler chaque secteur traversé
+typedef struct
+{
+	int cellule;						// indice à plat de la case d'entrée
+	int indice;							// rang dans la liste des noeuds de son secteur
+	int cout;							// recherche en cours : distance depuis le départ
+	uint32_t parent;					// recherche en cours : noeud précédent
+	unsigned generation;				// recherche qui a écrit cout, parent et ferme
+	bool ferme;
+} tNoeudHierarchique;
+
+// bord entre un secteur et son voisin de droite ou du dessous ; le dernier secteur d'une
+// ligne (ou d'une colonne) est voisin du premier, par les trous du bord du plateau
+typedef struct
+{
+	int nbEntrees;
+	tNoeudHierarchique *noeuds;			// deux noeuds par entrée : côté secteur puis côté voisin
+} tBordSecteur;
+
+typedef struct
+{
+	int nbNoeuds;
+	uint32_t *noeuds;					// noeuds des quatre bords du secteur
+	uint16_t *distances;				// distances entre ces noeuds sans sortir du secteur
+	bool bordsSales;					// une case d'un bord a changé : entrées à recalculer
+	bool interieurSale;					// distances à recalculer avant d'entrer dans le secteur
+} tSecteur;
+
+typedef struct
+{
+	int priorite;
+	uint32_t noeud;
+} tElementTas;
+
+typedef struct
+{
+	tGeometrie geo;
+	char *cases;						// plateau à plat, BORDURE pour une case bloquée
+	int nbSecteursX, nbSecteursY;
+	tSecteur *secteurs;
+	tBordSecteur *bords;				// deux bords par secteur : droite puis bas
+	int *sales;							// secteurs dont les bords sont à réparer avant la prochaine recherche
+	int nbSales;
+	unsigned generation;
+	// paires de trous face à face sur les bords opposés du plateau (portails), et pour la
+	// recherche en cours le minorant de la distance à l'arrivée en entrant par chaque bout
+	int nbPortails;						// MAX_PORTAILS + 1 : trop de trous, minorant sans portails
+	int portails[2 * MAX_PORTAILS];
+	int minorantsPortails[2 * MAX_PORTAILS];
+	// tampons des parcours d'un secteur et de la recherche sur le graphe des entrées
+	int *distancesLocales;
+	int *fileLocale;
+	int distancesDepart[4 * MAX_ENTREES_BORD];
+	int distancesArrivee[4 * MAX_ENTREES_BORD];
+	tElementTas *tas;
+	int tailleTas, capaciteTas;
+} tPlanificateur;
+
+bool initPlanificateur(tPlanificateur *planificateur, const tGeometrie *geo, char *cases);
+void libererPlanificateur(tPlanificateur *planificateur);
+void limitesSecteur(const tPlanificateur *planificateur, int secteur, int *x0, int *y0, int *x1, int *y1);
+int secteurDeCase(const tPlanificateur *planificateur, int x, int y);
+int secteurVoisin(const tPlanificateur *planificateur, int secteur, int orientation, int pas);
+tNoeudHierarchique *noeudHierarchique(const tPlanificateur *planificateur, uint32_t noeud);
+int secteurDuNoeud(const tPlanificateur *planificateur, uint32_t noeud);
+void calculerBord(tPlanificateur *planificateur, int bord);
+void calculerSecteur(tPlanificateur *planificateur, int secteur);
+void parcourirSecteur(tPlanificateur *planificateur, int secteur, int depart);
+int distanceLocale(const tPlanificateur *planificateur, int secteur, int cellule);
+void modifierCasePlanificateur(tPlanificateur *planificateur, int x, int y, char car);
+void marquerSecteur(tPlanificateur *planificateur, int secteur, bool bords);
+void reparerPlanificateur(tPlanificateur *planificateur);
+tSecteur *preparerSecteur(tPlanificateur *planificateur, int secteur);
+void trouverPortails(tPlanificateur *planificateur);
+int releverPortails(const tGeometrie *geo, const char *cases, int portails[]);
+void minorerPortails(const tGeometrie *geo, const int portails[], const int couts[], int nbPortails, int xArrivee, int yArrivee, int minorants[]);
+int minorerDistance(const tGeometrie *geo, const int portails[], const int minorants[], int nbPortails, int cellule, int xArrivee, int yArrivee);
+void relaxerNoeud(tPlanificateur *planificateur, uint32_t noeud, int cout, uint32_t parent, int xArrivee, int yArrivee);
+void ajouterTas(tElementTas tas[], int *tailleTas, tElementTas element);
+tElementTas extraireTas(tElementTas tas[], int *tailleTas);
+int ajouterCheminLocal(tPlanificateur *planificateur, int secteur, int de, int vers, int chemin[], int capacite, int longueur);
+int chercherCheminHierarchique(tPlanificateur *planificateur, int xDepart, int yDepart, int xArrivee, int yArrivee, int chemin[], int capacite);
+int distanceExacte(const tGeometrie *geo, const char *cases, int depart, int arrivee);
+bool cheminContinu(const tGeometrie *geo, const char *cases, int depart, const int chemin[], int longueur);
+int lancerBancHierarchique(int taille, uint64_t graine);
+
+#endif
@@ -0,0 +1,73 @@
+/**
+ * @file politique.h
+ * @brief Fichier de poids d'une politique neuronale du jeu snake autonome (version4 --politique)
+ * @author Noah Le Goff, Sacha Mace
+ *
+ * Une politique est un perceptron multicouche : POLITIQUE_ENTREES caractéristiques du
+ * serpent en entrée, une fonction ReLU après chaque couche sauf la dernière, et
+ * POLITIQUE_SORTIES scores en sortie, un par direction (haut, bas, gauche, droite) ; le
+ * serpent prend la direction de plus haut score parmi celles qui ne sont pas bloquées.
+ * Les entiers et les réels sont dans l'ordre des octets de la machine.
+ *
+ * Fichier :
+ *   tEnteteModele, puis pour chacune des nbCouches couches un tEnteteCouche suivi de
+ *   COUCHE_REELS   sorties x entrees float (poids, neurone par neurone), sorties float (biais)
+ *   COUCHE_OCTETS  sorties float (échelle de chaque neurone), sorties x entrees int8_t
+ *                  (poids divisés par l'échelle du neurone), sorties float (biais)
+ *
+ * Caractéristiques, calculées sur le plateau où les corps des deux serpents sont des murs :
+ *   pour chaque direction d, à partir de CARACTERISTIQUE_DIRECTION + d * CARACTERISTIQUES_PAR_DIRECTION :
+ *     0  1 si la case où mène d est bloquée
+ *     1  1 si d est le premier pas d'un plus court chemin vers une pomme
+ *     2  distance de cette case à la pomme la plus proche, divisée par LARGEUR + HAUTEUR
+ *        (1 au-delà, ou si aucune pomme n'est accessible)
+ *     3  cases accessibles depuis cette case, divisées par le nombre de cases libres
+ *     4  1 s'il y en a moins que d'anneaux du serpent
+ *     5  1 si la tête de l'adversaire peut aussi y entrer à ce tour
+ *     6  1 si d est la direction courante du serpent
+ *   puis, à partir de CARACTERISTIQUE_FENETRE, les cases de la fenêtre de FENETRE_POLITIQUE
+ *   de côté centrée sur la tête, colonne par colonne : 1 si la case est bloquée (le plateau
+ *   se referme sur lui-même par les bords, comme par les trous)
+ */
+
+#ifndef POLITIQUE_H
+#define POLITIQUE_H
+
+#include <stdint.h>
+
+// marque de reconnaissance d'un fichier de poids
+#define POLITIQUE_MAGIQUE 0x534E4B50
+
+// caractéristiques d'entrée et scores de sortie
+#define CARACTERISTIQUES_PAR_DIRECTION 7
+#define CARACTERISTIQUE_DIRECTION 0
+#define FENETRE_POLITIQUE 7
+#define CARACTERISTIQUE_FENETRE (4 * CARACTERISTIQUES_PAR_DIRECTION)
+#define POLITIQUE_ENTREES (CARACTERISTIQUE_FENETRE + FENETRE_POLITIQUE * FENETRE_POLITIQUE)
+#define POLITIQUE_SORTIES 4
+
+// nombre maximal de couches et de neurones d'une couche
+#define MAX_COUCHES_POLITIQUE 8
+#define MAX_LARGEUR_POLITIQUE 1024
+
+// type des poids d'une couche
+#define COUCHE_REELS 0
+#define COUCHE_OCTETS 1
+
+// entête du fichier
+typedef struct
+{
+	uint32_t magique;
+	uint16_t nbCouches;
+	uint16_t reserve;
+} tEnteteModele;
+
+// entête de chaque couche
+typedef struct
+{
+	uint16_t entrees, sorties;
+	uint8_t type;						// COUCHE_REELS ou COUCHE_OCTETS
+	uint8_t reserve[3];
+} tEnteteCouche;
+
+#endif
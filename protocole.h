@@ -0,0 +1,96 @@
+/**
+ * @file protocole.h
+ * @brief Protocole binaire du mode serveur (version4 --serveur) et du flux de spectateur
+ * (version4 --flux) du jeu snake autonome
+ * @author Noah Le Goff, Sacha Mace
+ *
+ * Le serveur écoute sur une socket du domaine Unix. Un client crée un lot de parties,
+ * puis joue tous ses tours en un seul message : une paire de directions par partie en
+ * entrée, un delta de taille fixe par partie en sortie. Les entiers sont dans l'ordre
+ * des octets de la machine (client et serveur sont sur le même hôte) et les
+ * coordonnées, toujours entre 1 et 80, tiennent sur un octet ; 0 veut dire « aucune ».
+ *
+ * Client -> serveur :
+ *   MESSAGE_CREER      tEntete + uint64_t graine : remplace le lot de la connexion par
+ *                      nbParties parties de graines graine, graine + 1, ...
+ *   MESSAGE_DIRECTIONS tEntete + nbParties x 2 octets : direction des serpents 1 et 2 de
+ *                      chaque partie ('z', 's', 'q', 'd'), ou 0 pour laisser jouer l'IA
+ * Serveur -> client :
+ *   MESSAGE_ETATS      tEntete + nbParties x tEtatInitial, en réponse à MESSAGE_CREER
+ *   MESSAGE_DELTAS     tEntete + nbParties x tDelta, en réponse à MESSAGE_DIRECTIONS
+ *   MESSAGE_ERREUR     tEntete seul, pour un message incompréhensible ou un lot refusé faute
+ *                      de mémoire ; la connexion est fermée
+ *
+ * Flux de spectateur (version4 --flux FICHIER), lu par le programme spectateur :
+ *   MESSAGE_PLATEAU    tEntete + tDimensions + largeur x hauteur caractères du plateau
+ *                      (cases 1 à largeur, 1 à hauteur, colonne par colonne, pomme comprise)
+ *   MESSAGE_ETATS      tEntete + un tEtatInitial
+ *   MESSAGE_DELTAS     tEntete + un tDelta, un par tour, jusqu'à EVENEMENT_FIN
+ * Pour suivre le plateau, le spectateur efface d'abord les queues puis dessine les têtes :
+ * une tête peut arriver sur la case qu'une queue vient de quitter.
+ */
+
+#ifndef PROTOCOLE_H
+#define PROTOCOLE_H
+
+#include <stdint.h>
+
+// types de message
+#define MESSAGE_CREER 1
+#define MESSAGE_DIRECTIONS 2
+#define MESSAGE_ETATS 3
+#define MESSAGE_DELTAS 4
+#define MESSAGE_ERREUR 5
+#define MESSAGE_PLATEAU 6
+
+// options de MESSAGE_CREER
+#define OPTION_POMMES_PROCEDURALES 1
+#define OPTION_CROISSANCE 2
+
+// nombre maximal de parties d'un lot ; le serveur refuse aussi un lot qui dépasserait
+// la mémoire permise à une connexion (MESSAGE_ERREUR)
+#define MAX_PARTIES_LOT 512
+// nombre d'anneaux des serpents au départ
+#define PROTOCOLE_TAILLE_INITIALE 10
+
+// événements d'un tour, cumulés dans tDelta.evenements
+#define EVENEMENT_POMME_S1 1			// le serpent 1 a mangé la pomme
+#define EVENEMENT_POMME_S2 2			// le serpent 2 a mangé la pomme
+#define EVENEMENT_COLLISION_S1 4
+#define EVENEMENT_COLLISION_S2 8
+#define EVENEMENT_FIN 16				// partie terminée : les tours suivants ne changent plus rien
+
+// entête de chaque message
+typedef struct
+{
+	uint8_t type;						// MESSAGE_*
+	uint8_t options;					// OPTION_* pour MESSAGE_CREER
+	uint16_t nbParties;					// nombre de parties du lot concernées
+} tEntete;
+
+// dimensions du plateau annoncé par MESSAGE_PLATEAU
+typedef struct
+{
+	uint8_t largeur, hauteur;
+} tDimensions;
+
+// position de départ d'une partie : anneaux des deux serpents (tête en premier) et pomme
+typedef struct
+{
+	uint8_t anneauxX[2][PROTOCOLE_TAILLE_INITIALE];
+	uint8_t anneauxY[2][PROTOCOLE_TAILLE_INITIALE];
+	uint8_t pommeX, pommeY;
+} tEtatInitial;
+
+// changements d'une partie pendant un tour : c'est tout ce qu'il faut pour suivre le
+// plateau, sans jamais le renvoyer en entier
+typedef struct
+{
+	uint8_t teteX[2], teteY[2];			// nouvelle tête de chaque serpent
+	uint8_t queueX[2], queueY[2];		// case quittée par la queue, 0 si le serpent a grandi
+	uint8_t pommeX, pommeY;				// nouvelle pomme, 0 si la pomme n'a pas changé
+	uint8_t evenements;					// EVENEMENT_*
+	uint8_t reserve;
+} tDelta;
+
+#endif
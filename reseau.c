@@ -0,0 +1,987 @@
+/**
+ * @file reseau.c
+ * @brief Politique neuronale du jeu snake : décisions par lots, entraînement par imitation et évaluation
+ * @author Noah Le Goff, Sacha Mace
+ */
+
+/* Fichiers inclus */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "reseau.h"
+#include "bitboard.h"
+
+// produit matriciel d'une couche de la politique, choisi à l'exécution par initNoyauCollision
+void (*appliquerCouche)(const tCouche *couche, const float *entrees, int nbLignes, float *sorties) = appliquerCoucheScalaire;
+
+// Avec --politique FICHIER, chaque serpent est dirigé par un petit perceptron multicouche
+// (voir politique.h) : ses caractéristiques sont calculées sur le plateau en bits, puis
+// chaque couche est un produit matriciel entre les caractéristiques de tous les serpents
+// décidés ensemble (une ligne par serpent) et les poids de la couche (une ligne par
+// neurone). Le produit est découpé en blocs d'entrées et de neurones : un bloc de poids
+// reste dans le cache de premier niveau pendant qu'il passe sur toutes les lignes, deux
+// lignes et quatre neurones à la fois, huit entrées par instruction avec AVX2. Les poids
+// en octets (une échelle par neurone) prennent quatre fois moins de place et sont
+// convertis en réels au vol. Faute de politique entraînée ailleurs,
+// --entrainer-politique en apprend une en imitant le mode --jps.
+
+/**
+ * @brief Fonction qui calcule les caractéristiques d'entrée de la politique pour un serpent
+ * (voir politique.h), sur le plateau en bits : les distances aux pommes par un parcours en largeur par couches
+ * parti de toutes les pommes à la fois, arrêté dès que les quatre voisines de la tête sont
+ * atteintes, et l'espace libre derrière chaque coup par un remplissage par voisine, partagé
+ * entre les voisines qui tombent dans la même zone.
+ * @param etat de type tEtatJeu, Entrée : la partie
+ * @param numero de type int, Entrée : le numéro du serpent (1 ou 2)
+ * @param entree de type float tableau, Sortie : les ENTREES_ALIGNEES_POLITIQUE valeurs,
+ * complétées par des zéros après les POLITIQUE_ENTREES caractéristiques
+ */
+void caracteristiquesPolitique(const tEtatJeu *etat, int numero, float entree[])
+{
+	tBitboard libres, pommes, frontiere, restantes;
+	bool teleporte;
+	const tSerpent *serpent = &etat->serpents[numero - 1];
+	const tCorps *corps = &serpent->corps;
+	const tCorps *corpsAutre = &etat->serpents[2 - numero].corps;
+	const tPortails *portails = portailsPartie(etat);
+
+	// cases libres et pommes en un seul passage sur le plateau, puis les corps des deux
+	// serpents retirés des cases libres
+	memset(entree, 0, ENTREES_ALIGNEES_POLITIQUE * sizeof(float));
+	memset(&libres, 0, sizeof(libres));
+	memset(&pommes, 0, sizeof(pommes));
+	for (int x = 1; x <= LARGEUR_PLATEAU; x++)
+	{
+		const char *colonne = etat->plateau[x];
+		for (int y = 1; y <= HAUTEUR_PLATEAU; y++)
+		{
+			libres.colonnes[x] |= (uint64_t)(colonne[y] != BORDURE) << y;
+			pommes.colonnes[x] |= (uint64_t)(colonne[y] == POMME) << y;
+		}
+	}
+	for (int s = 0; s < 2; s++)
+	{
+		const tCorps *anneaux = &etat->serpents[s].corps;
+		for (int i = 0; i < anneaux->taille; i++)
+		{
+			libres.colonnes[anneaux->lesX[anneaux->tete + i]] &= ~(1ULL << anneaux->lesY[anneaux->tete + i]);
+		}
+	}
+	int nbLibres = compterBits(&libres);
+	int xTete = corps->lesX[corps->tete], yTete = corps->lesY[corps->tete];
+	int tete = cellule_80x40(&GEOMETRIE_PLATEAU, xTete, yTete);
+	int teteAutre = cellule_80x40(&GEOMETRIE_PLATEAU, corpsAutre->lesX[corpsAutre->tete], corpsAutre->lesY[corpsAutre->tete]);
+	int voisines[4], distances[4], aAtteindre = 0;
+	bool bloquees[4];
+	for (int d = 0; d < 4; d++)
+	{
+		voisines[d] = celluleSuivantePortails(portails, tete, d, &teleporte);
+		bloquees[d] = !testerBit(&libres, voisines[d]);
+		distances[d] = -1;
+		aAtteindre += !bloquees[d];
+	}
+
+	// distances depuis les pommes, couche par couche
+	frontiere = pommes;
+	restantes = libres;
+	for (int x = 1; x <= LARGEUR_PLATEAU; x++)
+	{
+		restantes.colonnes[x] &= ~pommes.colonnes[x];
+	}
+	for (int couche = 0; aAtteindre > 0; couche++)
+	{
+		for (int d = 0; d < 4; d++)
+		{
+			if (distances[d] < 0 && testerBit(&frontiere, voisines[d]))
+			{
+				distances[d] = couche;
+				aAtteindre--;
+			}
+		}
+		if (aAtteindre > 0 && !avancerCouche(&frontiere, &restantes, portails))
+		{
+			break;
+		}
+	}
+	int plusCourte = -1;
+	for (int d = 0; d < 4; d++)
+	{
+		if (distances[d] >= 0 && (plusCourte < 0 || distances[d] < plusCourte))
+		{
+			plusCourte = distances[d];
+		}
+	}
+
+	// espace libre derrière chaque coup
+	int espaces[4] = {0, 0, 0, 0};
+	for (int d = 0; d < 4; d++)
+	{
+		if (bloquees[d] || espaces[d] > 0)
+		{
+			continue;
+		}
+		memset(&frontiere, 0, sizeof(frontiere));
+		poserBit(&frontiere, voisines[d]);
+		restantes = libres;
+		restantes.colonnes[voisines[d] / (HAUTEUR_PLATEAU + 1)] &= ~frontiere.colonnes[voisines[d] / (HAUTEUR_PLATEAU + 1)];
+		int nbRestantes = compterBits(&restantes);
+		while (avancerCouche(&frontiere, &restantes, portails))
+		{
+		}
+		espaces[d] = 1 + nbRestantes - compterBits(&restantes);
+		// les voisines atteintes par ce remplissage ont le même espace
+		for (int autre = d + 1; autre < 4; autre++)
+		{
+			if (!bloquees[autre] && !testerBit(&restantes, voisines[autre]))
+			{
+				espaces[autre] = espaces[d];
+			}
+		}
+	}
+
+	for (int d = 0; d < 4; d++)
+	{
+		float *direction = &entree[CARACTERISTIQUE_DIRECTION + d * CARACTERISTIQUES_PAR_DIRECTION];
+		bool contestee = false;
+		for (int a = 0; a < 4; a++)
+		{
+			contestee |= (celluleSuivantePortails(portails, teteAutre, a, &teleporte) == voisines[d]);
+		}
+		direction[0] = bloquees[d];
+		direction[1] = (distances[d] >= 0 && distances[d] == plusCourte);
+		direction[2] = (distances[d] < 0 || distances[d] >= LARGEUR_PLATEAU + HAUTEUR_PLATEAU) ? 1.0f : (float)distances[d] / (LARGEUR_PLATEAU + HAUTEUR_PLATEAU);
+		direction[3] = (float)espaces[d] / nbLibres;
+		direction[4] = (!bloquees[d] && espaces[d] < corps->taille);
+		direction[5] = contestee;
+		direction[6] = (LES_DIRECTIONS[d] == serpent->direction);
+	}
+
+	// fenêtre autour de la tête, refermée par les bords
+	float *fenetre = &entree[CARACTERISTIQUE_FENETRE];
+	for (int i = 0; i < FENETRE_POLITIQUE; i++)
+	{
+		int x = (xTete - 1 + i - FENETRE_POLITIQUE / 2 + LARGEUR_PLATEAU) % LARGEUR_PLATEAU + 1;
+		for (int j = 0; j < FENETRE_POLITIQUE; j++)
+		{
+			int y = (yTete - 1 + j - FENETRE_POLITIQUE / 2 + HAUTEUR_PLATEAU) % HAUTEUR_PLATEAU + 1;
+			fenetre[i * FENETRE_POLITIQUE + j] = !testerBit(&libres, cellule_80x40(&GEOMETRIE_PLATEAU, x, y));
+		}
+	}
+}
+
+/**
+ * @brief Procédure qui initialise chaque ligne de sortie d'une couche avec ses biais.
+ * @param couche de type tCouche, Entrée : la couche
+ * @param nbLignes de type int, Entrée : le nombre de lignes
+ * @param sorties de type float tableau, Sortie : nbLignes x pasSorties valeurs
+ */
+void initialiserSorties(const tCouche *couche, int nbLignes, float *sorties)
+{
+	for (int b = 0; b < nbLignes; b++)
+	{
+		memcpy(&sorties[(size_t)b * couche->pasSorties], couche->biais, couche->pasSorties * sizeof(float));
+	}
+}
+
+/**
+ * @brief Procédure qui applique une couche à un lot de lignes, bloc par bloc, sans
+ * instruction vectorielle : sorties = biais + entrees x poids transposés.
+ * @param couche de type tCouche, Entrée : la couche
+ * @param entrees de type float tableau, Entrée : nbLignes x pasEntrees valeurs
+ * @param nbLignes de type int, Entrée : le nombre de lignes
+ * @param sorties de type float tableau, Sortie : nbLignes x pasSorties valeurs, sans ReLU
+ */
+void appliquerCoucheScalaire(const tCouche *couche, const float *entrees, int nbLignes, float *sorties)
+{
+	const int pasEntrees = couche->pasEntrees, pasSorties = couche->pasSorties;
+	initialiserSorties(couche, nbLignes, sorties);
+	for (int k0 = 0; k0 < pasEntrees; k0 += BLOC_ENTREES_POLITIQUE)
+	{
+		int k1 = (k0 + BLOC_ENTREES_POLITIQUE < pasEntrees) ? k0 + BLOC_ENTREES_POLITIQUE : pasEntrees;
+		for (int n0 = 0; n0 < pasSorties; n0 += BLOC_NEURONES_POLITIQUE)
+		{
+			int n1 = (n0 + BLOC_NEURONES_POLITIQUE < pasSorties) ? n0 + BLOC_NEURONES_POLITIQUE : pasSorties;
+			for (int b = 0; b < nbLignes; b++)
+			{
+				const float *x = &entrees[(size_t)b * pasEntrees];
+				for (int n = n0; n < n1; n++)
+				{
+					float somme = 0;
+					if (couche->octets)
+					{
+						const int8_t *w = &couche->poidsOctets[(size_t)n * pasEntrees];
+						for (int k = k0; k < k1; k++)
+						{
+							somme += x[k] * w[k];
+						}
+						somme *= couche->echelles[n];
+					}
+					else
+					{
+						const float *w = &couche->poids[(size_t)n * pasEntrees];
+						for (int k = k0; k < k1; k++)
+						{
+							somme += x[k] * w[k];
+						}
+					}
+					sorties[(size_t)b * pasSorties + n] += somme;
+				}
+			}
+		}
+	}
+}
+
+#ifdef NOYAU_X86
+/**
+ * @brief Fonction qui additionne les huit réels d'un registre AVX.
+ * @param v de type __m256, Entrée : le registre
+ */
+__attribute__((target("avx2,fma"))) float sommerRegistre(__m256 v)
+{
+	__m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+	s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+	s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+	return _mm_cvtss_f32(s);
+}
+
+/**
+ * @brief Version AVX2 de appliquerCoucheScalaire : deux lignes et quatre neurones à la
+ * fois, huit entrées par multiplication-addition ; les poids en octets sont étendus en
+ * réels au vol.
+ */
+__attribute__((target("avx2,fma"))) void appliquerCoucheAVX2(const tCouche *couche, const float *entrees, int nbLignes, float *sorties)
+{
+	const int pasEntrees = couche->pasEntrees, pasSorties = couche->pasSorties;
+	initialiserSorties(couche, nbLignes, sorties);
+	for (int k0 = 0; k0 < pasEntrees; k0 += BLOC_ENTREES_POLITIQUE)
+	{
+		int k1 = (k0 + BLOC_ENTREES_POLITIQUE < pasEntrees) ? k0 + BLOC_ENTREES_POLITIQUE : pasEntrees;
+		for (int n0 = 0; n0 < pasSorties; n0 += BLOC_NEURONES_POLITIQUE)
+		{
+			int n1 = (n0 + BLOC_NEURONES_POLITIQUE < pasSorties) ? n0 + BLOC_NEURONES_POLITIQUE : pasSorties;
+			for (int b = 0; b < nbLignes; b += 2)
+			{
+				// une ligne seule à la fin : elle est calculée deux fois, la copie est ignorée
+				bool deuxLignes = (b + 1 < nbLignes);
+				const float *x0 = &entrees[(size_t)b * pasEntrees];
+				const float *x1 = deuxLignes ? x0 + pasEntrees : x0;
+				for (int n = n0; n < n1; n += 4)
+				{
+					__m256 somme0[4], somme1[4];
+					for (int j = 0; j < 4; j++)
+					{
+						somme0[j] = _mm256_setzero_ps();
+						somme1[j] = _mm256_setzero_ps();
+					}
+					for (int k = k0; k < k1; k += 8)
+					{
+						__m256 a0 = _mm256_loadu_ps(&x0[k]);
+						__m256 a1 = _mm256_loadu_ps(&x1[k]);
+						for (int j = 0; j < 4; j++)
+						{
+							__m256 w;
+							if (couche->octets)
+							{
+								__m128i octets = _mm_loadl_epi64((const __m128i *)&couche->poidsOctets[(size_t)(n + j) * pasEntrees + k]);
+								w = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(octets));
+							}
+							else
+							{
+								w = _mm256_loadu_ps(&couche->poids[(size_t)(n + j) * pasEntrees + k]);
+							}
+							somme0[j] = _mm256_fmadd_ps(a0, w, somme0[j]);
+							somme1[j] = _mm256_fmadd_ps(a1, w, somme1[j]);
+						}
+					}
+					for (int j = 0; j < 4; j++)
+					{
+						float echelle = couche->octets ? couche->echelles[n + j] : 1.0f;
+						sorties[(size_t)b * pasSorties + n + j] += echelle * sommerRegistre(somme0[j]);
+						if (deuxLignes)
+						{
+							sorties[(size_t)(b + 1) * pasSorties + n + j] += echelle * sommerRegistre(somme1[j]);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+#endif
+
+/**
+ * @brief Fonction qui évalue le modèle sur un lot de lignes : les couches écrivent tour à
+ * tour dans les deux tampons, avec une ReLU entre deux couches.
+ * @param modele de type tModele, Entrée : la politique
+ * @param caracteristiques de type float tableau, Entrée : ENTREES_ALIGNEES_POLITIQUE
+ * caractéristiques par ligne, laissées intactes
+ * @param tampons de type float* tableau, Entrée/Sortie : deux tampons d'activations
+ * @param nbLignes de type int, Entrée : le nombre de lignes
+ * @return le tampon des scores, pasSorties de la dernière couche par ligne
+ */
+float *evaluerModele(const tModele *modele, const float *caracteristiques, float *tampons[2], int nbLignes)
+{
+	const float *entrees = caracteristiques;
+	float *sorties = tampons[0];
+	for (int l = 0; l < modele->nbCouches; l++)
+	{
+		const tCouche *couche = &modele->couches[l];
+		sorties = tampons[l % 2];
+		appliquerCouche(couche, entrees, nbLignes, sorties);
+		if (l < modele->nbCouches - 1)
+		{
+			for (size_t i = 0; i < (size_t)nbLignes * couche->pasSorties; i++)
+			{
+				sorties[i] = (sorties[i] > 0) ? sorties[i] : 0;
+			}
+		}
+		entrees = sorties;
+	}
+	return sorties;
+}
+
+/**
+ * @brief Fonction qui choisit la direction de plus haut score parmi celles qui ne sont pas
+ * bloquées.
+ * @param scores de type float tableau, Entrée : le score de chaque direction
+ * @param entree de type float tableau, Entrée : les caractéristiques du serpent
+ * @return l'indice de la direction, -1 si les quatre sont bloquées
+ */
+int choisirDirectionPolitique(const float scores[], const float entree[])
+{
+	int meilleure = -1;
+	for (int d = 0; d < 4; d++)
+	{
+		bool bloquee = entree[CARACTERISTIQUE_DIRECTION + d * CARACTERISTIQUES_PAR_DIRECTION] != 0;
+		if (!bloquee && (meilleure < 0 || scores[d] > scores[meilleure]))
+		{
+			meilleure = d;
+		}
+	}
+	return meilleure;
+}
+
+/**
+ * @brief Fonction qui choisit la direction d'un serpent en mode --politique, une décision
+ * à la fois, sans allocation.
+ * @param etat de type tEtatJeu, Entrée : la partie
+ * @param numero de type int, Entrée : le numéro du serpent (1 ou 2)
+ * @param direction de type char, Sortie : la direction du serpent, inchangée si tout est bloqué
+ * @return false si les quatre directions sont bloquées : la décision revient alors à l'IA habituelle
+ */
+bool directionPolitique(const tEtatJeu *etat, int numero, char *direction)
+{
+	float entree[ENTREES_ALIGNEES_POLITIQUE];
+	float activations[2][MAX_LARGEUR_POLITIQUE];
+	float *tampons[2] = {activations[0], activations[1]};
+
+	caracteristiquesPolitique(etat, numero, entree);
+	int meilleure = choisirDirectionPolitique(evaluerModele(etat->contexte->modele, entree, tampons, 1), entree);
+	if (meilleure < 0)
+	{
+		return false;
+	}
+	*direction = LES_DIRECTIONS[meilleure];
+	return true;
+}
+
+/**
+ * @brief Fonction qui prépare les tampons d'un lot de décisions.
+ * @param lot de type tLotPolitique, Sortie : les tampons
+ * @param modele de type tModele, Entrée : la politique, pour la largeur de ses couches
+ * @param capacite de type int, Entrée : le nombre maximal de serpents d'un lot
+ * @return false si la mémoire manque
+ */
+bool initLotPolitique(tLotPolitique *lot, const tModele *modele, int capacite)
+{
+	lot->largeur = 0;
+	for (int l = 0; l < modele->nbCouches; l++)
+	{
+		lot->largeur = (modele->couches[l].pasSorties > lot->largeur) ? modele->couches[l].pasSorties : lot->largeur;
+	}
+	lot->capacite = capacite;
+	lot->caracteristiques = malloc((size_t)capacite * ENTREES_ALIGNEES_POLITIQUE * sizeof(float));
+	for (int i = 0; i < 2; i++)
+	{
+		lot->activations[i] = malloc((size_t)capacite * lot->largeur * sizeof(float));
+	}
+	return lot->caracteristiques != NULL && lot->activations[0] != NULL && lot->activations[1] != NULL;
+}
+
+/**
+ * @brief Procédure qui libère les tampons d'un lot de décisions.
+ * @param lot de type tLotPolitique, Entrée/Sortie : les tampons
+ */
+void libererLotPolitique(tLotPolitique *lot)
+{
+	free(lot->caracteristiques);
+	free(lot->activations[0]);
+	free(lot->activations[1]);
+}
+
+/**
+ * @brief Procédure qui décide les deux serpents de tout un lot de parties en un seul
+ * passage du modèle : une ligne de caractéristiques par serpent, puis un produit
+ * matriciel par couche pour tout le lot.
+ * @param modele de type tModele, Entrée : la politique
+ * @param parties de type tEtatJeu* tableau, Entrée : les parties
+ * @param nbParties de type int, Entrée : leur nombre (2 x nbParties <= capacité du lot)
+ * @param lot de type tLotPolitique, Entrée/Sortie : les tampons
+ * @param directions de type char tableau, Sortie : la direction des deux serpents de
+ * chaque partie, 0 pour laisser décider l'IA habituelle si tout est bloqué
+ */
+void deciderLotPolitique(const tModele *modele, tEtatJeu *const parties[], int nbParties, tLotPolitique *lot, char directions[][2])
+{
+	for (int p = 0; p < nbParties; p++)
+	{
+		for (int s = 0; s < 2; s++)
+		{
+			caracteristiquesPolitique(parties[p], s + 1, &lot->caracteristiques[(size_t)(2 * p + s) * ENTREES_ALIGNEES_POLITIQUE]);
+		}
+	}
+	const float *scores = evaluerModele(modele, lot->caracteristiques, lot->activations, 2 * nbParties);
+	int pasScores = modele->couches[modele->nbCouches - 1].pasSorties;
+	for (int i = 0; i < 2 * nbParties; i++)
+	{
+		int meilleure = choisirDirectionPolitique(&scores[(size_t)i * pasScores], &lot->caracteristiques[(size_t)i * ENTREES_ALIGNEES_POLITIQUE]);
+		directions[i / 2][i % 2] = (meilleure < 0) ? 0 : LES_DIRECTIONS[meilleure];
+	}
+}
+
+/**
+ * @brief Fonction qui prépare une couche vide, poids réels à zéro.
+ * @param couche de type tCouche, Sortie : la couche
+ * @param entrees de type int, Entrée : le nombre d'entrées
+ * @param sorties de type int, Entrée : le nombre de neurones
+ * @return false si la mémoire manque
+ */
+bool initCouche(tCouche *couche, int entrees, int sorties)
+{
+	couche->entrees = entrees;
+	couche->sorties = sorties;
+	couche->pasEntrees = (entrees + PAS_POLITIQUE - 1) / PAS_POLITIQUE * PAS_POLITIQUE;
+	couche->pasSorties = (sorties + PAS_POLITIQUE - 1) / PAS_POLITIQUE * PAS_POLITIQUE;
+	couche->octets = false;
+	couche->poids = calloc((size_t)couche->pasSorties * couche->pasEntrees, sizeof(float));
+	couche->poidsOctets = NULL;
+	couche->echelles = NULL;
+	couche->biais = calloc(couche->pasSorties, sizeof(float));
+	return couche->poids != NULL && couche->biais != NULL;
+}
+
+/**
+ * @brief Procédure qui passe les poids d'une couche en octets : l'échelle de chaque neurone
+ * envoie son plus grand poids sur 127.
+ * @param couche de type tCouche, Entrée/Sortie : la couche, aux poids réels
+ * @return false si la mémoire manque
+ */
+bool quantifierCouche(tCouche *couche)
+{
+	couche->poidsOctets = calloc((size_t)couche->pasSorties * couche->pasEntrees, sizeof(int8_t));
+	couche->echelles = calloc(couche->pasSorties, sizeof(float));
+	if (couche->poidsOctets == NULL || couche->echelles == NULL)
+	{
+		return false;
+	}
+	for (int n = 0; n < couche->sorties; n++)
+	{
+		const float *w = &couche->poids[(size_t)n * couche->pasEntrees];
+		float plusGrand = 0;
+		for (int k = 0; k < couche->entrees; k++)
+		{
+			plusGrand = (fabsf(w[k]) > plusGrand) ? fabsf(w[k]) : plusGrand;
+		}
+		couche->echelles[n] = (plusGrand > 0) ? plusGrand / 127 : 1;
+		for (int k = 0; k < couche->entrees; k++)
+		{
+			couche->poidsOctets[(size_t)n * couche->pasEntrees + k] = (int8_t)lrintf(w[k] / couche->echelles[n]);
+		}
+	}
+	free(couche->poids);
+	couche->poids = NULL;
+	couche->octets = true;
+	return true;
+}
+
+/**
+ * @brief Procédure qui libère les couches d'un modèle.
+ * @param modele de type tModele, Entrée/Sortie : le modèle
+ */
+void libererModele(tModele *modele)
+{
+	for (int l = 0; l < modele->nbCouches; l++)
+	{
+		free(modele->couches[l].poids);
+		free(modele->couches[l].poidsOctets);
+		free(modele->couches[l].echelles);
+		free(modele->couches[l].biais);
+	}
+	modele->nbCouches = 0;
+}
+
+/**
+ * @brief Fonction qui charge une politique depuis un fichier de poids (voir politique.h).
+ * @param chemin de type char tableau, Entrée : le fichier
+ * @param modele de type tModele, Sortie : la politique
+ * @return false si le fichier est illisible ou ne décrit pas une politique du jeu
+ */
+bool chargerModele(const char *chemin, tModele *modele)
+{
+	FILE *fichier = fopen(chemin, "rb");
+	tEnteteModele entete;
+	modele->nbCouches = 0;
+	if (fichier == NULL)
+	{
+		perror(chemin);
+		return false;
+	}
+	bool valide = fread(&entete, sizeof(entete), 1, fichier) == 1 && entete.magique == POLITIQUE_MAGIQUE
+			   && entete.nbCouches >= 1 && entete.nbCouches <= MAX_COUCHES_POLITIQUE;
+	int entrees = POLITIQUE_ENTREES;
+	for (int l = 0; valide && l < entete.nbCouches; l++)
+	{
+		tEnteteCouche enteteCouche;
+		tCouche *couche = &modele->couches[l];
+		valide = fread(&enteteCouche, sizeof(enteteCouche), 1, fichier) == 1 && enteteCouche.entrees == entrees
+			  && enteteCouche.sorties >= 1 && enteteCouche.sorties <= MAX_LARGEUR_POLITIQUE
+			  && (enteteCouche.type == COUCHE_REELS || enteteCouche.type == COUCHE_OCTETS);
+		if (!valide)
+		{
+			break;
+		}
+		valide = initCouche(couche, enteteCouche.entrees, enteteCouche.sorties);
+		modele->nbCouches++;
+		if (valide && enteteCouche.type == COUCHE_OCTETS)
+		{
+			valide = quantifierCouche(couche)
+				  && fread(couche->echelles, sizeof(float), couche->sorties, fichier) == (size_t)couche->sorties;
+		}
+		// une ligne de poids par neurone, complétée par des zéros jusqu'à pasEntrees
+		for (int n = 0; valide && n < couche->sorties; n++)
+		{
+			valide = couche->octets
+				   ? fread(&couche->poidsOctets[(size_t)n * couche->pasEntrees], sizeof(int8_t), couche->entrees, fichier) == (size_t)couche->entrees
+				   : fread(&couche->poids[(size_t)n * couche->pasEntrees], sizeof(float), couche->entrees, fichier) == (size_t)couche->entrees;
+		}
+		valide = valide && fread(couche->biais, sizeof(float), couche->sorties, fichier) == (size_t)couche->sorties;
+		entrees = enteteCouche.sorties;
+	}
+	fclose(fichier);
+	if (!valide || entrees != POLITIQUE_SORTIES)
+	{
+		fprintf(stderr, "%s n'est pas une politique du jeu\n", chemin);
+		libererModele(modele);
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Fonction qui écrit une politique dans un fichier de poids (voir politique.h).
+ * @param chemin de type char tableau, Entrée : le fichier
+ * @param modele de type tModele, Entrée : la politique
+ * @return false si le fichier n'a pas pu être écrit
+ */
+bool ecrireModele(const char *chemin, const tModele *modele)
+{
+	FILE *fichier = fopen(chemin, "wb");
+	if (fichier == NULL)
+	{
+		perror(chemin);
+		return false;
+	}
+	tEnteteModele entete = {POLITIQUE_MAGIQUE, modele->nbCouches, 0};
+	bool ecrit = fwrite(&entete, sizeof(entete), 1, fichier) == 1;
+	for (int l = 0; ecrit && l < modele->nbCouches; l++)
+	{
+		const tCouche *couche = &modele->couches[l];
+		tEnteteCouche enteteCouche = {couche->entrees, couche->sorties, couche->octets ? COUCHE_OCTETS : COUCHE_REELS, {0}};
+		ecrit = fwrite(&enteteCouche, sizeof(enteteCouche), 1, fichier) == 1;
+		if (ecrit && couche->octets)
+		{
+			ecrit = fwrite(couche->echelles, sizeof(float), couche->sorties, fichier) == (size_t)couche->sorties;
+		}
+		for (int n = 0; ecrit && n < couche->sorties; n++)
+		{
+			ecrit = couche->octets
+				  ? fwrite(&couche->poidsOctets[(size_t)n * couche->pasEntrees], sizeof(int8_t), couche->entrees, fichier) == (size_t)couche->entrees
+				  : fwrite(&couche->poids[(size_t)n * couche->pasEntrees], sizeof(float), couche->entrees, fichier) == (size_t)couche->entrees;
+		}
+		ecrit = ecrit && fwrite(couche->biais, sizeof(float), couche->sorties, fichier) == (size_t)couche->sorties;
+	}
+	ecrit = (fclose(fichier) == 0) && ecrit;
+	if (!ecrit)
+	{
+		perror(chemin);
+	}
+	return ecrit;
+}
+
+/**
+ * @brief Procédure qui joue des parties sans affichage, les serpents jouant en même temps,
+ * et compare l'IA habituelle, le mode --jps et la politique sur les mêmes graines. Chaque
+ * tour de la politique est décidé deux fois : une décision à la fois, puis tout le lot en
+ * un passage, pour mesurer les deux chemins et vérifier qu'ils s'accordent.
+ * @param contexte de type tContexte, Entrée : la carte et les portails des parties
+ * @param modele de type tModele, Entrée : la politique, jouée dans une copie du contexte
+ * @param nbParties de type int, Entrée : le nombre de parties par mode
+ * @param graine de type uint64_t, Entrée : la graine de la première partie
+ * @return false si la mémoire manque
+ */
+bool comparerPolitique(const tContexte *contexte, const tModele *modele, int nbParties, uint64_t graine)
+{
+	tContexte *contexteModele = malloc(sizeof(tContexte));
+	tEtatJeu *parties = malloc(nbParties * sizeof(tEtatJeu));
+	tEtatJeu **enCours = malloc(nbParties * sizeof(tEtatJeu *));
+	char (*directions)[2] = malloc(nbParties * sizeof(*directions));
+	tLotPolitique lot;
+	bool pret = contexteModele != NULL && parties != NULL && enCours != NULL && directions != NULL && initLotPolitique(&lot, modele, 2 * nbParties);
+	if (!pret)
+	{
+		fprintf(stderr, "Mémoire insuffisante pour %d parties\n", nbParties);
+		free(contexteModele);
+		free(parties);
+		free(enCours);
+		free(directions);
+		return false;
+	}
+	*contexteModele = *contexte;
+	contexteModele->modele = modele;
+	const char *noms[3] = {"IA habituelle", "mode --jps", "politique"};
+	const int strategies[3] = {STRATEGIE_VERSION4, STRATEGIE_JPS, STRATEGIE_POLITIQUE};
+	long long dureeUnique = 0, dureeLot = 0, decisions = 0, desaccords = 0;
+	for (int mode = 0; mode < 3; mode++)
+	{
+		for (int p = 0; p < nbParties; p++)
+		{
+			initEtatJeu(&parties[p], contexteModele, graine + p, true, false, 1);
+			parties[p].serpents[0].strategie = parties[p].serpents[1].strategie = strategies[mode];
+			enCours[p] = &parties[p];
+		}
+		int nbEnCours = nbParties;
+		while (nbEnCours > 0)
+		{
+			for (int p = 0; p < nbEnCours; p++)
+			{
+				directions[p][0] = directions[p][1] = 0;
+			}
+			if (mode == 2)
+			{
+				long long debut = maintenantNano();
+				deciderLotPolitique(modele, enCours, nbEnCours, &lot, directions);
+				dureeLot += maintenantNano() - debut;
+				debut = maintenantNano();
+				for (int p = 0; p < nbEnCours; p++)
+				{
+					for (int s = 0; s < 2; s++)
+					{
+						char unique = 0;
+						directionPolitique(enCours[p], s + 1, &unique);
+						desaccords += (unique != directions[p][s]);
+					}
+				}
+				dureeUnique += maintenantNano() - debut;
+				decisions += 2 * nbEnCours;
+			}
+			int restantes = 0;
+			for (int p = 0; p < nbEnCours; p++)
+			{
+				jouerTourSimultane(enCours[p], directions[p]);
+				if (!partieFinie(enCours[p]) && enCours[p]->serpents[0].deplacements < LIMITE_TOURS_POLITIQUE)
+				{
+					enCours[restantes++] = enCours[p];
+				}
+			}
+			nbEnCours = restantes;
+		}
+		long long deplacements = 0, pommes = 0, collisions = 0;
+		for (int p = 0; p < nbParties; p++)
+		{
+			for (int s = 0; s < 2; s++)
+			{
+				deplacements += parties[p].serpents[s].deplacements;
+				pommes += parties[p].serpents[s].nbPommesMangees;
+				collisions += parties[p].serpents[s].collision;
+			}
+		}
+		printf("%-14s: %.1f déplacements par pomme, %.2f pommes et %.2f collisions par partie\n", noms[mode],
+			   pommes > 0 ? (double)deplacements / pommes : 0.0, (double)pommes / nbParties, (double)collisions / nbParties);
+	}
+	printf("Décision de la politique : %.2f µs une à la fois, %.2f µs par serpent en lot, %lld désaccords sur %lld\n",
+		   dureeUnique / 1e3 / decisions, dureeLot / 1e3 / decisions, desaccords, decisions);
+	libererLotPolitique(&lot);
+	free(contexteModele);
+	free(parties);
+	free(enCours);
+	free(directions);
+	return true;
+}
+
+/**
+ * @brief Fonction qui évalue une politique enregistrée contre l'IA habituelle et le mode --jps.
+ * @param contexte de type tContexte, Entrée : la carte et les portails des parties
+ * @param chemin de type char tableau, Entrée : le fichier de poids
+ * @param nbParties de type int, Entrée : le nombre de parties par mode
+ * @param graine de type uint64_t, Entrée : la graine de la première partie
+ * @return EXIT_SUCCESS, ou EXIT_FAILURE si la politique n'a pas pu être chargée
+ */
+int lancerEvaluationPolitique(const tContexte *contexte, const char *chemin, int nbParties, uint64_t graine)
+{
+	tModele modele;
+	if (!chargerModele(chemin, &modele))
+	{
+		return EXIT_FAILURE;
+	}
+	bool compare = comparerPolitique(contexte, &modele, nbParties, graine);
+	libererModele(&modele);
+	return compare ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Fonction qui apprend une politique par imitation du mode --jps : les parties du
+ * mode --jps donnent, pour chaque serpent et chaque tour, ses caractéristiques et le coup
+ * joué ; le perceptron est entraîné par descente de gradient avec inertie sur des lots
+ * d'exemples mélangés (entropie croisée), ses passages avant utilisant les mêmes noyaux
+ * que les décisions. La politique est ensuite comparée sur d'autres graines.
+ * @param contexte de type tContexte, Entrée : la carte et les portails des parties
+ * @param chemin de type char tableau, Entrée : le fichier de poids à écrire
+ * @param nbParties de type int, Entrée : le nombre de parties d'exemples (et de comparaison)
+ * @param graine de type uint64_t, Entrée : la graine de la première partie
+ * @param octets de type bool, Entrée : true pour écrire des poids en octets
+ * @return EXIT_SUCCESS, ou EXIT_FAILURE si la mémoire manque ou si le fichier n'a pas pu être écrit
+ */
+int lancerEntrainementPolitique(const tContexte *contexte, const char *chemin, int nbParties, uint64_t graine, bool octets)
+{
+	// exemples du mode --jps, les deux serpents jouant en même temps
+	size_t capacite = 0, nbExemples = 0;
+	float *exemples = NULL;
+	uint8_t *etiquettes = NULL;
+	tEtatJeu *etat = malloc(sizeof(tEtatJeu));
+	const char directionsIA[2] = {0, 0};
+	bool pret = (etat != NULL);
+	for (int p = 0; pret && p < nbParties; p++)
+	{
+		initEtatJeu(etat, contexte, graine + p, true, false, 1);
+		etat->serpents[0].strategie = etat->serpents[1].strategie = STRATEGIE_JPS;
+		while (pret && !partieFinie(etat) && etat->serpents[0].deplacements < LIMITE_TOURS_POLITIQUE)
+		{
+			if (nbExemples + 2 > capacite)
+			{
+				capacite = (capacite == 0) ? 4096 : 2 * capacite;
+				float *plusExemples = realloc(exemples, capacite * ENTREES_ALIGNEES_POLITIQUE * sizeof(float));
+				exemples = (plusExemples != NULL) ? plusExemples : exemples;
+				uint8_t *plusEtiquettes = realloc(etiquettes, capacite);
+				etiquettes = (plusEtiquettes != NULL) ? plusEtiquettes : etiquettes;
+				pret = (plusExemples != NULL && plusEtiquettes != NULL);
+				if (!pret)
+				{
+					break;
+				}
+			}
+			for (int s = 0; s < 2; s++)
+			{
+				caracteristiquesPolitique(etat, s + 1, &exemples[(nbExemples + s) * ENTREES_ALIGNEES_POLITIQUE]);
+			}
+			jouerTourSimultane(etat, directionsIA);
+			for (int s = 0; s < 2; s++)
+			{
+				etiquettes[nbExemples + s] = indiceDirection(etat->serpents[s].direction);
+			}
+			nbExemples += 2;
+		}
+	}
+	free(etat);
+
+	// perceptron initialisé au hasard (He), avec une vitesse et un gradient par poids
+	const int largeurs[] = {POLITIQUE_ENTREES, NEURONES_CACHES_POLITIQUE, NEURONES_CACHES_POLITIQUE, POLITIQUE_SORTIES};
+	const int nbCouches = (int)(sizeof(largeurs) / sizeof(largeurs[0])) - 1;
+	tModele modele = {0}, vitesses = {0}, gradients = {0};
+	float *activations[MAX_COUCHES_POLITIQUE + 1] = {NULL};
+	float *erreurs[2] = {NULL, NULL};
+	int *ordre = malloc(nbExemples * sizeof(int));
+	tGenerateur generateur;
+	initGenerateur(&generateur, graine);
+	pret = pret && ordre != NULL;
+	for (int l = 0; pret && l < nbCouches; l++)
+	{
+		modele.nbCouches = vitesses.nbCouches = gradients.nbCouches = l + 1;
+		pret = initCouche(&modele.couches[l], largeurs[l], largeurs[l + 1]) && initCouche(&vitesses.couches[l], largeurs[l], largeurs[l + 1])
+			&& initCouche(&gradients.couches[l], largeurs[l], largeurs[l + 1]);
+		if (pret)
+		{
+			tCouche *couche = &modele.couches[l];
+			float borne = sqrtf(6.0f / couche->entrees);
+			for (int n = 0; n < couche->sorties; n++)
+			{
+				for (int k = 0; k < couche->entrees; k++)
+				{
+					couche->poids[(size_t)n * couche->pasEntrees + k] = borne * (2.0f * tirerAleatoire(&generateur) / UINT32_MAX - 1.0f);
+				}
+			}
+		}
+	}
+	for (int l = 0; pret && l <= nbCouches; l++)
+	{
+		int pas = (l == 0) ? ENTREES_ALIGNEES_POLITIQUE : modele.couches[l - 1].pasSorties;
+		activations[l] = malloc((size_t)LOT_ENTRAINEMENT * pas * sizeof(float));
+		pret = (activations[l] != NULL);
+	}
+	for (int i = 0; pret && i < 2; i++)
+	{
+		erreurs[i] = malloc((size_t)LOT_ENTRAINEMENT * MAX_LARGEUR_POLITIQUE * sizeof(float));
+		pret = (erreurs[i] != NULL);
+	}
+	if (!pret || nbExemples == 0)
+	{
+		fprintf(stderr, "Mémoire insuffisante pour l'entraînement\n");
+	}
+
+	double perte = 0;
+	long long justes = 0;
+	for (size_t i = 0; pret && i < nbExemples; i++)
+	{
+		ordre[i] = (int)i;
+	}
+	for (int epoque = 0; pret && nbExemples > 0 && epoque < EPOQUES_POLITIQUE; epoque++)
+	{
+		for (size_t i = nbExemples - 1; i > 0; i--)
+		{
+			size_t j = tirerBorne(&generateur, (uint32_t)(i + 1));
+			int echange = ordre[i];
+			ordre[i] = ordre[j];
+			ordre[j] = echange;
+		}
+		perte = 0;
+		justes = 0;
+		for (size_t debut = 0; debut < nbExemples; debut += LOT_ENTRAINEMENT)
+		{
+			int nbLignes = (nbExemples - debut < LOT_ENTRAINEMENT) ? (int)(nbExemples - debut) : LOT_ENTRAINEMENT;
+			for (int b = 0; b < nbLignes; b++)
+			{
+				memcpy(&activations[0][(size_t)b * ENTREES_ALIGNEES_POLITIQUE], &exemples[(size_t)ordre[debut + b] * ENTREES_ALIGNEES_POLITIQUE],
+					   ENTREES_ALIGNEES_POLITIQUE * sizeof(float));
+			}
+			// passage avant, en gardant les activations de chaque couche
+			for (int l = 0; l < nbCouches; l++)
+			{
+				const tCouche *couche = &modele.couches[l];
+				appliquerCouche(couche, activations[l], nbLignes, activations[l + 1]);
+				for (size_t i = 0; l < nbCouches - 1 && i < (size_t)nbLignes * couche->pasSorties; i++)
+				{
+					activations[l + 1][i] = (activations[l + 1][i] > 0) ? activations[l + 1][i] : 0;
+				}
+			}
+			// softmax et erreur de la sortie : probabilités moins le coup joué
+			int pasSortie = modele.couches[nbCouches - 1].pasSorties;
+			float *erreur = erreurs[0];
+			memset(erreur, 0, (size_t)nbLignes * pasSortie * sizeof(float));
+			for (int b = 0; b < nbLignes; b++)
+			{
+				const float *scores = &activations[nbCouches][(size_t)b * pasSortie];
+				int attendue = etiquettes[ordre[debut + b]];
+				int meilleure = 0;
+				float somme = 0;
+				for (int d = 1; d < POLITIQUE_SORTIES; d++)
+				{
+					meilleure = (scores[d] > scores[meilleure]) ? d : meilleure;
+				}
+				for (int d = 0; d < POLITIQUE_SORTIES; d++)
+				{
+					erreur[b * pasSortie + d] = expf(scores[d] - scores[meilleure]);
+					somme += erreur[b * pasSortie + d];
+				}
+				for (int d = 0; d < POLITIQUE_SORTIES; d++)
+				{
+					erreur[b * pasSortie + d] = (erreur[b * pasSortie + d] / somme - (d == attendue)) / nbLignes;
+				}
+				perte -= logf(expf(scores[attendue] - scores[meilleure]) / somme);
+				justes += (meilleure == attendue);
+			}
+			// rétropropagation : l'erreur de l'entrée d'une couche est calculée avec ses
+			// poids avant leur mise à jour
+			for (int l = nbCouches - 1; l >= 0; l--)
+			{
+				tCouche *couche = &modele.couches[l], *gradient = &gradients.couches[l], *vitesse = &vitesses.couches[l];
+				const float *x = activations[l];
+				float *erreurEntree = erreurs[1];
+				if (l > 0)
+				{
+					memset(erreurEntree, 0, (size_t)nbLignes * couche->pasEntrees * sizeof(float));
+					for (int b = 0; b < nbLignes; b++)
+					{
+						for (int n = 0; n < couche->sorties; n++)
+						{
+							float e = erreur[b * couche->pasSorties + n];
+							for (int k = 0; k < couche->entrees; k++)
+							{
+								erreurEntree[b * couche->pasEntrees + k] += e * couche->poids[(size_t)n * couche->pasEntrees + k];
+							}
+						}
+						for (int k = 0; k < couche->entrees; k++)
+						{
+							erreurEntree[b * couche->pasEntrees + k] *= (x[b * couche->pasEntrees + k] > 0);
+						}
+					}
+				}
+				memset(gradient->poids, 0, (size_t)couche->pasSorties * couche->pasEntrees * sizeof(float));
+				memset(gradient->biais, 0, couche->pasSorties * sizeof(float));
+				for (int b = 0; b < nbLignes; b++)
+				{
+					for (int n = 0; n < couche->sorties; n++)
+					{
+						float e = erreur[b * couche->pasSorties + n];
+						gradient->biais[n] += e;
+						for (int k = 0; k < couche->entrees; k++)
+						{
+							gradient->poids[(size_t)n * couche->pasEntrees + k] += e * x[b * couche->pasEntrees + k];
+						}
+					}
+				}
+				for (size_t i = 0; i < (size_t)couche->pasSorties * couche->pasEntrees; i++)
+				{
+					vitesse->poids[i] = INERTIE_APPRENTISSAGE * vitesse->poids[i] - TAUX_APPRENTISSAGE * gradient->poids[i];
+					couche->poids[i] += vitesse->poids[i];
+				}
+				for (int n = 0; n < couche->pasSorties; n++)
+				{
+					vitesse->biais[n] = INERTIE_APPRENTISSAGE * vitesse->biais[n] - TAUX_APPRENTISSAGE * gradient->biais[n];
+					couche->biais[n] += vitesse->biais[n];
+				}
+				erreurs[1] = erreur;
+				erreurs[0] = erreurEntree;
+				erreur = erreurEntree;
+			}
+		}
+	}
+
+	bool ecrit = false;
+	if (pret && nbExemples > 0)
+	{
+		printf("%zu exemples du mode --jps, %.1f %% des coups imités après %d époques (entropie croisée %.3f)\n", nbExemples,
+			   100.0 * justes / nbExemples, EPOQUES_POLITIQUE, perte / nbExemples);
+		for (int l = 0; octets && pret && l < nbCouches; l++)
+		{
+			pret = quantifierCouche(&modele.couches[l]);
+		}
+		ecrit = pret && ecrireModele(chemin, &modele);
+		if (ecrit)
+		{
+			printf("Politique écrite dans %s (poids en %s)\n", chemin, octets ? "octets" : "réels");
+			ecrit = comparerPolitique(contexte, &modele, nbParties, graine + nbParties);
+		}
+	}
+	libererModele(&modele);
+	libererModele(&vitesses);
+	libererModele(&gradients);
+	for (int l = 0; l <= nbCouches; l++)
+	{
+		free(activations[l]);
+	}
+	free(erreurs[0]);
+	free(erreurs[1]);
+	free(ordre);
+	free(exemples);
+	free(etiquettes);
+	return ecrit ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file reseau.h
+ * @brief Politique neuronale du jeu snake : décisions par lots, entraînement par imitation et évaluation
+ * @author Noah Le Goff, Sacha Mace
+ *
+ * Le modèle est un perceptron à couches denses dont le produit matriciel travaille
+ * par blocs, en réels ou en octets, avec un noyau AVX2 choisi à l'exécution
+ * (appliquerCouche). Le format du fichier de poids est décrit par politique.h
+ * (version4 --politique, --entrainer-politique, --evaluer-politique).
+ */
+
+#ifndef RESEAU_H
+#define RESEAU_H
+
+#include "jeu.h"
+#include "politique.h"
+
+// politique neuronale : lignes de poids et d'activations complétées à un multiple de
+// PAS_POLITIQUE réels, blocs d'entrées et de neurones du produit matriciel (un bloc de
+// poids réels tient dans le cache de premier niveau)
+#define PAS_POLITIQUE 8
+#define ENTREES_ALIGNEES_POLITIQUE ((POLITIQUE_ENTREES + PAS_POLITIQUE - 1) / PAS_POLITIQUE * PAS_POLITIQUE)
+#define BLOC_ENTREES_POLITIQUE 128
+#define BLOC_NEURONES_POLITIQUE 32
+// entraînement par imitation : neurones des deux couches cachées, époques, exemples par
+// lot, pas et inertie de la descente de gradient, et tours au-delà desquels une partie
+// d'exemples ou de comparaison est arrêtée
+#define NEURONES_CACHES_POLITIQUE 32
+#define EPOQUES_POLITIQUE 10
+#define LOT_ENTRAINEMENT 64
+#define TAUX_APPRENTISSAGE 0.01f
+#define INERTIE_APPRENTISSAGE 0.9f
+#define LIMITE_TOURS_POLITIQUE 5000
+
+// couche d'une politique neuronale : une ligne de poids par neurone, complétée par des
+// zéros jusqu'à pasEntrees, et des neurones nuls jusqu'à pasSorties, pour que les noyaux
+// ne lisent que des blocs entiers
+typedef struct
+{
+	int entrees, sorties;
+	int pasEntrees, pasSorties;			// entrees et sorties arrondies au multiple de PAS_POLITIQUE
+	bool octets;						// poids en octets, avec une échelle par neurone
+	float *poids;						// pasSorties x pasEntrees, poids réels
+	int8_t *poidsOctets;				// pasSorties x pasEntrees, poids en octets
+	float *echelles;					// pasSorties
+	float *biais;						// pasSorties
+} tCouche;
+
+// politique neuronale : ses couches denses, de la première à celle des scores
+struct tModele
+{
+	int nbCouches;
+	tCouche couches[MAX_COUCHES_POLITIQUE];
+};
+
+// tampons d'un lot de décisions de la politique, une ligne par serpent
+typedef struct
+{
+	int capacite;						// nombre maximal de serpents
+	int largeur;						// plus longue ligne d'activations
+	float *caracteristiques;			// capacite x ENTREES_ALIGNEES_POLITIQUE
+	float *activations[2];				// capacite x largeur, une couche sur deux
+} tLotPolitique;
+
+void caracteristiquesPolitique(const tEtatJeu *etat, int numero, float entree[]);
+void initialiserSorties(const tCouche *couche, int nbLignes, float *sorties);
+void appliquerCoucheScalaire(const tCouche *couche, const float *entrees, int nbLignes, float *sorties);
+float *evaluerModele(const tModele *modele, const float *caracteristiques, float *tampons[2], int nbLignes);
+int choisirDirectionPolitique(const float scores[], const float entree[]);
+bool directionPolitique(const tEtatJeu *etat, int numero, char *direction);
+bool initLotPolitique(tLotPolitique *lot, const tModele *modele, int capacite);
+void libererLotPolitique(tLotPolitique *lot);
+void deciderLotPolitique(const tModele *modele, tEtatJeu *const parties[], int nbParties, tLotPolitique *lot, char directions[][2]);
+bool initCouche(tCouche *couche, int entrees, int sorties);
+bool quantifierCouche(tCouche *couche);
+void libererModele(tModele *modele);
+bool chargerModele(const char *chemin, tModele *modele);
+bool ecrireModele(const char *chemin, const tModele *modele);
+bool comparerPolitique(const tContexte *contexte, const tModele *modele, int nbParties, uint64_t graine);
+int lancerEvaluationPolitique(const tContexte *contexte, const char *chemin, int nbParties, uint64_t graine);
+int lancerEntrainementPolitique(const tContexte *contexte, const char *chemin, int nbParties, uint64_t graine, bool octets);
+#ifdef NOYAU_X86
+__attribute__((target("avx2,fma"))) float sommerRegistre(__m256 v);
+__attribute__((target("avx2,fma"))) void appliquerCoucheAVX2(const tCouche *couche, const float *entrees, int nbLignes, float *sorties);
+#endif
+
+// produit matriciel d'une couche de la politique, choisi à l'exécution par initNoyauCollision
+extern void (*appliquerCouche)(const tCouche *couche, const float *entrees, int nbLignes, float *sorties);
+
+#endif
@@ -0,0 +1,394 @@
+/**
+ * @file serveur.c
+ * @brief Mode serveur du jeu snake : lots de parties sans affichage servis sur une socket Unix (version4 --serveur)
+ * @author Noah Le Goff, Sacha Mace
+ */
+
+/* Fichiers inclus */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+#include "serveur.h"
+
+/**
+ * @brief Fonction qui sert des lots de parties sur une socket du domaine Unix, avec une
+ * seule boucle epoll pour toutes les connexions. Rien n'est affiché pendant les parties.
+ * Le serveur s'arrête sur SIGINT ou SIGTERM et retire alors la socket.
+ * @param contexte de type tContexte, Entrée : la carte et les portails des parties
+ * @param chemin de type char tableau, Entrée : le chemin de la socket
+ * @return EXIT_SUCCESS après un arrêt demandé, EXIT_FAILURE si la socket n'a pas pu être ouverte
+ */
+int lancerServeur(const tContexte *contexte, const char *chemin)
+{
+	struct sockaddr_un adresse = {0};
+	adresse.sun_family = AF_UNIX;
+	if (strlen(chemin) >= sizeof(adresse.sun_path))
+	{
+		fprintf(stderr, "Chemin de socket trop long : %s\n", chemin);
+		return EXIT_FAILURE;
+	}
+	strcpy(adresse.sun_path, chemin);
+
+	int ecoute = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	unlink(chemin);
+	if (ecoute < 0 || bind(ecoute, (struct sockaddr *)&adresse, sizeof(adresse)) < 0 || listen(ecoute, SOMAXCONN) < 0)
+	{
+		perror("socket");
+		return EXIT_FAILURE;
+	}
+	int epoll = epoll_create1(EPOLL_CLOEXEC);
+	struct epoll_event evenement = {.events = EPOLLIN, .data.ptr = NULL}; // NULL : la socket d'écoute
+	epoll_ctl(epoll, EPOLL_CTL_ADD, ecoute, &evenement);
+
+	signal(SIGINT, demanderArret);
+	signal(SIGTERM, demanderArret);
+	signal(SIGPIPE, SIG_IGN); // un client parti est vu comme une erreur d'écriture
+	printf("Serveur en écoute sur %s\n", chemin);
+	fflush(stdout);
+
+	struct epoll_event prets[64];
+	while (!arretDemande)
+	{
+		int nbPrets = epoll_wait(epoll, prets, 64, -1);
+		if (nbPrets < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			perror("epoll_wait");
+			break;
+		}
+		for (int i = 0; i < nbPrets; i++)
+		{
+			tConnexion *connexion = prets[i].data.ptr;
+			if (connexion == NULL)
+			{
+				// nouveaux clients
+				int descripteur;
+				while ((descripteur = accept(ecoute, NULL, NULL)) >= 0)
+				{
+					fcntl(descripteur, F_SETFL, fcntl(descripteur, F_GETFL) | O_NONBLOCK);
+					connexion = calloc(1, sizeof(tConnexion));
+					if (connexion == NULL)
+					{
+						// la socket neuve est vide : l'en-tête d'erreur part sans tampon
+						tEntete erreur = {MESSAGE_ERREUR, 0, 0};
+						fprintf(stderr, "Mémoire insuffisante pour un nouveau client\n");
+						if (write(descripteur, &erreur, sizeof(erreur)) < 0)
+						{
+							// le client est déjà parti
+						}
+						close(descripteur);
+						continue;
+					}
+					connexion->descripteur = descripteur;
+					connexion->contexte = contexte;
+					evenement = (struct epoll_event){.events = EPOLLIN | EPOLLRDHUP, .data.ptr = connexion};
+					if (epoll_ctl(epoll, EPOLL_CTL_ADD, descripteur, &evenement) < 0)
+					{
+						perror("epoll_ctl");
+						fermerConnexion(connexion);
+					}
+				}
+				continue;
+			}
+
+			bool ouverte = !connexion->aFermer && (prets[i].events & EPOLLERR) == 0;
+			if (ouverte && (prets[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)))
+			{
+				ouverte = lireConnexion(connexion);
+			}
+			if (connexion->tailleSortie > 0)
+			{
+				// envoie les réponses même si le client a fermé son côté d'écriture
+				ouverte = viderSortie(connexion) && ouverte;
+			}
+			// une connexion refusée ou finie n'est plus lue : elle n'attend que de vider sa sortie
+			connexion->aFermer = !ouverte;
+			if (!ouverte && connexion->tailleSortie == 0)
+			{
+				epoll_ctl(epoll, EPOLL_CTL_DEL, connexion->descripteur, NULL);
+				fermerConnexion(connexion);
+				continue;
+			}
+			// n'attend EPOLLOUT que tant que des réponses restent à envoyer
+			bool attente = connexion->tailleSortie > 0;
+			if (attente != connexion->attenteEcriture)
+			{
+				connexion->attenteEcriture = attente;
+				evenement = (struct epoll_event){.events = (ouverte ? EPOLLIN | EPOLLRDHUP : 0) | (attente ? EPOLLOUT : 0), .data.ptr = connexion};
+				epoll_ctl(epoll, EPOLL_CTL_MOD, connexion->descripteur, &evenement);
+			}
+		}
+	}
+
+	close(epoll);
+	close(ecoute);
+	unlink(chemin);
+	return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Fonction qui lit ce que le client a envoyé, puis traite les messages complets.
+ * Le tampon d'entrée ne grandit pas au-delà de MEMOIRE_MAX_CONNEXION : la lecture
+ * s'arrête alors et reprend au prochain événement, une fois les messages traités.
+ * @param connexion de type tConnexion, Entrée/Sortie : la connexion
+ * @return false si la connexion doit être fermée (fin de flux, erreur, message invalide
+ * ou mémoire insuffisante)
+ */
+bool lireConnexion(tConnexion *connexion)
+{
+	bool ouverte = true;
+	while (true)
+	{
+		if (connexion->tailleEntree == connexion->capaciteEntree)
+		{
+			size_t capacite = connexion->capaciteEntree ? connexion->capaciteEntree * 2 : 4096;
+			if (memoireConnexion(connexion) + capacite - connexion->capaciteEntree > MEMOIRE_MAX_CONNEXION)
+			{
+				break;
+			}
+			unsigned char *entree = realloc(connexion->entree, capacite);
+			if (entree == NULL)
+			{
+				break;
+			}
+			connexion->entree = entree;
+			connexion->capaciteEntree = capacite;
+		}
+		ssize_t lus = read(connexion->descripteur, connexion->entree + connexion->tailleEntree, connexion->capaciteEntree - connexion->tailleEntree);
+		if (lus > 0)
+		{
+			connexion->tailleEntree += lus;
+		}
+		else
+		{
+			// 0 : le client a fini d'envoyer ; EAGAIN : plus rien à lire pour l'instant
+			ouverte = (lus < 0 && (errno == EAGAIN || errno == EWOULDBLOCK));
+			break;
+		}
+	}
+	bool valide = traiterMessages(connexion);
+	if (valide && connexion->tailleEntree == connexion->capaciteEntree)
+	{
+		// tampon plein sans un message complet, et qui n'a pas pu grandir
+		signalerErreur(connexion);
+		valide = false;
+	}
+	return valide && ouverte;
+}
+
+/**
+ * @brief Fonction qui donne la mémoire tenue par une connexion : ses parties et ses tampons.
+ * @param connexion de type tConnexion, Entrée : la connexion
+ * @return le nombre d'octets alloués pour la connexion
+ */
+size_t memoireConnexion(const tConnexion *connexion)
+{
+	return sizeof(tConnexion) + connexion->nbParties * sizeof(tEtatJeu) + connexion->capaciteEntree + connexion->capaciteSortie;
+}
+
+/**
+ * @brief Fonction qui traite les messages complets reçus et prépare les réponses.
+ * Un lot reçoit tous ses tours d'un coup : un message de directions fait avancer chaque
+ * partie d'un tour et produit un delta par partie.
+ * Un lot qui ferait dépasser MEMOIRE_MAX_CONNEXION, ou dont la mémoire manque, est
+ * refusé comme un message invalide ; la connexion n'a plus alors de lot.
+ * @param connexion de type tConnexion, Entrée/Sortie : la connexion
+ * @return false si un message est invalide ou refusé (MESSAGE_ERREUR est alors envoyé)
+ */
+bool traiterMessages(tConnexion *connexion)
+{
+	size_t lu = 0;
+	bool valide = true;
+	while (valide && connexion->tailleEntree - lu >= sizeof(tEntete))
+	{
+		tEntete entete;
+		memcpy(&entete, connexion->entree + lu, sizeof(entete));
+		size_t taille;
+		if (entete.type == MESSAGE_CREER && entete.nbParties >= 1 && entete.nbParties <= MAX_PARTIES_LOT)
+		{
+			taille = sizeof(entete) + sizeof(uint64_t);
+		}
+		else if (entete.type == MESSAGE_DIRECTIONS && entete.nbParties == connexion->nbParties && connexion->nbParties > 0)
+		{
+			taille = sizeof(entete) + 2 * (size_t)entete.nbParties;
+		}
+		else
+		{
+			valide = false;
+			break;
+		}
+		if (connexion->tailleEntree - lu < taille)
+		{
+			break; // message incomplet : attend la suite
+		}
+		const unsigned char *contenu = connexion->entree + lu + sizeof(entete);
+
+		if (entete.type == MESSAGE_CREER)
+		{
+			uint64_t graine;
+			memcpy(&graine, contenu, sizeof(graine));
+			free(connexion->parties);
+			connexion->parties = NULL;
+			connexion->nbParties = 0;
+			size_t tailleReponse = sizeof(tEntete) + entete.nbParties * sizeof(tEtatInitial);
+			if (memoireConnexion(connexion) + entete.nbParties * sizeof(tEtatJeu) + tailleReponse > MEMOIRE_MAX_CONNEXION)
+			{
+				valide = false;
+				break;
+			}
+			connexion->parties = malloc(entete.nbParties * sizeof(tEtatJeu));
+			unsigned char *place = (connexion->parties != NULL) ? reserverSortie(connexion, tailleReponse) : NULL;
+			if (place == NULL)
+			{
+				free(connexion->parties);
+				connexion->parties = NULL;
+				valide = false;
+				break;
+			}
+			connexion->nbParties = entete.nbParties;
+			tEntete reponse = {MESSAGE_ETATS, 0, entete.nbParties};
+			memcpy(place, &reponse, sizeof(reponse));
+			tEtatInitial *initiaux = (tEtatInitial *)(place + sizeof(reponse));
+			for (int p = 0; p < entete.nbParties; p++)
+			{
+				tEtatInitial initial;
+				initEtatJeu(&connexion->parties[p], connexion->contexte, graine + p, entete.options & OPTION_POMMES_PROCEDURALES, entete.options & OPTION_CROISSANCE, 1);
+				coderEtatInitial(&connexion->parties[p], &initial);
+				memcpy(&initiaux[p], &initial, sizeof(initial));
+			}
+		}
+		else
+		{
+			unsigned char *place = reserverSortie(connexion, sizeof(tEntete) + entete.nbParties * sizeof(tDelta));
+			if (place == NULL)
+			{
+				valide = false;
+				break;
+			}
+			tEntete reponse = {MESSAGE_DELTAS, 0, entete.nbParties};
+			memcpy(place, &reponse, sizeof(reponse));
+			unsigned char *deltas = place + sizeof(reponse);
+			for (int p = 0; p < entete.nbParties; p++)
+			{
+				tAvantTour avant;
+				tDelta delta;
+				noterAvantTour(&connexion->parties[p], &avant);
+				jouerTourSimultane(&connexion->parties[p], (const char *)contenu + 2 * p);
+				coderDelta(&connexion->parties[p], &avant, &delta);
+				memcpy(deltas + p * sizeof(tDelta), &delta, sizeof(delta));
+			}
+		}
+		lu += taille;
+	}
+
+	// garde le début d'un message incomplet pour la prochaine lecture
+	memmove(connexion->entree, connexion->entree + lu, connexion->tailleEntree - lu);
+	connexion->tailleEntree -= lu;
+	if (!valide)
+	{
+		signalerErreur(connexion);
+	}
+	return valide;
+}
+
+/**
+ * @brief Procédure qui ajoute MESSAGE_ERREUR aux réponses à envoyer. Si même cet en-tête
+ * ne trouve pas de place, la connexion sera fermée sans réponse.
+ * @param connexion de type tConnexion, Entrée/Sortie : la connexion
+ */
+void signalerErreur(tConnexion *connexion)
+{
+	tEntete erreur = {MESSAGE_ERREUR, 0, 0};
+	unsigned char *place = reserverSortie(connexion, sizeof(erreur));
+	if (place != NULL)
+	{
+		memcpy(place, &erreur, sizeof(erreur));
+	}
+}
+
+/**
+ * @brief Fonction qui réserve de la place à la fin du tampon de sortie.
+ * Un client qui ne lit pas ses réponses ne fait pas grandir le tampon au-delà de
+ * MEMOIRE_MAX_CONNEXION.
+ * @param connexion de type tConnexion, Entrée/Sortie : la connexion
+ * @param taille de type size_t, Entrée : le nombre d'octets à ajouter
+ * @return l'adresse où écrire les taille octets, NULL si la mémoire manque ou dépasserait
+ * MEMOIRE_MAX_CONNEXION
+ */
+unsigned char *reserverSortie(tConnexion *connexion, size_t taille)
+{
+	if (connexion->debutSortie > 0 && connexion->debutSortie == connexion->tailleSortie)
+	{
+		connexion->debutSortie = connexion->tailleSortie = 0;
+	}
+	if (connexion->tailleSortie + taille > connexion->capaciteSortie)
+	{
+		size_t capacite = connexion->capaciteSortie ? connexion->capaciteSortie : 4096;
+		while (connexion->tailleSortie + taille > capacite)
+		{
+			capacite *= 2;
+		}
+		if (memoireConnexion(connexion) + capacite - connexion->capaciteSortie > MEMOIRE_MAX_CONNEXION)
+		{
+			return NULL;
+		}
+		unsigned char *sortie = realloc(connexion->sortie, capacite);
+		if (sortie == NULL)
+		{
+			return NULL;
+		}
+		connexion->sortie = sortie;
+		connexion->capaciteSortie = capacite;
+	}
+	unsigned char *place = connexion->sortie + connexion->tailleSortie;
+	connexion->tailleSortie += taille;
+	return place;
+}
+
+/**
+ * @brief Fonction qui envoie autant de réponses que la socket en accepte.
+ * @param connexion de type tConnexion, Entrée/Sortie : la connexion
+ * @return false si l'envoi a échoué (client parti)
+ */
+bool viderSortie(tConnexion *connexion)
+{
+	while (connexion->debutSortie < connexion->tailleSortie)
+	{
+		ssize_t ecrits = write(connexion->descripteur, connexion->sortie + connexion->debutSortie, connexion->tailleSortie - connexion->debutSortie);
+		if (ecrits < 0)
+		{
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+			{
+				return true; // socket pleine : la suite partira sur EPOLLOUT
+			}
+			connexion->debutSortie = connexion->tailleSortie = 0;
+			return false;
+		}
+		connexion->debutSortie += ecrits;
+	}
+	connexion->debutSortie = connexion->tailleSortie = 0;
+	return true;
+}
+
+/**
+ * @brief Procédure qui ferme une connexion et libère ses parties.
+ * @param connexion de type tConnexion, Entrée : la connexion
+ */
+void fermerConnexion(tConnexion *connexion)
+{
+	close(connexion->descripteur);
+	free(connexion->entree);
+	free(connexion->sortie);
+	free(connexion->parties);
+	free(connexion);
+}
@@ -0,0 +1,46 @@
+/**
+ * @file serveur.h
+ * @brief Mode serveur du jeu snake : lots de parties sans affichage servis sur une socket Unix (version4 --serveur)
+ * @author Noah Le Goff, Sacha Mace
+ *
+ * Une seule boucle epoll sert toutes les connexions. Chaque client crée son lot de
+ * parties et le fait avancer d'un tour par message de directions (voir protocole.h) ;
+ * la mémoire de chaque connexion est bornée par MEMOIRE_MAX_CONNEXION et un client
+ * qui la dépasse ne ferme que sa propre connexion.
+ */
+
+#ifndef SERVEUR_H
+#define SERVEUR_H
+
+#include "jeu.h"
+
+// mémoire maximale d'une connexion du mode serveur (parties et tampons), en octets : au-delà,
+// le message est refusé par MESSAGE_ERREUR et seule cette connexion est fermée
+#define MEMOIRE_MAX_CONNEXION (64 * 1024 * 1024)
+
+// connexion d'un client du mode serveur : ses tampons et son lot de parties, toutes
+// jouées au même rythme (un message de directions fait avancer tout le lot d'un tour)
+typedef struct
+{
+	int descripteur;
+	unsigned char *entree;				// octets reçus pas encore traités
+	size_t tailleEntree, capaciteEntree;
+	unsigned char *sortie;				// octets à envoyer, à partir de debutSortie
+	size_t debutSortie, tailleSortie, capaciteSortie;
+	bool attenteEcriture;				// EPOLLOUT demandé : la socket était pleine
+	bool aFermer;						// plus rien à lire : fermée dès la sortie vidée
+	const tContexte *contexte;			// contexte des parties créées par le client
+	tEtatJeu *parties;
+	int nbParties;
+} tConnexion;
+
+int lancerServeur(const tContexte *contexte, const char *chemin);
+bool lireConnexion(tConnexion *connexion);
+size_t memoireConnexion(const tConnexion *connexion);
+void signalerErreur(tConnexion *connexion);
+bool traiterMessages(tConnexion *connexion);
+unsigned char *reserverSortie(tConnexion *connexion, size_t taille);
+bool viderSortie(tConnexion *connexion);
+void fermerConnexion(tConnexion *connexion);
+
+#endif
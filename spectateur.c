@@ -0,0 +1,204 @@
+/**
+ * @file spectateur.c
+ * @brief Spectateur d'une partie du jeu snake autonome (version4 --flux)
+ * @author Noah Le Goff, Sacha Mace
+ *
+ * Le spectateur lit le flux de deltas écrit par le jeu (voir protocole.h) et redessine
+ * le plateau dans son propre terminal : le jeu n'affiche plus rien et plusieurs
+ * spectateurs peuvent suivre le même fichier. Sur un fichier ordinaire, le spectateur
+ * attend les tours suivants tant que la partie n'est pas finie ; sur un tube, il s'arrête
+ * quand le jeu le ferme.
+ * Utilisation : spectateur [FICHIER] [PERIODE_MS] (entrée standard si FICHIER vaut "-",
+ * PERIODE_MS ralentit la relecture d'un fichier déjà écrit)
+ */
+
+/* Fichiers inclus */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include "protocole.h"
+
+// caractères du plateau, les mêmes que dans le jeu
+#define CORPS 'X'
+#define TETE_SERPENT1 '1'
+#define TETE_SERPENT2 '2'
+#define VIDE ' '
+#define POMME '6'
+// attente avant de relire un fichier que le jeu n'a pas fini d'écrire (en microsecondes)
+#define ATTENTE_SUITE 20000
+
+bool lireFlux(int flux, void *octets, size_t taille, bool suivre);
+bool lireMessage(int flux, int type, bool suivre);
+void afficher(int x, int y, char car);
+
+/**
+ * @brief  Entrée du programme
+ * @param argc de type int, Entrée : le nombre d'arguments
+ * @param argv de type char tableau, Entrée : le fichier du flux puis la période d'affichage en millisecondes
+ * @return EXIT_SUCCESS à la fin de la partie, EXIT_FAILURE si le flux est illisible
+ */
+int main(int argc, char *argv[])
+{
+	const char *chemin = (argc > 1) ? argv[1] : "-";
+	int periode = (argc > 2) ? atoi(argv[2]) : 0;
+	int flux = (strcmp(chemin, "-") == 0) ? STDIN_FILENO : open(chemin, O_RDONLY);
+	if (flux < 0)
+	{
+		perror(chemin);
+		return EXIT_FAILURE;
+	}
+	// seul un fichier ordinaire peut encore grandir après une fin de lecture
+	struct stat infos;
+	bool suivre = fstat(flux, &infos) == 0 && S_ISREG(infos.st_mode);
+
+	// plateau de départ
+	tDimensions dimensions;
+	if (!lireMessage(flux, MESSAGE_PLATEAU, suivre) || !lireFlux(flux, &dimensions, sizeof(dimensions), suivre))
+	{
+		fprintf(stderr, "%s n'est pas un flux de spectateur du jeu\n", chemin);
+		return EXIT_FAILURE;
+	}
+	char *cases = malloc(dimensions.largeur * dimensions.hauteur);
+	tEtatInitial initial;
+	if (!lireFlux(flux, cases, dimensions.largeur * dimensions.hauteur, suivre)
+		|| !lireMessage(flux, MESSAGE_ETATS, suivre) || !lireFlux(flux, &initial, sizeof(initial), suivre))
+	{
+		fprintf(stderr, "Flux tronqué\n");
+		return EXIT_FAILURE;
+	}
+	printf("\033[2J");
+	for (int x = 1; x <= dimensions.largeur; x++)
+	{
+		for (int y = 1; y <= dimensions.hauteur; y++)
+		{
+			afficher(x, y, cases[(x - 1) * dimensions.hauteur + y - 1]);
+		}
+	}
+	free(cases);
+
+	// serpents de départ, tête en premier
+	const char tetes[2] = {TETE_SERPENT1, TETE_SERPENT2};
+	int teteX[2], teteY[2];
+	for (int s = 0; s < 2; s++)
+	{
+		for (int i = PROTOCOLE_TAILLE_INITIALE - 1; i >= 0; i--)
+		{
+			afficher(initial.anneauxX[s][i], initial.anneauxY[s][i], (i == 0) ? tetes[s] : CORPS);
+		}
+		teteX[s] = initial.anneauxX[s][0];
+		teteY[s] = initial.anneauxY[s][0];
+	}
+	fflush(stdout);
+
+	// un delta par tour
+	tDelta delta = {0};
+	int tours = 0;
+	int pommes[2] = {0, 0};
+	do
+	{
+		if (!lireMessage(flux, MESSAGE_DELTAS, suivre) || !lireFlux(flux, &delta, sizeof(delta), suivre))
+		{
+			break;
+		}
+		tours++;
+		// les queues d'abord : une tête peut prendre la case qu'une queue vient de quitter
+		for (int s = 0; s < 2; s++)
+		{
+			if (delta.queueX[s] != 0)
+			{
+				afficher(delta.queueX[s], delta.queueY[s], VIDE);
+			}
+		}
+		for (int s = 0; s < 2; s++)
+		{
+			if (delta.teteX[s] != teteX[s] || delta.teteY[s] != teteY[s])
+			{
+				afficher(teteX[s], teteY[s], CORPS);
+				teteX[s] = delta.teteX[s];
+				teteY[s] = delta.teteY[s];
+			}
+			afficher(teteX[s], teteY[s], tetes[s]);
+		}
+		if (delta.pommeX != 0)
+		{
+			afficher(delta.pommeX, delta.pommeY, POMME);
+		}
+		pommes[0] += (delta.evenements & EVENEMENT_POMME_S1) != 0;
+		pommes[1] += (delta.evenements & EVENEMENT_POMME_S2) != 0;
+		fflush(stdout);
+		if (periode > 0)
+		{
+			usleep(periode * 1000);
+		}
+	} while ((delta.evenements & EVENEMENT_FIN) == 0);
+
+	printf("\033[%d;1f", dimensions.hauteur + 1);
+	printf("%s après %d tours : serpent 1 %d pommes%s, serpent 2 %d pommes%s\n",
+		   (tours > 0 && (delta.evenements & EVENEMENT_FIN)) ? "Fin de la partie" : "Flux interrompu", tours,
+		   pommes[0], (delta.evenements & EVENEMENT_COLLISION_S1) ? " (collision)" : "",
+		   pommes[1], (delta.evenements & EVENEMENT_COLLISION_S2) ? " (collision)" : "");
+
+	return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Fonction qui lit exactement taille octets du flux.
+ * @param flux de type int, Entrée : le descripteur du flux
+ * @param octets de type void*, Sortie : les octets lus
+ * @param taille de type size_t, Entrée : leur nombre
+ * @param suivre de type bool, Entrée : true pour attendre la suite d'un fichier encore écrit
+ * @return false si le flux est fini avant
+ */
+bool lireFlux(int flux, void *octets, size_t taille, bool suivre)
+{
+	unsigned char *debut = octets;
+	while (taille > 0)
+	{
+		ssize_t lus = read(flux, debut, taille);
+		if (lus < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		if (lus < 0 || (lus == 0 && !suivre))
+		{
+			return false;
+		}
+		if (lus == 0)
+		{
+			usleep(ATTENTE_SUITE);
+			continue;
+		}
+		debut += lus;
+		taille -= lus;
+	}
+	return true;
+}
+
+/**
+ * @brief Fonction qui lit l'entête du message suivant et vérifie son type.
+ * @param flux de type int, Entrée : le descripteur du flux
+ * @param type de type int, Entrée : le type attendu (MESSAGE_*)
+ * @param suivre de type bool, Entrée : true pour attendre la suite d'un fichier encore écrit
+ * @return false si le flux est fini ou si le message n'est pas du type attendu
+ */
+bool lireMessage(int flux, int type, bool suivre)
+{
+	tEntete entete;
+	return lireFlux(flux, &entete, sizeof(entete), suivre) && entete.type == type && entete.nbParties == 1;
+}
+
+/**
+ * @brief Procédure qui affiche un caractère à une case du plateau.
+ * @param x de type int, Entrée : la colonne
+ * @param y de type int, Entrée : la ligne
+ * @param car de type char, Entrée : le caractère
+ */
+void afficher(int x, int y, char car)
+{
+	printf("\033[%d;%df%c", y, x, car);
+}
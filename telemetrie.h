@@ -0,0 +1,77 @@
+/**
+ * @file telemetrie.h
+ * @brief Segment de mémoire partagée de télémétrie, commun au jeu (version4.c) et au moniteur (moniteur.c)
+ * @author Noah Le Goff, Sacha Mace
+ *
+ * Le jeu publie ses mesures à chaque tour dans un segment POSIX (shm_open) protégé par
+ * un verrou de séquence : l'écriture ne prend aucun verrou et ne dépend jamais du
+ * lecteur, qui peut lire à n'importe quel rythme et recommence simplement sa copie
+ * si le jeu a écrit pendant qu'il lisait.
+ */
+
+#ifndef TELEMETRIE_H
+#define TELEMETRIE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// nom du segment par défaut et marque de reconnaissance de sa disposition
+#define TELEMETRIE_NOM_DEFAUT "/snake_telemetrie"
+#define TELEMETRIE_MAGIQUE 0x534E4B34
+
+// mesures d'un tour de jeu
+typedef struct
+{
+	uint64_t tour;						// numéro du tour
+	uint32_t pommes[2];					// pommes mangées par chaque serpent
+	uint32_t deplacements[2];			// déplacements de chaque serpent
+	uint32_t tailles[2];				// nombre d'anneaux de chaque serpent
+	int32_t objectifs[2];				// trou visé (CHEMIN_HAUT ... CHEMIN_DROITE) ou CHEMIN_POMME
+	uint64_t latenceDecision;			// durée des décisions du tour, en nanosecondes
+	uint64_t latenceMax;				// plus longue durée de décision depuis le début
+	uint32_t enCours;					// 1 tant que la partie dure, 0 à la fin
+} tMesures;
+
+// segment partagé : la séquence est impaire pendant une écriture
+typedef struct
+{
+	uint32_t magique;
+	int32_t pid;						// processus du jeu
+	atomic_uint sequence;
+	tMesures mesures;
+} tSegmentTelemetrie;
+
+/**
+ * @brief Procédure qui publie les mesures d'un tour (un seul écrivain : le jeu).
+ * @param segment de type tSegmentTelemetrie, Entrée/Sortie : le segment partagé
+ * @param mesures de type tMesures, Entrée : les mesures à publier
+ */
+static inline void publierMesures(tSegmentTelemetrie *segment, const tMesures *mesures)
+{
+	unsigned sequence = atomic_load_explicit(&segment->sequence, memory_order_relaxed);
+	atomic_store_explicit(&segment->sequence, sequence + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	segment->mesures = *mesures;
+	atomic_store_explicit(&segment->sequence, sequence + 2, memory_order_release);
+}
+
+/**
+ * @brief Fonction qui copie des mesures cohérentes, en recommençant tant que le jeu
+ * écrivait pendant la copie.
+ * @param segment de type tSegmentTelemetrie, Entrée : le segment partagé
+ * @param mesures de type tMesures, Sortie : la copie des dernières mesures publiées
+ */
+static inline void lireMesures(const tSegmentTelemetrie *segment, tMesures *mesures)
+{
+	unsigned avant, apres;
+	do
+	{
+		avant = atomic_load_explicit((atomic_uint *)&segment->sequence, memory_order_acquire);
+		*mesures = segment->mesures;
+		atomic_thread_fence(memory_order_acquire);
+		apres = atomic_load_explicit((atomic_uint *)&segment->sequence, memory_order_relaxed);
+	} while ((avant & 1) != 0 || avant != apres);
+}
+
+#endif
@@ -0,0 +1,410 @@
+/**
+ * @file tournoi.c
+ * @brief Tournoi entre les stratégies du jeu snake et estimation de leurs Elo (version4 --tournoi)
+ * @author Noah Le Goff, Sacha Mace
+ */
+
+/* Fichiers inclus */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <signal.h>
+#include <pthread.h>
+#include "tournoi.h"
+
+/**
+ * @brief Procédure qui joue une partie du tournoi, les deux serpents se déplaçant en même
+ * temps, puis la juge : un serpent qui entre en collision perd contre un serpent qui n'en
+ * a pas eu ; sinon (aucune collision, collision des deux, ou partie arrêtée après
+ * LIMITE_TOURS_TOURNOI tours) le serpent qui a mangé le plus de pommes gagne.
+ * @param contexte de type tContexte, Entrée : la carte et les portails de la partie
+ * @param partie de type tPartieTournoi, Entrée/Sortie : les stratégies et la graine, puis le résultat
+ * @param etat de type tEtatJeu, Sortie : l'état où la partie est jouée
+ * @param pommesProcedurales de type bool, Entrée : true pour tirer toutes les pommes au hasard
+ */
+void jouerPartieTournoi(const tContexte *contexte, tPartieTournoi *partie, tEtatJeu *etat, bool pommesProcedurales)
+{
+	const char directionsIA[2] = {0, 0};
+	initEtatJeu(etat, contexte, partie->graine, pommesProcedurales, false, 1);
+	etat->serpents[0].strategie = partie->strategies[0];
+	etat->serpents[1].strategie = partie->strategies[1];
+	while (!partieFinie(etat) && etat->serpents[0].deplacements < LIMITE_TOURS_TOURNOI)
+	{
+		jouerTourSimultane(etat, directionsIA);
+	}
+
+	for (int s = 0; s < 2; s++)
+	{
+		partie->pommes[s] = etat->serpents[s].nbPommesMangees;
+		partie->collisions[s] = etat->serpents[s].collision;
+	}
+	partie->deplacements = etat->serpents[0].deplacements;
+	partie->arretee = !partieFinie(etat);
+	if (partie->collisions[0] != partie->collisions[1])
+	{
+		partie->score = partie->collisions[0] ? 0.0f : 1.0f;
+	}
+	else
+	{
+		partie->score = (partie->pommes[0] > partie->pommes[1]) ? 1.0f : (partie->pommes[0] < partie->pommes[1]) ? 0.0f : 0.5f;
+	}
+}
+
+/**
+ * @brief Fonction exécutée par chaque fil du tournoi : prend la partie suivante tant qu'il
+ * en reste, ce qui équilibre les fils quelle que soit la durée des parties.
+ * @param argument de type tTournoi, Entrée/Sortie : les parties du tournoi
+ * @return NULL
+ */
+void *filTournoi(void *argument)
+{
+	tTournoi *tournoi = argument;
+	tEtatJeu *etat = malloc(sizeof(tEtatJeu));
+	if (etat == NULL)
+	{
+		return NULL;
+	}
+	int p;
+	while (!arretDemande && (p = atomic_fetch_add(&tournoi->suivante, 1)) < tournoi->nbParties)
+	{
+		jouerPartieTournoi(tournoi->contexte, &tournoi->parties[p], etat, tournoi->pommesProcedurales);
+	}
+	free(etat);
+	return NULL;
+}
+
+/**
+ * @brief Fonction qui joue toutes les parties d'un tournoi sur nbFils fils et attend la fin.
+ * @param tournoi de type tTournoi, Entrée/Sortie : les parties, puis leurs résultats
+ * @param nbFils de type int, Entrée : le nombre de fils à lancer
+ * @return le nombre de fils lancés, 0 si aucun n'a pu l'être
+ */
+int jouerTournoi(tTournoi *tournoi, int nbFils)
+{
+	pthread_t *fils = malloc(nbFils * sizeof(pthread_t));
+	int lances = 0;
+	atomic_init(&tournoi->suivante, 0);
+	for (int f = 0; fils != NULL && f < nbFils; f++)
+	{
+		if (pthread_create(&fils[f], NULL, filTournoi, tournoi) != 0)
+		{
+			fprintf(stderr, "Impossible de lancer le fil %d\n", f);
+			break;
+		}
+		lances++;
+	}
+	for (int f = 0; f < lances; f++)
+	{
+		pthread_join(fils[f], NULL);
+	}
+	free(fils);
+	return lances;
+}
+
+/**
+ * @brief Procédure qui estime l'Elo de chaque stratégie engagée à partir des résultats :
+ * forces du modèle de Bradley-Terry au maximum de vraisemblance (itérations de
+ * minorisation-maximisation, un nul valant une demi-victoire à chacun), ramenées à une
+ * moyenne de ELO_MOYEN. Une partie nulle fictive entre chaque paire garde des forces
+ * finies pour une stratégie qui gagne ou perd tout.
+ * @param parties de type tPartieTournoi tableau, Entrée : les parties jouées
+ * @param tirage de type int tableau, Entrée : les indices des parties à compter (tirage avec
+ * remise pour l'intervalle de confiance), ou NULL pour toutes les compter une fois
+ * @param nbParties de type int, Entrée : le nombre de parties à compter
+ * @param nbStrategies de type int, Entrée : le nombre de stratégies connues
+ * @param engagees de type bool tableau, Entrée : les stratégies engagées
+ * @param elo de type double tableau, Sortie : l'Elo de chaque stratégie engagée
+ */
+void estimerElo(const tPartieTournoi parties[], const int tirage[], int nbParties, int nbStrategies, const bool engagees[], double elo[])
+{
+	double score[MAX_STRATEGIES] = {0}, rencontres[MAX_STRATEGIES][MAX_STRATEGIES] = {{0}}, forces[MAX_STRATEGIES];
+	for (int i = 0; i < nbStrategies; i++)
+	{
+		forces[i] = 1;
+		for (int j = 0; engagees[i] && j < nbStrategies; j++)
+		{
+			if (j != i && engagees[j])
+			{
+				rencontres[i][j] += 1;
+				score[i] += 0.5;
+			}
+		}
+	}
+	for (int p = 0; p < nbParties; p++)
+	{
+		const tPartieTournoi *partie = &parties[(tirage != NULL) ? tirage[p] : p];
+		int a = partie->strategies[0], b = partie->strategies[1];
+		rencontres[a][b] += 1;
+		rencontres[b][a] += 1;
+		score[a] += partie->score;
+		score[b] += 1 - partie->score;
+	}
+
+	for (int iteration = 0; iteration < ITERATIONS_ELO; iteration++)
+	{
+		double logarithmes = 0;
+		int nbEngagees = 0;
+		for (int i = 0; i < nbStrategies; i++)
+		{
+			if (!engagees[i])
+			{
+				continue;
+			}
+			double attendu = 0;
+			for (int j = 0; j < nbStrategies; j++)
+			{
+				attendu += (rencontres[i][j] > 0) ? rencontres[i][j] / (forces[i] + forces[j]) : 0;
+			}
+			forces[i] = (attendu > 0) ? score[i] / attendu : 1;
+			logarithmes += log(forces[i]);
+			nbEngagees++;
+		}
+		double moyenne = exp(logarithmes / nbEngagees);
+		for (int i = 0; i < nbStrategies; i++)
+		{
+			forces[i] /= moyenne;
+		}
+	}
+	for (int i = 0; i < nbStrategies; i++)
+	{
+		elo[i] = engagees[i] ? ELO_MOYEN + 400 * log10(forces[i]) : 0;
+	}
+}
+
+/**
+ * @brief Fonction qui départage des stratégies par un tournoi : chaque paire de stratégies
+ * engagées joue une partie par graine dans chaque sens (chacune prend une fois la place
+ * du serpent 1), avec les règles à deux serpents et des pommes tirées au hasard. Les
+ * parties sont jouées sans affichage sur nbFils fils. Le bilan donne l'Elo de chaque
+ * stratégie avec son intervalle de confiance à 95 % (percentiles de TIRAGES_ELO
+ * estimations sur des tirages avec remise des parties), son score moyen avec son
+ * intervalle, et le score de chaque paire.
+ * @param contexte de type tContexte, Entrée : la carte et les portails des parties
+ * @param nbGraines de type int, Entrée : le nombre de graines
+ * @param cheminGraines de type char tableau, Entrée : un fichier de graines (entiers séparés
+ * par des blancs), pour rejouer le même tournoi après une modification, ou NULL pour
+ * prendre graine, graine + 1, ...
+ * @param graine de type uint64_t, Entrée : la première graine, et celle des tirages
+ * @param nbFils de type int, Entrée : le nombre de fils
+ * @param strategies de type char tableau, Entrée : les noms des stratégies engagées séparés
+ * par des virgules, ou NULL pour toutes (la politique seulement si le contexte en a une)
+ * @return EXIT_SUCCESS, ou EXIT_FAILURE si les options, les fichiers ou la mémoire font défaut
+ */
+int lancerTournoi(const tContexte *contexte, int nbGraines, const char *cheminGraines, uint64_t graine, int nbFils, const char *strategies)
+{
+	// stratégies engagées
+	bool engagees[MAX_STRATEGIES] = {false};
+	int nbEngagees = 0;
+	if (strategies == NULL)
+	{
+		for (int i = 0; i < contexte->nbStrategies; i++)
+		{
+			engagees[i] = (i != STRATEGIE_POLITIQUE || contexte->modele != NULL);
+		}
+	}
+	else
+	{
+		char noms[256];
+		snprintf(noms, sizeof(noms), "%s", strategies);
+		for (char *nom = strtok(noms, ","); nom != NULL; nom = strtok(NULL, ","))
+		{
+			int i = trouverStrategie(contexte, nom);
+			if (i < 0)
+			{
+				fprintf(stderr, "Stratégie inconnue : %s\n", nom);
+				return EXIT_FAILURE;
+			}
+			engagees[i] = true;
+		}
+	}
+	for (int i = 0; i < contexte->nbStrategies; i++)
+	{
+		nbEngagees += engagees[i];
+	}
+	if (nbEngagees < 2)
+	{
+		fprintf(stderr, "Un tournoi demande au moins deux stratégies\n");
+		return EXIT_FAILURE;
+	}
+	if (engagees[STRATEGIE_POLITIQUE] && contexte->modele == NULL)
+	{
+		fprintf(stderr, "La stratégie politique demande --politique FICHIER\n");
+		return EXIT_FAILURE;
+	}
+
+	// graines, puis une partie par paire, par graine et par sens
+	uint64_t *graines = malloc(nbGraines * sizeof(uint64_t));
+	int nbParties = nbEngagees * (nbEngagees - 1) * nbGraines;
+	tPartieTournoi *parties = malloc(nbParties * sizeof(tPartieTournoi));
+	int *tirage = malloc(nbParties * sizeof(int));
+	double (*estimations)[MAX_STRATEGIES] = malloc(TIRAGES_ELO * sizeof(*estimations));
+	bool pret = graines != NULL && parties != NULL && tirage != NULL && estimations != NULL;
+	if (!pret)
+	{
+		fprintf(stderr, "Mémoire insuffisante pour %d parties\n", nbParties);
+	}
+	FILE *fichier = (pret && cheminGraines != NULL) ? fopen(cheminGraines, "r") : NULL;
+	if (pret && cheminGraines != NULL)
+	{
+		int lues = 0;
+		if (fichier == NULL)
+		{
+			perror(cheminGraines);
+		}
+		unsigned long long lue;
+		while (fichier != NULL && lues < nbGraines && fscanf(fichier, "%llu", &lue) == 1)
+		{
+			graines[lues++] = lue;
+		}
+		if (fichier != NULL && lues < nbGraines)
+		{
+			fprintf(stderr, "%s ne contient que %d graines sur %d\n", cheminGraines, lues, nbGraines);
+		}
+		pret = (lues == nbGraines);
+		if (fichier != NULL)
+		{
+			fclose(fichier);
+		}
+	}
+	for (int g = 0; pret && cheminGraines == NULL && g < nbGraines; g++)
+	{
+		graines[g] = graine + g;
+	}
+	int p = 0;
+	for (int a = 0; pret && a < contexte->nbStrategies; a++)
+	{
+		for (int b = 0; engagees[a] && b < contexte->nbStrategies; b++)
+		{
+			for (int g = 0; engagees[b] && b != a && g < nbGraines; g++)
+			{
+				parties[p].strategies[0] = a;
+				parties[p].strategies[1] = b;
+				parties[p].graine = graines[g];
+				p++;
+			}
+		}
+	}
+
+	// parties réparties dynamiquement sur les fils
+	tTournoi tournoi = {.contexte = contexte, .parties = parties, .nbParties = nbParties, .pommesProcedurales = true};
+	signal(SIGINT, demanderArret);
+	signal(SIGTERM, demanderArret);
+	long long debut = maintenantNano();
+	int lances = pret ? jouerTournoi(&tournoi, nbFils) : 0;
+	double duree = (maintenantNano() - debut) / 1e9;
+	pret = pret && lances > 0 && !arretDemande;
+
+	if (pret)
+	{
+		// Elo et intervalle de confiance
+		double elo[MAX_STRATEGIES], bornes[MAX_STRATEGIES][2], valeurs[TIRAGES_ELO];
+		tGenerateur generateur;
+		initGenerateur(&generateur, graine);
+		estimerElo(parties, NULL, nbParties, contexte->nbStrategies, engagees, elo);
+		for (int t = 0; t < TIRAGES_ELO; t++)
+		{
+			for (int i = 0; i < nbParties; i++)
+			{
+				tirage[i] = (int)tirerBorne(&generateur, nbParties);
+			}
+			estimerElo(parties, tirage, nbParties, contexte->nbStrategies, engagees, estimations[t]);
+		}
+		for (int s = 0; s < contexte->nbStrategies; s++)
+		{
+			// tri par insertion des estimations de la stratégie
+			for (int t = 0; t < TIRAGES_ELO; t++)
+			{
+				double valeur = estimations[t][s];
+				int i = t;
+				while (i > 0 && valeurs[i - 1] > valeur)
+				{
+					valeurs[i] = valeurs[i - 1];
+					i--;
+				}
+				valeurs[i] = valeur;
+			}
+			bornes[s][0] = valeurs[(int)(0.025 * TIRAGES_ELO)];
+			bornes[s][1] = valeurs[(int)(0.975 * TIRAGES_ELO) - 1];
+		}
+
+		// scores par stratégie et par paire, du point de vue de la ligne
+		double scores[MAX_STRATEGIES][MAX_STRATEGIES] = {{0}}, carres[MAX_STRATEGIES] = {0}, pommes[MAX_STRATEGIES] = {0};
+		int jouees[MAX_STRATEGIES][MAX_STRATEGIES] = {{0}}, collisions[MAX_STRATEGIES] = {0};
+		for (int i = 0; i < nbParties; i++)
+		{
+			for (int s = 0; s < 2; s++)
+			{
+				int a = parties[i].strategies[s], b = parties[i].strategies[1 - s];
+				double score = (s == 0) ? parties[i].score : 1 - parties[i].score;
+				scores[a][b] += score;
+				carres[a] += score * score;
+				jouees[a][b]++;
+				pommes[a] += parties[i].pommes[s];
+				collisions[a] += parties[i].collisions[s];
+			}
+		}
+
+		printf("Tournoi de %d stratégies : %d parties (%d graines, %s", nbEngagees, nbParties, nbGraines, cheminGraines != NULL ? cheminGraines : "");
+		if (cheminGraines == NULL)
+		{
+			printf("de %llu à %llu", (unsigned long long)graine, (unsigned long long)(graine + nbGraines - 1));
+		}
+		printf(") sur %d fils en %.2f s (%.0f parties par seconde)\n", lances, duree, nbParties / duree);
+		// "é" compte deux octets pour une seule colonne
+		printf("%-11s %6s %16s %18s %8s %10s\n", "Stratégie", "Elo", "IC 95 %", "score (IC 95 %)", "pommes", "collisions");
+		for (int a = 0; a < contexte->nbStrategies; a++)
+		{
+			if (!engagees[a])
+			{
+				continue;
+			}
+			int total = 0;
+			double somme = 0;
+			for (int b = 0; b < contexte->nbStrategies; b++)
+			{
+				total += jouees[a][b];
+				somme += scores[a][b];
+			}
+			double moyenne = somme / total;
+			double ecart = 1.96 * sqrt(fmax(carres[a] / total - moyenne * moyenne, 0) / total);
+			printf("%-10s %6.0f    [%5.0f, %5.0f]    %5.1f %% ± %4.1f %8.2f %10.2f\n", contexte->strategies[a].nom, elo[a], bornes[a][0], bornes[a][1],
+				   100 * moyenne, 100 * ecart, pommes[a] / total, (double)collisions[a] / total);
+		}
+		printf("Score de la ligne contre la colonne (%%) :\n%-10s", "");
+		for (int b = 0; b < contexte->nbStrategies; b++)
+		{
+			if (engagees[b])
+			{
+				printf(" %9s", contexte->strategies[b].nom);
+			}
+		}
+		printf("\n");
+		for (int a = 0; a < contexte->nbStrategies; a++)
+		{
+			if (!engagees[a])
+			{
+				continue;
+			}
+			printf("%-10s", contexte->strategies[a].nom);
+			for (int b = 0; b < contexte->nbStrategies; b++)
+			{
+				if (engagees[b] && b == a)
+				{
+					printf(" %9s", "-");
+				}
+				else if (engagees[b])
+				{
+					printf(" %9.1f", 100 * scores[a][b] / jouees[a][b]);
+				}
+			}
+			printf("\n");
+		}
+	}
+
+	free(graines);
+	free(parties);
+	free(tirage);
+	free(estimations);
+	return pret ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file tournoi.h
+ * @brief Tournoi entre les stratégies du jeu snake et estimation de leurs Elo (version4 --tournoi)
+ * @author Noah Le Goff, Sacha Mace
+ *
+ * Chaque paire de stratégies engagées joue sur chaque graine dans les deux sens ; les
+ * parties sont prises une à une par les fils, puis les Elo sont estimés sur
+ * l'ensemble des parties et leurs intervalles de confiance par rééchantillonnage.
+ */
+
+#ifndef TOURNOI_H
+#define TOURNOI_H
+
+#include "jeu.h"
+
+// estimation des Elo : tirages de l'intervalle de confiance, itérations de
+// l'estimation et Elo moyen des stratégies engagées
+#define TIRAGES_ELO 200
+#define ITERATIONS_ELO 200
+#define ELO_MOYEN 1500
+
+// partie d'un tournoi : les stratégies des deux serpents, la graine et le résultat
+typedef struct
+{
+	int strategies[2];
+	uint64_t graine;
+	float score;						// pour le serpent 1 : 1 gagnée, 0.5 nulle, 0 perdue
+	int pommes[2];
+	bool collisions[2];
+	int deplacements;
+	bool arretee;						// arrêtée après LIMITE_TOURS_TOURNOI tours
+} tPartieTournoi;
+
+// parties d'un tournoi, prises une à une par les fils
+typedef struct
+{
+	const tContexte *contexte;
+	tPartieTournoi *parties;
+	int nbParties;
+	bool pommesProcedurales;			// false pour suivre les pommes prévues de la carte
+	atomic_int suivante;
+} tTournoi;
+
+void jouerPartieTournoi(const tContexte *contexte, tPartieTournoi *partie, tEtatJeu *etat, bool pommesProcedurales);
+void *filTournoi(void *argument);
+int jouerTournoi(tTournoi *tournoi, int nbFils);
+void estimerElo(const tPartieTournoi parties[], const int tirage[], int nbParties, int nbStrategies, const bool engagees[], double elo[]);
+int lancerTournoi(const tContexte *contexte, int nbGraines, const char *cheminGraines, uint64_t graine, int nbFils, const char *strategies);
+
+#endif
@@ -8,6 +8,7 @@
  * Le serpent avance automatiquement et peut changer de direction automatiquement
  * Le serpent va donc se diriger vers les pommes sans toucher d'obstacle.
  * Le jeu se termine lorsque la touche 'a' est pressée ou lorsque le serpent a manger 10 pommes.
+ * Compilation : make (voir le Makefile)
  *
  */
 
@@ -19,366 +20,717 @@
 #include <termios.h>
 #include <fcntl.h>
 #include <time.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <signal.h>
+#include <errno.h>
+#include "observation.h"
+#include "jeu.h"
+#include "serveur.h"
+#include "hote.h"
+#include "planificateur.h"
+#include "jps.h"
+#include "bitboard.h"
+#include "reseau.h"
+#include "tournoi.h"
+#include "cartes.h"
 
-// taille du serpent
-#define TAILLE 10
-// dimensions du plateau
-#define LARGEUR_PLATEAU 80
-#define HAUTEUR_PLATEAU 40
-// position initiale de la tête du serpent
-#define X_INITIAL_SERPENT1 40
-#define Y_INITIAL_SERPENT1 13
-#define X_INITIAL_SERPENT2 40
-#define Y_INITIAL_SERPENT2 27
-// position des trous
-#define TROU_HAUT_X 40
-#define TROU_HAUT_Y 0
-#define TROU_BAS_X 40
-#define TROU_BAS_Y 40
-#define TROU_GAUCHE_X 0
-#define TROU_GAUCHE_Y 20
-#define TROU_DROITE_X 80
-#define TROU_DROITE_Y 20
-// nombre de pommes à manger pour gagner
-#define NB_POMMES 10
-// temporisation entre deux déplacements du serpent (en microsecondes)
-#define ATTENTE 100000
-// caractères pour représenter le serpent
-#define CORPS 'X'
-#define TETE_SERPENT1 '1'
-#define TETE_SERPENT2 '2'
-// touches de direction ou d'arrêt du jeu
-#define HAUT 'z'
-#define BAS 's'
-#define GAUCHE 'q'
-#define DROITE 'd'
-#define STOP 'a'
-// caractères pour les éléments du plateau
-#define BORDURE '#'
-#define VIDE ' '
-#define POMME '6'
-// pavés
-#define NB_PAVES 6
-#define TAILLE_PAVE 5
-// valeur renvoyer en fonction de la distance
-#define CHEMIN_HAUT 1
-#define CHEMIN_BAS 2
-#define CHEMIN_GAUCHE 3
-#define CHEMIN_DROITE 4
-#define CHEMIN_POMME 5
-
-// définition d'un type pour le plateau : tPlateau
-// Attention, pour que les indices du tableau 2D (qui commencent à 0) coincident
-// avec les coordonées à l'écran (qui commencent à 1), on ajoute 1 aux dimensions
-// et on neutralise la ligne 0 et la colonne 0 du tableau 2D (elles ne sont jamais
-// utilisées)
-typedef char tPlateau[LARGEUR_PLATEAU + 1][HAUTEUR_PLATEAU + 1];
-
-// coordonnées des pommes
-int lesPommesX[NB_POMMES] = {40, 75, 78, 2, 9, 78, 74, 2, 72, 5};
-int lesPommesY[NB_POMMES] = {20, 38, 2, 2, 5, 38, 32, 38, 32, 2};
-
-// coordonnées des pavés
-int lesPavesX[NB_PAVES] = { 4, 73, 4, 73, 38, 38};
-int lesPavesY[NB_PAVES] = { 4, 4, 33, 33, 14, 22};
-
-void initPlateau(tPlateau plateau);
-void dessinerPlateau(tPlateau plateau);
-void ajouterPomme(tPlateau plateau, int iPomme);
-void afficher(int, int, char);
-void effacer(int x, int y);
-void dessinerSerpent1(int lesX[], int lesY[]);
-void dessinerSerpent2(int lesX[], int lesY[]);
-void directionSerpentVersObjectif1(int lesX_S1[], int lesY_S1[], int lesX_S2[], int lesY_S2[], tPlateau plateau, char *direction, int objectifX, int objectifY, bool changement);
-void directionSerpentVersObjectif2(int lesX_S2[], int lesY_S2[], int lesX_S1[], int lesY_S1[], tPlateau plateau, char *direction, int objectifX, int objectifY, bool changement);
-bool verifierCollision1(int lesX_S1[], int lesY_S1[], int lesX_S2[], int lesY_S2[], tPlateau plateau, char directionProchaine);
-bool verifierCollision2(int lesX_S2[], int lesY_S2[], int lesX_S1[], int lesY_S1[], tPlateau plateau, char directionProchaine);
-int calculerDistance1(int lesX_S1[], int lesY_S1[], int pommeX, int pommeY);
-int calculerDistance2(int lesX_S2[], int lesY_S2[], int pommeX, int pommeY);
-void progresser1(int lesX[], int lesY[], char direction, tPlateau plateau, bool *collision, bool *pomme, bool *teleporter, bool *sortieDuTrou);
-void progresser2(int lesX[], int lesY[], char direction, tPlateau plateau, bool *collision, bool *pomme, bool *teleporter, bool *sortieDuTrou);
-int calculerDistancePommePave(int pommeX, int pommeY);
-bool changementDirection(int lesX[], int lesY[], int nbPommesMangee, int meilleureDistancePave);
-bool changementDirectionCasIsole(int lesX_S2[], int lesY_S2[], int lesX_S1[], int lesY_S1[]);
-void gotoxy(int x, int y);
-int kbhit();
-void disable_echo();
-void enable_echo();
+// noyau de collision choisi à l'exécution selon le jeu d'instructions du processeur
+bool (*collisionCorps)(const int lesX[], const int lesY[], int taille, int x, int y) = collisionCorpsScalaire;
+int (*collisionCandidats)(const int lesX[], const int lesY[], int taille, const int candidatsX[4], const int candidatsY[4]) = collisionCandidatsScalaire;
 
 /**
  * @brief  Entrée du programme
+ * @param argc de type int, Entrée : le nombre d'arguments
+ * @param argv de type char tableau, Entrée : les arguments, parmi :
+ * - "--parallele" : les deux serpents décident en même temps sur l'état du début du tour
+ * - "--ordonnanceur N" : leurs décisions sont réparties en tâches sur N fils ouvriers, le
+ *   fil principal ne faisant que surveiller l'échéance du tour
+ * - "--graine N" : rejoue une partie à l'identique
+ * - "--pommes-procedurales" : chaque pomme est tirée au hasard parmi les cases libres au
+ *   lieu de suivre lesPommesX/lesPommesY
+ * - "--croissance" : chaque pomme mangée allonge le serpent d'un anneau, sans limite de
+ *   pommes ; la partie dure jusqu'à une collision ou jusqu'à ce que le plateau soit plein
+ * - "--pommes N" : N pommes en même temps sur le plateau (jusqu'à MAX_POMMES_SIMULTANEES),
+ *   chaque serpent visant la plus proche de celles qu'il atteint avant l'autre
+ * - "--telemetrie [NOM]" : publie les mesures de chaque tour dans le segment de mémoire
+ *   partagée NOM (TELEMETRIE_NOM_DEFAUT par défaut), lisible par le programme moniteur
+ * - "--flux FICHIER" : écrit dans FICHIER (fichier ordinaire ou tube nommé) le delta de
+ *   chaque tour, lu par le programme spectateur, à la place de l'affichage dans le terminal
+ * - "--serveur CHEMIN" : sert des lots de parties sans affichage sur la socket Unix
+ *   CHEMIN, pilotées par des programmes externes (voir protocole.h)
+ * - "--hote N" : joue N parties sans affichage dans un seul processus
+ * - "--fils T" : nombre de fils du mode hôte, du tournoi et du banc de cartes
+ *   (FILS_HOTE_DEFAUT par défaut) ; chaque fil de l'hôte a sa boucle epoll sur les
+ *   minuteurs de ses parties
+ * - "--periode MS" ou "--periode MIN:MAX" : durée d'un tour de chaque partie de l'hôte, en
+ *   millisecondes (tirée au hasard entre MIN et MAX pour chaque partie)
+ * - "--hierarchique N" : mesure le planificateur hiérarchique sur un plateau de NxN cases
+ *   semé de pavés
+ * - "--jps [comparer]" : chaque serpent suit le plus court chemin vers la pomme, trouvé par
+ *   points de saut, en comptant les cases développées (et celles d'un A* case par case sur
+ *   les mêmes recherches avec "comparer")
+ * - "--voronoi" : chaque serpent va à la pomme s'il l'atteint avant l'autre, et sinon garde
+ *   le plus grand territoire
+ * - "--jeu-de-donnees FICHIER N" : joue N parties sans affichage et écrit dans FICHIER
+ *   l'observation de chaque serpent à chaque tour avec le coup joué (voir observation.h)
+ * - "--politique FICHIER" : chaque serpent suit la politique neuronale du fichier de poids
+ *   FICHIER (voir politique.h)
+ * - "--entrainer-politique FICHIER N [octets]" : apprend une politique en imitant le mode
+ *   --jps sur N parties, l'écrit dans FICHIER (poids en octets avec "octets") et la compare
+ *   aux autres IA
+ * - "--evaluer-politique FICHIER N" : compare une politique aux autres IA sur N parties
+ * - "--tournoi N" : fait jouer chaque paire de stratégies sur N graines dans les deux sens
+ *   et donne leur Elo et leurs scores avec leurs intervalles de confiance
+ * - "--graines FICHIER" : lit dans FICHIER les graines du tournoi
+ * - "--strategies LISTE" : n'engage au tournoi que les stratégies de LISTE (noms de
+ *   stratégies connues séparés par des virgules, dont "prudent", stratégie d'exemple
+ *   enregistrée par enregistrerStrategie) ; hors tournoi, "NOM" donne la même stratégie aux
+ *   deux serpents et "NOM1,NOM2" une à chacun. Sans cette option, les serpents suivent la
+ *   stratégie de --politique, sinon de --voronoi, sinon de --jps, sinon l'IA habituelle
+ * - "--carte FICHIER" : joue sur le plateau, les départs et les pommes décrits par FICHIER
+ *   (voir lireInstructionCarte)
+ * - "--cartes LISTE N" : joue N parties sur chacune des cartes de LISTE (un fichier par
+ *   ligne) et résume chaque carte
+ * - "--verifier-journal N" : joue N parties sans affichage en annulant chaque tour par le
+ *   journal d'annulation et vérifie que l'état revient à l'identique
+ * - "--verifier-portails N" : vérifie sur une carte à deux portails, et N parties,
+ *   qu'aucun serpent n'entre dans un portail sans le viser et qu'aucune pomme n'apparaît
+ *   sur un portail
  * @return EXIT_SUCCESS : arrêt normal du programme
  */
-int main()
+int main(int argc, char *argv[])
 {
-	// départ du calcul du temps CPU
-	clock_t begin = clock();
-
-	// Total des déplacements
-	int deplacement_S1 = 0;
-	int deplacement_S2 = 0;
-
-	// 2 tableaux contenant les positions des éléments qui constituent le serpent
-	int lesX_S1[TAILLE];
-	int lesY_S1[TAILLE];
-
-	int lesX_S2[TAILLE];
-	int lesY_S2[TAILLE];
-
-	// représente la touche frappée par l'utilisateur : touche de direction ou pour l'arrêt
-	char touche;
-
-	// direction courante du serpent (HAUT, BAS, GAUCHE ou DROITE)
-	char direction_S1;
-	char direction_S2;
-
-	// le plateau de jeu
-	tPlateau lePlateau;
-
-	bool collision_S1 = false;
-	bool collision_S2 = false;
-	bool gagne = false;
-	bool pommeMangee_S1 = false;
-	bool pommeMangee_S2 = false;
-	bool teleporter_S1 = false;
-	bool teleporter_S2 = false;
-	bool sortieDuTrou_S1 = false;
-	bool sortieDuTrou_S2 = false;
-	bool changement_S1 = false;
-	bool changement_S2 = false;
-
-	// compteur de pommes mangées
-	int nbPommesMangee = 0;
-	int nbPommesMangee_S1 = 0;
-	int nbPommesMangee_S2 = 0;
-
-	// initialisation de la position du serpent 1 : positionnement de la
-	// tête en (X_INITIAL_SERPENT1, Y_INITIAL_SERPENT1), puis des anneaux à sa gauche
-	for (int i = 0; i < TAILLE; i++)
-	{
-		lesX_S1[i] = X_INITIAL_SERPENT1 - i;
-		lesY_S1[i] = Y_INITIAL_SERPENT1;
-	}
-
-	for (int i = 0; i < TAILLE; i++)
-	{
-		lesX_S2[i] = X_INITIAL_SERPENT1 + i;
-		lesY_S2[i] = Y_INITIAL_SERPENT2;
-	}
-
-	// mise en place du plateau
-	initPlateau(lePlateau);
-	system("clear");
-	dessinerPlateau(lePlateau);
-
-	srand(time(NULL));
-	ajouterPomme(lePlateau, nbPommesMangee);
-
-	// initialisation : le serpent se dirige vers la DROITE
-	dessinerSerpent1(lesX_S1, lesY_S1);
-	dessinerSerpent2(lesX_S2, lesY_S2);
-
-	disable_echo();
-	direction_S1 = DROITE;
-	direction_S2 = GAUCHE;
-
-	// calcul les meilleures distance à l'initialisation
-	int meilleureDistance_S1 = calculerDistance1(lesX_S1, lesY_S1, lesPommesX[nbPommesMangee], lesPommesY[nbPommesMangee]);
-	int meilleureDistance_S2 = calculerDistance2(lesX_S2, lesY_S2, lesPommesX[nbPommesMangee], lesPommesY[nbPommesMangee]);
-	int DistancePommePave = calculerDistancePommePave(lesPommesX[nbPommesMangee], lesPommesY[nbPommesMangee]);
-
-	// boucle de jeu. Arret si touche STOP, si collision avec une bordure ou
-	// si toutes les pommes sont mangées
-	do
+	// lecture des options
+	bool modeParallele = false;
+	int nbOuvriers = 0;
+	uint64_t graine = (uint64_t)time(NULL);
+	bool pommesProcedurales = false;
+	bool croissance = false;
+	const char *nomTelemetrie = NULL;
+	const char *cheminServeur = NULL;
+	const char *cheminFlux = NULL;
+	int nbPartiesHote = 0;
+	const char *cheminDonnees = NULL;
+	int nbPartiesDonnees = 0;
+	int nbPartiesJournal = 0;
+	int nbPartiesPortails = 0;
+	const char *cheminPolitique = NULL;
+	const char *cheminEntrainement = NULL, *cheminEvaluation = NULL;
+	int nbPartiesPolitique = 0;
+	bool poidsOctets = false;
+	int nbGrainesTournoi = 0;
+	const char *cheminGraines = NULL, *strategies = NULL;
+	const char *cheminCarte = NULL, *listeCartes = NULL;
+	int nbPartiesCartes = 0;
+	int tailleHierarchique = 0;
+	bool jps = false, comparerAEtoile = false;
+	int nbPommes = 1;
+	bool voronoi = false;
+	int nbFilsHote = FILS_HOTE_DEFAUT;
+	long periodeMin = ATTENTE / 1000, periodeMax = ATTENTE / 1000;
+	for (int i = 1; i < argc; i++)
 	{
-		printf("Serpent 1 : %d ", meilleureDistance_S1);
-		// appel la fonction qui s'occupe de changer ou non le mode de direction à la sortie d'un trou
-		if(sortieDuTrou_S1){
-			changement_S1 = changementDirection(lesX_S1, lesY_S1, nbPommesMangee, DistancePommePave);
-			sortieDuTrou_S1 = false;
+		if (strcmp(argv[i], "--parallele") == 0)
+		{
+			modeParallele = true;
 		}
-
-		// choisis la direction en fonction de la meilleur distance
-		if (meilleureDistance_S1 == CHEMIN_HAUT) // se dirige vers le trou du haut puis quand il s'est téléporter avance vers la pomme
+		else if (strcmp(argv[i], "--pommes-procedurales") == 0)
+		{
+			pommesProcedurales = true;
+		}
+		else if (strcmp(argv[i], "--croissance") == 0)
+		{
+			// la table lesPommesX/lesPommesY ne compte que NB_POMMES pommes
+			croissance = true;
+			pommesProcedurales = true;
+		}
+		else if (strcmp(argv[i], "--telemetrie") == 0)
+		{
+			// le nom d'un segment POSIX commence par '/'
+			nomTelemetrie = (i + 1 < argc && argv[i + 1][0] == '/') ? argv[++i] : TELEMETRIE_NOM_DEFAUT;
+		}
+		else if (strcmp(argv[i], "--pommes") == 0 && i + 1 < argc)
 		{
-			if (teleporter_S1)
+			nbPommes = atoi(argv[++i]);
+			if (nbPommes < 1 || nbPommes > MAX_POMMES_SIMULTANEES)
 			{
-				
-				directionSerpentVersObjectif1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, lePlateau, &direction_S1, lesPommesX[nbPommesMangee], lesPommesY[nbPommesMangee], changement_S1);
+				fprintf(stderr, "Le nombre de pommes doit être entre 1 et %d\n", MAX_POMMES_SIMULTANEES);
+				return EXIT_FAILURE;
 			}
-			else
+		}
+		else if (strcmp(argv[i], "--voronoi") == 0)
+		{
+			voronoi = true;
+		}
+		else if (strcmp(argv[i], "--jps") == 0)
+		{
+			jps = true;
+			if (i + 1 < argc && strcmp(argv[i + 1], "comparer") == 0)
 			{
-				directionSerpentVersObjectif1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, lePlateau, &direction_S1, TROU_HAUT_X, TROU_HAUT_Y, changement_S1);
+				comparerAEtoile = true;
+				i++;
 			}
 		}
-		else if (meilleureDistance_S1 == CHEMIN_BAS) // se dirige vers le trou du bas puis quand il s'est téléporter avance vers la pomme
+		else if (strcmp(argv[i], "--flux") == 0 && i + 1 < argc)
+		{
+			cheminFlux = argv[++i];
+		}
+		else if (strcmp(argv[i], "--serveur") == 0 && i + 1 < argc)
+		{
+			cheminServeur = argv[++i];
+		}
+		else if (strcmp(argv[i], "--hote") == 0 && i + 1 < argc)
 		{
-			if (teleporter_S1)
+			nbPartiesHote = atoi(argv[++i]);
+			if (nbPartiesHote < 1)
 			{
-				
-				directionSerpentVersObjectif1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, lePlateau, &direction_S1, lesPommesX[nbPommesMangee], lesPommesY[nbPommesMangee], changement_S1);
+				fprintf(stderr, "Le nombre de parties hébergées doit être au moins 1\n");
+				return EXIT_FAILURE;
 			}
-			else
+		}
+		else if (strcmp(argv[i], "--jeu-de-donnees") == 0 && i + 2 < argc)
+		{
+			cheminDonnees = argv[++i];
+			nbPartiesDonnees = atoi(argv[++i]);
+			if (nbPartiesDonnees < 1)
 			{
-				directionSerpentVersObjectif1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, lePlateau, &direction_S1, TROU_BAS_X, TROU_BAS_Y, changement_S1);
+				fprintf(stderr, "Le nombre de parties du jeu de données doit être au moins 1\n");
+				return EXIT_FAILURE;
 			}
 		}
-		else if (meilleureDistance_S1 == CHEMIN_GAUCHE) // se dirige vers le trou de gauche puis quand il s'est téléporter avance vers la pomme
+		else if (strcmp(argv[i], "--verifier-journal") == 0 && i + 1 < argc)
 		{
-			if (teleporter_S1)
+			nbPartiesJournal = atoi(argv[++i]);
+			if (nbPartiesJournal < 1)
 			{
-				
-				directionSerpentVersObjectif1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, lePlateau, &direction_S1, lesPommesX[nbPommesMangee], lesPommesY[nbPommesMangee], changement_S1);
+				fprintf(stderr, "Le nombre de parties à vérifier doit être au moins 1\n");
+				return EXIT_FAILURE;
 			}
-			else
+		}
+		else if (strcmp(argv[i], "--verifier-portails") == 0 && i + 1 < argc)
+		{
+			nbPartiesPortails = atoi(argv[++i]);
+			if (nbPartiesPortails < 1)
 			{
-				directionSerpentVersObjectif1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, lePlateau, &direction_S1, TROU_GAUCHE_X, TROU_GAUCHE_Y, changement_S1);
+				fprintf(stderr, "Le nombre de parties à vérifier doit être au moins 1\n");
+				return EXIT_FAILURE;
 			}
 		}
-		else if (meilleureDistance_S1 == CHEMIN_DROITE) // se dirige vers le trou de droite puis quand il s'est téléporter avance vers la pomme
+		else if (strcmp(argv[i], "--politique") == 0 && i + 1 < argc)
+		{
+			cheminPolitique = argv[++i];
+		}
+		else if ((strcmp(argv[i], "--entrainer-politique") == 0 || strcmp(argv[i], "--evaluer-politique") == 0) && i + 2 < argc)
 		{
-			if (teleporter_S1)
+			if (strcmp(argv[i], "--entrainer-politique") == 0)
 			{
-				
-				directionSerpentVersObjectif1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, lePlateau, &direction_S1, lesPommesX[nbPommesMangee], lesPommesY[nbPommesMangee], changement_S1);
+				cheminEntrainement = argv[++i];
 			}
 			else
 			{
-				directionSerpentVersObjectif1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, lePlateau, &direction_S1, TROU_DROITE_X, TROU_DROITE_Y, changement_S1);
+				cheminEvaluation = argv[++i];
+			}
+			nbPartiesPolitique = atoi(argv[++i]);
+			if (nbPartiesPolitique < 1)
+			{
+				fprintf(stderr, "Le nombre de parties de la politique doit être au moins 1\n");
+				return EXIT_FAILURE;
+			}
+			if (cheminEntrainement != NULL && i + 1 < argc && strcmp(argv[i + 1], "octets") == 0)
+			{
+				poidsOctets = true;
+				i++;
 			}
 		}
-		else // sinon se dirige uniquement vers la pomme
+		else if (strcmp(argv[i], "--tournoi") == 0 && i + 1 < argc)
 		{
-			directionSerpentVersObjectif1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, lePlateau, &direction_S1, lesPommesX[nbPommesMangee], lesPommesY[nbPommesMangee], changement_S1);
+			nbGrainesTournoi = atoi(argv[++i]);
+			if (nbGrainesTournoi < 1)
+			{
+				fprintf(stderr, "Le nombre de graines du tournoi doit être au moins 1\n");
+				return EXIT_FAILURE;
+			}
 		}
-
-		progresser1(lesX_S1, lesY_S1, direction_S1, lePlateau, &collision_S1, &pommeMangee_S1, &teleporter_S1, &sortieDuTrou_S1);
-		deplacement_S1++;
-
-
-
-		// appel la fonction qui s'occupe de changer ou non le mode de direction à la sortie d'un trou
-		if(sortieDuTrou_S2){
-			changement_S2 = changementDirection(lesX_S2, lesY_S2, nbPommesMangee, DistancePommePave);
-			sortieDuTrou_S2 = false;
+		else if (strcmp(argv[i], "--graines") == 0 && i + 1 < argc)
+		{
+			cheminGraines = argv[++i];
 		}
-
-		// choisis la direction en fonction de la meilleur distance
-		if (meilleureDistance_S2 == CHEMIN_HAUT) // se dirige vers le trou du haut puis quand il s'est téléporter avance vers la pomme
+		else if (strcmp(argv[i], "--strategies") == 0 && i + 1 < argc)
 		{
-			if (teleporter_S2)
-			{
-				
-				directionSerpentVersObjectif2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, lePlateau, &direction_S2, lesPommesX[nbPommesMangee], lesPommesY[nbPommesMangee], changement_S2);
-			}
-			else
+			strategies = argv[++i];
+		}
+		else if (strcmp(argv[i], "--carte") == 0 && i + 1 < argc)
+		{
+			cheminCarte = argv[++i];
+		}
+		else if (strcmp(argv[i], "--cartes") == 0 && i + 2 < argc)
+		{
+			listeCartes = argv[++i];
+			nbPartiesCartes = atoi(argv[++i]);
+			if (nbPartiesCartes < 1)
 			{
-				directionSerpentVersObjectif2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, lePlateau, &direction_S2, TROU_HAUT_X, TROU_HAUT_Y, changement_S2);
+				fprintf(stderr, "Le nombre de parties par carte doit être au moins 1\n");
+				return EXIT_FAILURE;
 			}
 		}
-		else if (meilleureDistance_S2 == CHEMIN_BAS) // se dirige vers le trou du bas puis quand il s'est téléporter avance vers la pomme
+		else if (strcmp(argv[i], "--hierarchique") == 0 && i + 1 < argc)
 		{
-			if (teleporter_S2)
+			tailleHierarchique = atoi(argv[++i]);
+			if (tailleHierarchique < 2 * TAILLE_SECTEUR || tailleHierarchique > 20000)
 			{
-				
-				directionSerpentVersObjectif2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, lePlateau, &direction_S2, lesPommesX[nbPommesMangee], lesPommesY[nbPommesMangee], changement_S2);
+				fprintf(stderr, "Le côté du plateau doit être entre %d et 20000\n", 2 * TAILLE_SECTEUR);
+				return EXIT_FAILURE;
 			}
-			else
+		}
+		else if (strcmp(argv[i], "--fils") == 0 && i + 1 < argc)
+		{
+			nbFilsHote = atoi(argv[++i]);
+			if (nbFilsHote < 1 || nbFilsHote > MAX_OUVRIERS)
 			{
-				directionSerpentVersObjectif2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, lePlateau, &direction_S2, TROU_BAS_X, TROU_BAS_Y, changement_S2);
+				fprintf(stderr, "Le nombre de fils doit être entre 1 et %d\n", MAX_OUVRIERS);
+				return EXIT_FAILURE;
 			}
 		}
-		else if (meilleureDistance_S2 == CHEMIN_GAUCHE) // se dirige vers le trou de gauche puis quand il s'est téléporter avance vers la pomme
+		else if (strcmp(argv[i], "--periode") == 0 && i + 1 < argc)
 		{
-			if (teleporter_S2)
+			// "MS" ou "MIN:MAX"
+			char *fin;
+			periodeMin = strtol(argv[++i], &fin, 10);
+			periodeMax = (*fin == ':') ? strtol(fin + 1, NULL, 10) : periodeMin;
+			if (periodeMin < 1 || periodeMax < periodeMin)
 			{
-				
-				directionSerpentVersObjectif2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, lePlateau, &direction_S2, lesPommesX[nbPommesMangee], lesPommesY[nbPommesMangee], changement_S2);
+				fprintf(stderr, "Période invalide : %s\n", argv[i]);
+				return EXIT_FAILURE;
 			}
-			else
+		}
+		else if (strcmp(argv[i], "--graine") == 0 && i + 1 < argc)
+		{
+			graine = strtoull(argv[++i], NULL, 10);
+		}
+		else if (strcmp(argv[i], "--ordonnanceur") == 0 && i + 1 < argc)
+		{
+			nbOuvriers = atoi(argv[++i]);
+			if (nbOuvriers < 1 || nbOuvriers > MAX_OUVRIERS)
 			{
-				directionSerpentVersObjectif2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, lePlateau, &direction_S2, TROU_GAUCHE_X, TROU_GAUCHE_Y, changement_S2);
+				fprintf(stderr, "Le nombre d'ouvriers doit être entre 1 et %d\n", MAX_OUVRIERS);
+				return EXIT_FAILURE;
 			}
 		}
-		else if (meilleureDistance_S2 == CHEMIN_DROITE) // se dirige vers le trou de droite puis quand il s'est téléporter avance vers la pomme
+		else
+		{
+			fprintf(stderr, "Option inconnue : %s\n", argv[i]);
+			return EXIT_FAILURE;
+		}
+	}
+	if (modeParallele && nbOuvriers > 0)
+	{
+		fprintf(stderr, "--parallele et --ordonnanceur ne peuvent pas être utilisés ensemble\n");
+		return EXIT_FAILURE;
+	}
+	if (nbPommes > 1 && cheminFlux != NULL)
+	{
+		// un delta de spectateur ne porte qu'une nouvelle pomme par tour
+		fprintf(stderr, "--pommes et --flux ne peuvent pas être utilisés ensemble\n");
+		return EXIT_FAILURE;
+	}
+
+	// départ du calcul du temps CPU
+	clock_t begin = clock();
+
+	// choix du noyau de collision (AVX2, SSE2 ou scalaire)
+	initNoyauCollision();
+
+	// contexte de toutes les parties qui suivent : la carte, s'il y en a une, et ses
+	// portails, la politique chargée par --politique et les stratégies connues
+	static tCarte carte;
+	static tModele politique;
+	static tContexte contexte;
+	if (cheminCarte != NULL && !chargerCarte(cheminCarte, &carte))
+	{
+		return EXIT_FAILURE;
+	}
+	if (cheminPolitique != NULL && !chargerModele(cheminPolitique, &politique))
+	{
+		return EXIT_FAILURE;
+	}
+	initContexte(&contexte, (cheminCarte != NULL) ? &carte : NULL, (cheminPolitique != NULL) ? &politique : NULL);
+	enregistrerStrategie(&contexte, "prudent", directionPrudente);
+
+	// stratégie de chaque serpent hors tournoi, seul choix dynamique de la partie
+	int strategiesJeu[2];
+	strategiesJeu[0] = (cheminPolitique != NULL) ? STRATEGIE_POLITIQUE : voronoi ? STRATEGIE_VORONOI : jps ? STRATEGIE_JPS : STRATEGIE_VERSION4;
+	strategiesJeu[1] = strategiesJeu[0];
+	if (strategies != NULL && nbGrainesTournoi == 0 && !lireStrategies(&contexte, strategies, strategiesJeu))
+	{
+		return EXIT_FAILURE;
+	}
+
+	// mode serveur : aucune partie locale, les parties sont créées par les clients
+	if (cheminServeur != NULL)
+	{
+		return lancerServeur(&contexte, cheminServeur);
+	}
+
+	// mesure du planificateur hiérarchique, sans partie
+	if (tailleHierarchique > 0)
+	{
+		return lancerBancHierarchique(tailleHierarchique, graine);
+	}
+
+	// mode hôte : toutes les parties dans ce processus, sans affichage
+	if (nbPartiesHote > 0)
+	{
+		return lancerHote(&contexte, nbPartiesHote, nbFilsHote, periodeMin, periodeMax, graine, pommesProcedurales, croissance);
+	}
+
+	// politique neuronale : apprentissage ou comparaison, sans partie affichée
+	if (cheminEntrainement != NULL)
+	{
+		return lancerEntrainementPolitique(&contexte, cheminEntrainement, nbPartiesPolitique, graine, poidsOctets);
+	}
+	if (cheminEvaluation != NULL)
+	{
+		return lancerEvaluationPolitique(&contexte, cheminEvaluation, nbPartiesPolitique, graine);
+	}
+
+	// tournoi entre stratégies, sans affichage
+	if (nbGrainesTournoi > 0)
+	{
+		return lancerTournoi(&contexte, nbGrainesTournoi, cheminGraines, graine, nbFilsHote, strategies);
+	}
+
+	// vérification des portails sur une carte intégrée, sans affichage
+	if (nbPartiesPortails > 0)
+	{
+		return lancerVerificationPortails(nbPartiesPortails, graine);
+	}
+
+	// mesure des stratégies sur un ensemble de cartes, sans affichage
+	if (listeCartes != NULL)
+	{
+		return lancerBancCartes(&contexte, listeCartes, nbPartiesCartes, graine, nbFilsHote, strategiesJeu);
+	}
+
+	// jeu de données : parties sans affichage, observations écrites dans un fichier
+	if (cheminDonnees != NULL)
+	{
+		return lancerJeuDeDonnees(&contexte, cheminDonnees, nbPartiesDonnees, graine, pommesProcedurales, croissance, nbPommes, strategiesJeu);
+	}
+
+	// vérification du journal d'annulation, sans affichage
+	if (nbPartiesJournal > 0)
+	{
+		return lancerVerificationJournal(&contexte, nbPartiesJournal, graine, pommesProcedurales, croissance, nbPommes, strategiesJeu);
+	}
+
+	// segment de télémétrie, ouvert avant l'affichage pour que l'erreur reste lisible
+	tSegmentTelemetrie *telemetrie = NULL;
+	tMesures mesures = {0};
+	uint64_t tour = 0;
+	long long latenceDecision = 0;
+	if (nomTelemetrie != NULL)
+	{
+		telemetrie = ouvrirTelemetrie(nomTelemetrie);
+		if (telemetrie == NULL)
+		{
+			return EXIT_FAILURE;
+		}
+	}
+
+	// représente la touche frappée par l'utilisateur : touche de direction ou pour l'arrêt
+	char touche = 0;
+
+	// toute la partie : plateau, serpents, pommes et générateur
+	tEtatJeu etat;
+	initEtatJeu(&etat, &contexte, graine, pommesProcedurales, croissance, nbPommes);
+	etat.comparerAEtoile = comparerAEtoile;
+	etat.serpents[0].strategie = strategiesJeu[0];
+	etat.serpents[1].strategie = strategiesJeu[1];
+	tSerpent *serpent_S1 = &etat.serpents[0];
+	tSerpent *serpent_S2 = &etat.serpents[1];
+
+	// avec un flux de spectateur, le jeu ne touche plus au terminal
+	int flux = -1;
+	tAvantTour avant;
+	tDelta delta;
+	if (cheminFlux != NULL)
+	{
+		flux = ouvrirFlux(cheminFlux, &etat);
+		if (flux < 0)
+		{
+			return EXIT_FAILURE;
+		}
+	}
+	etat.affichage = (flux < 0);
+
+	// les fils sont lancés avant l'affichage, pour qu'un échec laisse le terminal intact
+	bool lances = true;
+
+	// mode parallèle : un fil de décision par serpent, synchronisés à chaque tour
+	// par deux barrières partagées avec le fil principal
+	pthread_barrier_t debutTour, finTour;
+	pthread_t fils[2];
+	bool finPartie = false;
+	tDecideur decideurs[2] = {
+		{1, &etat, &debutTour, &finTour, &finPartie},
+		{2, &etat, &debutTour, &finTour, &finPartie}};
+	if (modeParallele)
+	{
+		pthread_barrier_init(&debutTour, NULL, 3);
+		pthread_barrier_init(&finTour, NULL, 3);
+		for (int i = 0; i < 2 && lances; i++)
 		{
-			if (teleporter_S2)
+			if (pthread_create(&fils[i], NULL, filDecision, &decideurs[i]) != 0)
 			{
-				
-				directionSerpentVersObjectif2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, lePlateau, &direction_S2, lesPommesX[nbPommesMangee], lesPommesY[nbPommesMangee], changement_S2);
+				// le fil du serpent 1, s'il est lancé, attend une barrière qui ne sera
+				// jamais franchie : il est détaché et s'arrête avec le processus
+				fprintf(stderr, "Impossible de lancer le fil de décision du serpent %d\n", i + 1);
+				finPartie = true;
+				if (i == 1)
+				{
+					pthread_detach(fils[0]);
+				}
+				lances = false;
 			}
-			else
+		}
+	}
+
+	// mode ordonnanceur : les décisions des deux serpents sont des tâches du répartiteur,
+	// chacune lançant des sous-tâches de remplissage volées par les ouvriers libres
+	tRepartiteur *repartiteur = NULL;
+	tDecisionTour *tours = NULL;
+	tTache tachesDecision[2];
+	atomic_int groupe = 0;				// décisions du dernier tour pas encore finies
+	if (nbOuvriers > 0)
+	{
+		repartiteur = malloc(sizeof(tRepartiteur));
+		tours = malloc(2 * sizeof(tDecisionTour));
+		if (repartiteur == NULL || tours == NULL)
+		{
+			fprintf(stderr, "Mémoire insuffisante pour le répartiteur\n");
+			lances = false;
+		}
+		else if (!initRepartiteur(repartiteur, nbOuvriers))
+		{
+			lances = false;
+		}
+		else
+		{
+			for (int i = 0; i < 2; i++)
 			{
-				directionSerpentVersObjectif2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, lePlateau, &direction_S2, TROU_DROITE_X, TROU_DROITE_Y, changement_S2);
+				tours[i].decideur = (tDecideur){i + 1, &tours[i].instantane, NULL, NULL, NULL};
 			}
 		}
-		else // sinon se dirige uniquement vers la pomme
+		if (!lances)
 		{
-			changement_S2 = changementDirectionCasIsole(lesX_S2, lesY_S2, lesX_S1, lesY_S1);
-			directionSerpentVersObjectif2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, lePlateau, &direction_S2, lesPommesX[nbPommesMangee], lesPommesY[nbPommesMangee], changement_S2);
+			free(repartiteur);
+			free(tours);
 		}
+	}
+	if (!lances)
+	{
+		if (flux >= 0)
+		{
+			close(flux);
+		}
+		if (telemetrie != NULL)
+		{
+			fermerTelemetrie(telemetrie, nomTelemetrie);
+		}
+		return EXIT_FAILURE;
+	}
+
+	// affichage du plateau (pomme comprise) et des serpents
+	if (etat.affichage)
+	{
+		system("clear");
+		dessinerPlateau(etat.plateau, portailsPartie(&etat));
+		dessinerSerpent1(&serpent_S1->corps);
+		dessinerSerpent2(&serpent_S2->corps);
+		disable_echo();
+	}
 
-		progresser2(lesX_S2, lesY_S2, direction_S2, lePlateau, &collision_S2, &pommeMangee_S2, &teleporter_S2, &sortieDuTrou_S2);
-		deplacement_S2++;
+	// boucle de jeu. Arret si touche STOP, si collision avec une bordure ou
+	// si toutes les pommes sont mangées
+	do
+	{
+		if (flux >= 0)
+		{
+			noterAvantTour(&etat, &avant);
+		}
+		else
+		{
+			printf("Serpent 1 : %d ", serpent_S1->meilleureDistance);
+		}
+		if (modeParallele)
+		{
+			// les deux fils décident en même temps sur l'état du début du tour
+			long long debutDecision = maintenantNano();
+			pthread_barrier_wait(&debutTour);
+			pthread_barrier_wait(&finTour);
+			latenceDecision = maintenantNano() - debutDecision;
 
-		// Ajoute une pomme au compteur de pomme quand elle est mangée et arrete le jeu si score atteint 10
-		if (pommeMangee_S1 || pommeMangee_S2)
+			// les déplacements sont appliqués ensemble, après résolution des conflits
+			resoudreConflits(&etat, NULL);
+			progresser1(&etat, NULL);
+			progresser2(&etat, NULL);
+			serpent_S1->deplacements++;
+			serpent_S2->deplacements++;
+		}
+		else if (repartiteur != NULL)
 		{
-			nbPommesMangee++;
-			if (pommeMangee_S1){
-				nbPommesMangee_S1++;
-			}
-			else if (pommeMangee_S2){
-				nbPommesMangee_S2++;
+			// les décisions annulées au tour précédent ont eu la pause pour s'arrêter ;
+			// leurs instantanés ne sont réutilisés qu'une fois qu'elles ont toutes fini
+			surveillerGroupe(repartiteur, &groupe, 0);
+
+			// chaque décision part de son instantané du début du tour et est volée par un
+			// ouvrier. Celles qui ne sont pas prises avant l'échéance sont annulées : le tour
+			// est joué sans les attendre et les serpents concernés gardent leur direction.
+			long long echeance = maintenantMicro() + ATTENTE;
+			long long debutDecision = maintenantNano();
+			atomic_store(&groupe, 2);
+			for (int i = 0; i < 2; i++)
+			{
+				tours[i].instantane = etat;
+				tours[i].generation = atomic_load(&repartiteur->generation);
+				tours[i].echeance = echeance;
+				atomic_store(&tours[i].issue, DECISION_EN_COURS);
+				tachesDecision[i] = (tTache){tacheDecision, &tours[i], &groupe};
+				soumettreTache(repartiteur, 0, &tachesDecision[i]);
 			}
-			gagne = (nbPommesMangee == NB_POMMES);
-			teleporter_S1 = false; // remet en false pour pouvoir se retéléporter après avoir manger une pomme
-			teleporter_S2 = false;
-			changement_S1 = false;
-			changement_S2 = false;
-			sortieDuTrou_S1 = false;
-			sortieDuTrou_S2 = false;
-
-			if (!gagne)
+			surveillerGroupe(repartiteur, &groupe, echeance);
+			for (int i = 0; i < 2; i++)
 			{
-				ajouterPomme(lePlateau, nbPommesMangee);
-				meilleureDistance_S1 = calculerDistance1(lesX_S1, lesY_S1, lesPommesX[nbPommesMangee], lesPommesY[nbPommesMangee]); // recalcul la meilleur position après l'apparition d'une nouvelle pomme
-				meilleureDistance_S2 = calculerDistance2(lesX_S2, lesY_S2, lesPommesX[nbPommesMangee], lesPommesY[nbPommesMangee]); // recalcul la meilleur position après l'apparition d'une nouvelle pomme
-				DistancePommePave = calculerDistancePommePave(lesPommesX[nbPommesMangee], lesPommesY[nbPommesMangee]); // recalcul quel pave est le plus proche de la pomme
-				if(meilleureDistance_S1 == CHEMIN_POMME){
-					changement_S1 = changementDirection(lesX_S1, lesY_S1, nbPommesMangee, DistancePommePave);
-					teleporter_S1 = true;
-				}
-				if(meilleureDistance_S2 == CHEMIN_POMME){
-					changement_S2 = changementDirection(lesX_S2, lesY_S2, nbPommesMangee, DistancePommePave);
-					teleporter_S2 = true;
+				int enCours = DECISION_EN_COURS;
+				if (!atomic_compare_exchange_strong(&tours[i].issue, &enCours, DECISION_ANNULEE))
+				{
+					etat.serpents[i] = tours[i].instantane.serpents[i];
 				}
-				pommeMangee_S1 = false;
-				pommeMangee_S2 = false;
+			}
+			latenceDecision = maintenantNano() - debutDecision;
+
+			resoudreConflits(&etat, NULL);
+			progresser1(&etat, NULL);
+			progresser2(&etat, NULL);
+			serpent_S1->deplacements++;
+			serpent_S2->deplacements++;
+		}
+		else
+		{
+			// le serpent 2 décide après le déplacement du serpent 1
+			long long debutDecision = maintenantNano();
+			deciderSerpent(&etat, 1, &serpent_S1->direction, &serpent_S1->changement, &serpent_S1->sortieDuTrou);
+			latenceDecision = maintenantNano() - debutDecision;
+			progresser1(&etat, NULL);
+			serpent_S1->deplacements++;
+
+			debutDecision = maintenantNano();
+			deciderSerpent(&etat, 2, &serpent_S2->direction, &serpent_S2->changement, &serpent_S2->sortieDuTrou);
+			latenceDecision += maintenantNano() - debutDecision;
+			progresser2(&etat, NULL);
+			serpent_S2->deplacements++;
+		}
+
+		// Ajoute une pomme au compteur de pomme quand elle est mangée et arrete le jeu si score atteint 10
+		if (serpent_S1->pommeMangee || serpent_S2->pommeMangee)
+		{
+			traiterPommeMangee(&etat, NULL);
+		}
+		tour++;
+		if (telemetrie != NULL)
+		{
+			mesurerPartie(&etat, tour, latenceDecision, &mesures);
+			publierMesures(telemetrie, &mesures);
+		}
+		if (flux >= 0)
+		{
+			coderDelta(&etat, &avant, &delta);
+			if (!publierDelta(flux, &delta))
+			{
+				// plus aucun lecteur : la partie continue sans flux
+				close(flux);
+				flux = -2;
 			}
 		}
-		if (!gagne)
+		if (!etat.gagne)
 		{
-			if (!collision_S1 && !collision_S2)
+			if (!serpent_S1->collision && !serpent_S2->collision)
 			{
 				usleep(ATTENTE);
-				if (kbhit() == 1)
+				if (etat.affichage && kbhit() == 1)
 				{
 					touche = getchar();
 				}
 			}
 		}
-	} while (touche != STOP && !collision_S1 && !collision_S2 && !gagne);
-	enable_echo();
-	gotoxy(1, HAUTEUR_PLATEAU + 1);
+	} while (touche != STOP && !serpent_S1->collision && !serpent_S2->collision && !etat.gagne
+			 && (cheminCarte == NULL || serpent_S1->deplacements < LIMITE_TOURS_CARTE));
+
+	if (modeParallele)
+	{
+		// libère les fils bloqués sur la barrière de début de tour
+		finPartie = true;
+		pthread_barrier_wait(&debutTour);
+		for (int i = 0; i < 2; i++)
+		{
+			pthread_join(fils[i], NULL);
+		}
+		pthread_barrier_destroy(&debutTour);
+		pthread_barrier_destroy(&finTour);
+	}
+	if (repartiteur != NULL)
+	{
+		surveillerGroupe(repartiteur, &groupe, 0);
+		arreterRepartiteur(repartiteur);
+		free(repartiteur);
+		free(tours);
+	}
+	if (telemetrie != NULL)
+	{
+		// dernières mesures : le moniteur voit la fin de la partie
+		mesures.enCours = 0;
+		publierMesures(telemetrie, &mesures);
+		fermerTelemetrie(telemetrie, nomTelemetrie);
+	}
+	if (flux >= 0)
+	{
+		close(flux);
+	}
+	if (etat.affichage)
+	{
+		enable_echo();
+		gotoxy(1, HAUTEUR_PLATEAU + 1);
+	}
 
 	clock_t end = clock(); // fin du calcul du temps CPU
 	double tmpsCPU = ((end - begin) * 1.0) / CLOCKS_PER_SEC;
 
 	// afficher les performances du programme
 	printf("Temps CPU = %.3f secondes\n", tmpsCPU);
-	printf("Le serpent 1 s'est déplacer %d fois et à mangé %d pommes\n", deplacement_S1, nbPommesMangee_S1);
-	printf("Le serpent 2 s'est déplacer %d fois et à mangé %d pommes\n", deplacement_S2, nbPommesMangee_S2);
+	printf("Graine de la partie : %llu\n", (unsigned long long)graine);
+	if (!partieFinie(&etat) && serpent_S1->deplacements >= LIMITE_TOURS_CARTE && cheminCarte != NULL)
+	{
+		printf("Partie arrêtée après %d tours\n", LIMITE_TOURS_CARTE);
+	}
+	printf("Le serpent 1 s'est déplacer %d fois et à mangé %d pommes\n", serpent_S1->deplacements, serpent_S1->nbPommesMangees);
+	printf("Le serpent 2 s'est déplacer %d fois et à mangé %d pommes\n", serpent_S2->deplacements, serpent_S2->nbPommesMangees);
+	int recherches = serpent_S1->recherchesJPS + serpent_S2->recherchesJPS;
+	if (recherches > 0)
+	{
+		printf("Recherche par points de saut : %d recherches, %.1f cases développées par recherche",
+			   recherches, (double)(serpent_S1->expansionsJPS + serpent_S2->expansionsJPS) / recherches);
+		if (comparerAEtoile)
+		{
+			printf(" contre %.1f pour A*", (double)(serpent_S1->expansionsAEtoile + serpent_S2->expansionsAEtoile) / recherches);
+		}
+		printf("\n");
+	}
 
 	return EXIT_SUCCESS;
 }
@@ -388,97 +740,281 @@ int main()
 /************************************************/
 
 /**
- * @brief Initialise le plateau de jeu avec les bordures et des pavés aléatoires.
- * @param plateau de type tPlateau, qui donne en Entrée le plateau du jeu.
+ * @brief Procédure qui met en place une partie complète dans etat : plateau et pavés,
+ * serpents à leur position de départ, index des cases libres et premières pommes.
+ * Rien n'est affiché : l'appelant active etat->affichage et dessine le plateau s'il le souhaite.
+ * @param etat de type tEtatJeu, Sortie : la partie initialisée
+ * @param contexte de type tContexte, Entrée : la carte et les portails de la partie, qui
+ * doivent rester en place jusqu'à la fin de la partie
+ * @param graine de type uint64_t, Entrée : la graine du générateur de la partie
+ * @param pommesProcedurales de type bool, Entrée : true pour tirer chaque pomme parmi les cases libres
+ * @param croissance de type bool, Entrée : true pour que les serpents grandissent, sans limite de pommes
+ * @param nbPommes de type int, Entrée : le nombre de pommes présentes en même temps (1 à MAX_POMMES_SIMULTANEES)
  */
-void initPlateau(tPlateau plateau)
+void initEtatJeu(tEtatJeu *etat, const tContexte *contexte, uint64_t graine, bool pommesProcedurales, bool croissance, int nbPommes)
 {
-	// initialisation du plateau avec des espaces
-	for (int i = 1; i <= LARGEUR_PLATEAU; i++)
+	memset(etat, 0, sizeof(*etat));
+	etat->contexte = contexte;
+	etat->pommesProcedurales = pommesProcedurales;
+	etat->croissance = croissance;
+	etat->nbPommesPlateau = nbPommes;
+	initGenerateur(&etat->generateur, graine);
+
+	if (contexte->carte != NULL)
 	{
-		for (int j = 1; j <= HAUTEUR_PLATEAU; j++)
+		// plateau, pavés, pommes et départs de la carte du contexte
+		const tCarte *carte = contexte->carte;
+		memcpy(etat->plateau, carte->plateau, sizeof(tPlateau));
+		etat->nbPaves = carte->nbPaves;
+		memcpy(etat->lesPavesX, carte->lesPavesX, carte->nbPaves * sizeof(int));
+		memcpy(etat->lesPavesY, carte->lesPavesY, carte->nbPaves * sizeof(int));
+		etat->nbPommesPrevues = carte->nbPommes;
+		memcpy(etat->lesPommesX, carte->lesPommesX, carte->nbPommes * sizeof(int));
+		memcpy(etat->lesPommesY, carte->lesPommesY, carte->nbPommes * sizeof(int));
+		for (int s = 0; s < 2; s++)
 		{
-			plateau[i][j] = VIDE;
+			int d = carte->directions[s];
+			initCorps(&etat->serpents[s].corps, carte->departX[s], carte->departY[s], -DECALAGE_X[d], -DECALAGE_Y[d]);
+			etat->serpents[s].direction = LES_DIRECTIONS[d];
 		}
 	}
-	// Mise en place la bordure autour du plateau
-	// première ligne
-	for (int i = 1; i <= LARGEUR_PLATEAU; i++)
+	else
 	{
-		plateau[i][1] = BORDURE;
-		plateau[LARGEUR_PLATEAU / 2][1] = VIDE; // trou du haut
+		memcpy(etat->lesPommesX, POMMES_X, sizeof(POMMES_X));
+		memcpy(etat->lesPommesY, POMMES_Y, sizeof(POMMES_Y));
+		etat->nbPommesPrevues = NB_POMMES;
+		memcpy(etat->lesPavesX, PAVES_X, sizeof(PAVES_X));
+		memcpy(etat->lesPavesY, PAVES_Y, sizeof(PAVES_Y));
+		etat->nbPaves = NB_PAVES;
+
+		// mise en place du plateau
+		initPlateau(etat->plateau, etat->lesPavesX, etat->lesPavesY, etat->nbPaves);
+
+		// initialisation de la position du serpent 1 : positionnement de la
+		// tête en (X_INITIAL_SERPENT1, Y_INITIAL_SERPENT1), puis des anneaux à sa gauche
+		initCorps(&etat->serpents[0].corps, X_INITIAL_SERPENT1, Y_INITIAL_SERPENT1, -1, 0);
+		initCorps(&etat->serpents[1].corps, X_INITIAL_SERPENT1, Y_INITIAL_SERPENT2, 1, 0);
+		// initialisation : le serpent 1 se dirige vers la DROITE, le serpent 2 vers la GAUCHE
+		etat->serpents[0].direction = DROITE;
+		etat->serpents[1].direction = GAUCHE;
 	}
-	// lignes intermédiaires
-	for (int j = 1; j <= HAUTEUR_PLATEAU; j++)
+	etat->serpents[0].strategie = etat->serpents[1].strategie = STRATEGIE_VERSION4;
+
+	initCasesLibres(&etat->casesLibres, etat->plateau);
+	// un bout de portail reste occupé pour toute la partie : aucune pomme n'y apparaît
+	for (int b = 0; b < 2 * contexte->portails.nbPaires; b++)
 	{
-		plateau[1][j] = BORDURE;
-		plateau[1][HAUTEUR_PLATEAU / 2] = VIDE; // trou de gauche
-		plateau[LARGEUR_PLATEAU][j] = BORDURE;
-		plateau[LARGEUR_PLATEAU][HAUTEUR_PLATEAU / 2] = VIDE; // trou de droite
+		int c = contexte->portails.bouts[b];
+		occuperCase(&etat->casesLibres, c / (HAUTEUR_PLATEAU + 1), c % (HAUTEUR_PLATEAU + 1), NULL);
 	}
-	// dernière ligne
-	for (int i = 1; i <= LARGEUR_PLATEAU; i++)
+	for (int s = 0; s < 2; s++)
+	{
+		for (int i = 0; i < TAILLE; i++)
+		{
+			occuperCase(&etat->casesLibres, anneauxX(&etat->serpents[s].corps)[i], anneauxY(&etat->serpents[s].corps)[i], NULL);
+		}
+	}
+	// les pommes suivant la première, prévue, sont tirées parmi les cases libres
+	for (int p = 0; p < nbPommes; p++)
 	{
-		plateau[i][HAUTEUR_PLATEAU] = BORDURE;
-		plateau[LARGEUR_PLATEAU / 2][HAUTEUR_PLATEAU] = VIDE; // trou du bas
+		ajouterPomme(etat, NULL);
 	}
 
-	for (int p = 0; p < NB_PAVES; p++) {
-		int xPave, yPave;
-		// Générer des coordonnées aléatoires pour le pavé
-		xPave = lesPavesX[p];
-    	yPave = lesPavesY[p];;
+	// calcul les meilleures distance à l'initialisation
+	etat->serpents[0].meilleureDistance = calculerDistance1(anneauxX(&etat->serpents[0].corps), anneauxY(&etat->serpents[0].corps), etat->pommeX, etat->pommeY, &contexte->portails);
+	etat->serpents[1].meilleureDistance = calculerDistance2(anneauxX(&etat->serpents[1].corps), anneauxY(&etat->serpents[1].corps), etat->pommeX, etat->pommeY, &contexte->portails);
+	etat->DistancePommePave = calculerDistancePommePave(etat);
+}
+
+/**
+ * @brief Initialise le plateau de jeu avec les bordures et des pavés aléatoires.
+ * @param plateau de type tPlateau, qui donne en Entrée le plateau du jeu.
+ * @param pavesX de type int tableau, Entrée : les X des coins haut-gauche des pavés
+ * @param pavesY de type int tableau, Entrée : les Y des coins haut-gauche des pavés
+ * @param nbPaves de type int, Entrée : le nombre de pavés
+ */
+void initPlateau(tPlateau plateau, const int pavesX[], const int pavesY[], int nbPaves)
+{
+	initCasesPlateau(&GEOMETRIE_PLATEAU, &plateau[0][0], pavesX, pavesY, nbPaves);
+}
 
-		// Dessiner le pavé sur le plateau
-        for (int i = 0; i < TAILLE_PAVE; i++) {
-            for (int j = 0; j < TAILLE_PAVE; j++) {
-                plateau[xPave + i][yPave + j] = BORDURE;  // Dessine le pavé
-            }
-        }
-    }
+/**
+ * @brief Initialise un plateau à plat de dimensions quelconques, avec le noyau
+ * spécialisé quand les dimensions sont celles du jeu.
+ * @param geo de type tGeometrie, Entrée : les dimensions du plateau
+ * @param cases de type char tableau, Sortie : les (largeur + 1) * (hauteur + 1) cases du plateau
+ * @param pavesX de type int tableau, Entrée : les X des coins haut-gauche des pavés
+ * @param pavesY de type int tableau, Entrée : les Y des coins haut-gauche des pavés
+ * @param nbPaves de type int, Entrée : le nombre de pavés
+ */
+void initCasesPlateau(const tGeometrie *geo, char *cases, const int pavesX[], const int pavesY[], int nbPaves)
+{
+	if (geo->largeur == LARGEUR_PLATEAU && geo->hauteur == HAUTEUR_PLATEAU)
+	{
+		initCases_80x40(geo, cases, pavesX, pavesY, nbPaves);
+	}
+	else
+	{
+		initCases_generique(geo, cases, pavesX, pavesY, nbPaves);
+	}
 }
 
 /**
  * @brief Dessine l'ensemble du plateau de jeu dans le terminal.
  * @param plateau de type tPlateau, qui donne en Entrée le plateau du jeu.
+ * @param portails de type tPortails, Entrée : les portails de la partie, ou NULL
  */
-void dessinerPlateau(tPlateau plateau)
+void dessinerPlateau(tPlateau plateau, const tPortails *portails)
 {
-	// affiche à l'écran le contenu du tableau 2D représentant le plateau
+	// affiche à l'écran le contenu du tableau 2D représentant le plateau, portails compris
 	for (int i = 1; i <= LARGEUR_PLATEAU; i++)
 	{
 		for (int j = 1; j <= HAUTEUR_PLATEAU; j++)
 		{
-			afficher(i, j, plateau[i][j]);
+			bool portail = portails != NULL && plateau[i][j] == VIDE && portails->sorties[cellule_80x40(&GEOMETRIE_PLATEAU, i, j)] != 0;
+			afficher(i, j, portail ? PORTAIL : plateau[i][j]);
 		}
 	}
 }
 
 /**
- * @brief Ajoute une pomme dans une case libre du plateau.
- * @param plateau de type tPlateau, qui donne en Entrée le plateau du jeu.
- * @param iPomme de type int, qui donne la coordonnée de la prochaine pomme.
+ * @brief Ajoute une pomme dans une case libre du plateau : la prochaine pomme prévue
+ * (lesPommesX/lesPommesY), ou une case tirée parmi les cases libres si les pommes sont
+ * procédurales, si la case prévue est prise ou si toutes les pommes prévues sont passées.
+ * @param etat de type tEtatJeu, Entrée/Sortie : la partie, dont pommeX/pommeY reçoivent la pomme ajoutée
+ * @param journal de type tJournal, Entrée/Sortie : le journal d'annulation, ou NULL
+ * @return false si aucune case n'est libre pour la pomme
  */
-void ajouterPomme(tPlateau plateau, int iPomme)
+bool ajouterPomme(tEtatJeu *etat, tJournal *journal)
 {
-	// génère aléatoirement la position d'une pomme,
-	// vérifie que ça correspond à une case vide
-	// du plateau puis l'ajoute au plateau et l'affiche
-	int xPomme, yPomme;
-	do
+	tCasesLibres *casesLibres = &etat->casesLibres;
+	int iPomme = etat->nbPommesMangee;
+
+	if (casesLibres->nbLibres == 0)
+	{
+		return false;
+	}
+	NOTER(journal, etat->pommeX);
+	NOTER(journal, etat->pommeY);
+	if (!etat->pommesProcedurales && iPomme < etat->nbPommesPrevues && etat->plateau[etat->lesPommesX[iPomme]][etat->lesPommesY[iPomme]] == VIDE)
+	{
+		etat->pommeX = etat->lesPommesX[iPomme];
+		etat->pommeY = etat->lesPommesY[iPomme];
+	}
+	else
 	{
-		xPomme = lesPommesX[iPomme];
-		yPomme = lesPommesY[iPomme];
-	} while (plateau[xPomme][yPomme] != ' ');
-	plateau[xPomme][yPomme] = POMME;
-	afficher(xPomme, yPomme, POMME);
+		// tirage uniforme parmi les cases libres, aussi utilisé si la case prévue est prise
+		NOTER(journal, etat->generateur);
+		int c = casesLibres->dense[tirerBorne(&etat->generateur, casesLibres->nbLibres)];
+		etat->pommeX = c / (HAUTEUR_PLATEAU + 1);
+		etat->pommeY = c % (HAUTEUR_PLATEAU + 1);
+	}
+	NOTER(journal, etat->plateau[etat->pommeX][etat->pommeY]);
+	etat->plateau[etat->pommeX][etat->pommeY] = POMME;
+	occuperCase(casesLibres, etat->pommeX, etat->pommeY, journal);
+	if (etat->affichage)
+	{
+		afficher(etat->pommeX, etat->pommeY, POMME);
+	}
+	return true;
 }
 
 /**
- * @brief Procédure qui va aux coordonées X et Y, et qui affiche le caractere c entré en parametre
- * @param x de type int, Entrée : la coordonnée de x
- * @param y de type int, Entrée : la coordonnée de y
- * @param c de type char, Entrée : le caractere a afficher
+ * @brief Procédure qui construit l'index des cases libres : toutes les cases du plateau
+ * qui ne sont pas des murs, encore inoccupées.
+ * @param casesLibres de type tCasesLibres, Sortie : l'index à construire
+ * @param plateau de type tPlateau, qui donne en Entrée le plateau du jeu
+ */
+void initCasesLibres(tCasesLibres *casesLibres, tPlateau plateau)
+{
+	casesLibres->nbLibres = 0;
+	for (int c = 0; c < NB_CASES; c++)
+	{
+		casesLibres->position[c] = -1;
+		casesLibres->occupation[c] = 0;
+	}
+	for (int x = 1; x <= LARGEUR_PLATEAU; x++)
+	{
+		for (int y = 1; y <= HAUTEUR_PLATEAU; y++)
+		{
+			if (plateau[x][y] != BORDURE)
+			{
+				int c = cellule_80x40(&GEOMETRIE_PLATEAU, x, y);
+				casesLibres->position[c] = casesLibres->nbLibres;
+				casesLibres->dense[casesLibres->nbLibres++] = c;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Procédure qui échange dans l'index dense la case c avec la case à l'indice donné.
+ */
+void echangerCases(tCasesLibres *casesLibres, int c, int indice, tJournal *journal)
+{
+	int autre = casesLibres->dense[indice];
+	int ancien = casesLibres->position[c];
+	NOTER(journal, casesLibres->dense[indice]);
+	NOTER(journal, casesLibres->position[c]);
+	NOTER(journal, casesLibres->dense[ancien]);
+	NOTER(journal, casesLibres->position[autre]);
+	casesLibres->dense[indice] = c;
+	casesLibres->position[c] = indice;
+	casesLibres->dense[ancien] = autre;
+	casesLibres->position[autre] = ancien;
+}
+
+/**
+ * @brief Procédure qui pose un élément (anneau ou pomme) sur la case (x, y) ; la case
+ * quitte l'index des cases libres quand elle reçoit son premier élément.
+ * @param casesLibres de type tCasesLibres, Entrée/Sortie : l'index des cases libres
+ * @param x de type int, Entrée : la coordonnée en X de la case
+ * @param y de type int, Entrée : la coordonnée en Y de la case
+ * @param journal de type tJournal, Entrée/Sortie : le journal d'annulation, ou NULL
+ */
+void occuperCase(tCasesLibres *casesLibres, int x, int y, tJournal *journal)
+{
+	int c = cellule_80x40(&GEOMETRIE_PLATEAU, x, y);
+	if (casesLibres->position[c] < 0)
+	{
+		return; // mur : hors de l'index
+	}
+	NOTER(journal, casesLibres->occupation[c]);
+	NOTER(journal, casesLibres->nbLibres);
+	if (casesLibres->occupation[c]++ == 0)
+	{
+		echangerCases(casesLibres, c, --casesLibres->nbLibres, journal);
+	}
+}
+
+/**
+ * @brief Procédure qui retire un élément de la case (x, y) ; la case revient dans
+ * l'index des cases libres quand elle n'a plus aucun élément.
+ * @param casesLibres de type tCasesLibres, Entrée/Sortie : l'index des cases libres
+ * @param x de type int, Entrée : la coordonnée en X de la case
+ * @param y de type int, Entrée : la coordonnée en Y de la case
+ * @param journal de type tJournal, Entrée/Sortie : le journal d'annulation, ou NULL
+ */
+void libererCase(tCasesLibres *casesLibres, int x, int y, tJournal *journal)
+{
+	int c = cellule_80x40(&GEOMETRIE_PLATEAU, x, y);
+	if (casesLibres->position[c] < 0)
+	{
+		return; // mur : hors de l'index
+	}
+	NOTER(journal, casesLibres->occupation[c]);
+	NOTER(journal, casesLibres->nbLibres);
+	if (casesLibres->occupation[c] > 0 && --casesLibres->occupation[c] == 0)
+	{
+		echangerCases(casesLibres, c, casesLibres->nbLibres++, journal);
+	}
+}
+
+/**
+ * @brief Procédure qui va aux coordonées X et Y, et qui affiche le caractere c entré en parametre
+ * @param x de type int, Entrée : la coordonnée de x
+ * @param y de type int, Entrée : la coordonnée de y
+ * @param c de type char, Entrée : le caractere a afficher
  */
 void afficher(int x, int y, char car)
 {
@@ -489,25 +1025,103 @@ void afficher(int x, int y, char car)
 
 /**
  * @brief Procédure qui va aux coordonées X et Y, et qui affiche un espace pour effacer un caractere
+ * (ou le portail qui était sous le serpent)
  * @param x de type int, Entrée : la coordonnée de x
  * @param y de type int, Entrée : la coordonnée de y
+ * @param portails de type tPortails, Entrée : les portails de la partie, ou NULL
  */
-void effacer(int x, int y)
+void effacer(int x, int y, const tPortails *portails)
 {
 	gotoxy(x, y);
-	printf(" ");
+	printf("%c", (portails != NULL && portails->sorties[cellule_80x40(&GEOMETRIE_PLATEAU, x, y)] != 0) ? PORTAIL : VIDE);
 	gotoxy(1, 1);
 }
 
+/**
+ * @brief Procédure qui place les TAILLE anneaux d'un serpent en ligne, la tête en
+ * (xTete, yTete), au fond du tampon pour laisser la place aux déplacements
+ * @param corps de type tCorps, Sortie : le corps initialisé
+ * @param xTete de type int, Entrée : les coordonnées en X de la tête
+ * @param yTete de type int, Entrée : les coordonnées en Y de la tête
+ * @param pasX de type int, Entrée : l'écart en X d'un anneau au suivant (-1, 0 ou 1)
+ * @param pasY de type int, Entrée : l'écart en Y d'un anneau au suivant (-1, 0 ou 1)
+ */
+void initCorps(tCorps *corps, int xTete, int yTete, int pasX, int pasY)
+{
+	corps->tete = CAPACITE_CORPS - TAILLE;
+	corps->taille = TAILLE;
+	corps->aGrandir = 0;
+	for (int i = 0; i < TAILLE; i++)
+	{
+		corps->lesX[corps->tete + i] = xTete + i * pasX;
+		corps->lesY[corps->tete + i] = yTete + i * pasY;
+	}
+}
+
+/**
+ * @brief Fonction qui donne les X des anneaux, la tête en premier
+ * @param corps de type tCorps, Entrée : le corps du serpent
+ * @return le tableau des X de corps->taille éléments
+ */
+int *anneauxX(tCorps *corps)
+{
+	return &corps->lesX[corps->tete];
+}
+
+/**
+ * @brief Fonction qui donne les Y des anneaux, la tête en premier
+ * @param corps de type tCorps, Entrée : le corps du serpent
+ * @return le tableau des Y de corps->taille éléments
+ */
+int *anneauxY(tCorps *corps)
+{
+	return &corps->lesY[corps->tete];
+}
+
+/**
+ * @brief Procédure qui pose une nouvelle tête devant l'ancienne. Sans croissance, le
+ * dernier anneau sort du corps ; avec croissance, il reste et la taille augmente.
+ * @param corps de type tCorps, Entrée/Sortie : le corps du serpent
+ * @param x de type int, Entrée : les coordonnées en X de la nouvelle tête
+ * @param y de type int, Entrée : les coordonnées en Y de la nouvelle tête
+ * @param grandir de type bool, Entrée : true si le serpent grandit d'un anneau
+ * @param journal de type tJournal, Entrée/Sortie : le journal d'annulation, ou NULL
+ */
+void ajouterTete(tCorps *corps, int x, int y, bool grandir, tJournal *journal)
+{
+	NOTER(journal, corps->tete);
+	if (corps->tete == 0)
+	{
+		// plus de place devant la tête : recopie du corps au fond du tampon
+		int debut = CAPACITE_CORPS - corps->taille;
+		noterRecopieCorps(journal, corps, debut);
+		memmove(&corps->lesX[debut], corps->lesX, corps->taille * sizeof(int));
+		memmove(&corps->lesY[debut], corps->lesY, corps->taille * sizeof(int));
+		corps->tete = debut;
+	}
+	corps->tete--;
+	NOTER(journal, corps->lesX[corps->tete]);
+	NOTER(journal, corps->lesY[corps->tete]);
+	corps->lesX[corps->tete] = x;
+	corps->lesY[corps->tete] = y;
+	if (grandir)
+	{
+		NOTER(journal, corps->taille);
+		corps->taille++;
+	}
+}
+
 /**
  * @brief Procédure qui affiche le corps du serpent, 'O' pour la tete et 'X' pour le corps
- * @param lesX de type int tableau, Entrée : le tableau des X de N élément
- * @param lesY de type int tableau, Entrée : le tableau des Y de N élément
+ * @param corps de type tCorps, Entrée : le corps du serpent
  */
-void dessinerSerpent1(int lesX[], int lesY[])
+void dessinerSerpent1(tCorps *corps)
 {
+	int *lesX = anneauxX(corps);
+	int *lesY = anneauxY(corps);
+
 	// affiche les anneaux puis la tête
-	for (int i = 1; i < TAILLE; i++)
+	for (int i = 1; i < corps->taille; i++)
 	{
 		afficher(lesX[i], lesY[i], CORPS);
 	}
@@ -516,13 +1130,15 @@ void dessinerSerpent1(int lesX[], int lesY[])
 
 /**
  * @brief Procédure qui affiche le corps du serpent, 'O' pour la tete et 'X' pour le corps
- * @param lesX de type int tableau, Entrée : le tableau des X de N élément
- * @param lesY de type int tableau, Entrée : le tableau des Y de N élément
+ * @param corps de type tCorps, Entrée : le corps du serpent
  */
-void dessinerSerpent2(int lesX[], int lesY[])
+void dessinerSerpent2(tCorps *corps)
 {
+	int *lesX = anneauxX(corps);
+	int *lesY = anneauxY(corps);
+
 	// affiche les anneaux puis la tête
-	for (int i = 1; i < TAILLE; i++)
+	for (int i = 1; i < corps->taille; i++)
 	{
 		afficher(lesX[i], lesY[i], CORPS);
 	}
@@ -531,683 +1147,3024 @@ void dessinerSerpent2(int lesX[], int lesY[])
 
 /**
  * @brief Procédure qui choisit la direction la plus optimiser et courte pour atteindre l'objectif
- * @param lesX de type int tableau, Entrée : le tableau des X de N élément
- * @param lesY de type int tableau, Entrée : le tableau des Y de N élément
+ * @param corps_S1 de type tCorps, Entrée : le corps du serpent qui se déplace
+ * @param corps_S2 de type tCorps, Entrée : le corps de l'autre serpent
+ * @param plateau de type tPlateau, qui donne en Entrée le plateau du jeu
+ * @param portails de type tPortails, Entrée : les portails de la partie, ou NULL
+ * @param direction de type char, Entrée/Sortie : la direction du serpent attribuée aux touches 'z' 'q' 's' 'd'
+ * @param objectifX de type int, Entrée : les coordonnées en X de l'objecif à atteindre
+ * @param objectifY de type int, Entrée : les coordonnées en Y de l'objecif à atteindre
+ * @param changement de type bool, Entre : l'etat (true/false) de la variable "changement" dans le main
+ */
+void directionSerpentVersObjectif1(tCorps *corps_S1, tCorps *corps_S2, tPlateau plateau, const tPortails *portails, char *direction, int objectifX, int objectifY, bool changement)
+{
+	int rang[4], scores[4];
+
+	// ordre de préférence des directions : verticalité d'abord, ou horizontalité si changement
+	rangDirections(objectifX - anneauxX(corps_S1)[0], objectifY - anneauxY(corps_S1)[0], changement, *direction, rang);
+	// évalue les quatre directions en une passe puis garde la meilleure
+	evaluerDirections(corps_S1, corps_S2, plateau, portails, objectifX, objectifY, rang, scores);
+	*direction = LES_DIRECTIONS[meilleureDirection(scores)];
+}
+
+/**
+ * @brief Procédure qui choisit la direction la plus optimiser et courte pour atteindre l'objectif
+ * @param corps_S2 de type tCorps, Entrée : le corps du serpent qui se déplace
+ * @param corps_S1 de type tCorps, Entrée : le corps de l'autre serpent
  * @param plateau de type tPlateau, qui donne en Entrée le plateau du jeu
+ * @param portails de type tPortails, Entrée : les portails de la partie, ou NULL
  * @param direction de type char, Entrée/Sortie : la direction du serpent attribuée aux touches 'z' 'q' 's' 'd'
  * @param objectifX de type int, Entrée : les coordonnées en X de l'objecif à atteindre
  * @param objectifY de type int, Entrée : les coordonnées en Y de l'objecif à atteindre
  * @param changement de type bool, Entre : l'etat (true/false) de la variable "changement" dans le main
  */
-void directionSerpentVersObjectif1(int lesX_S1[], int lesY_S1[], int lesX_S2[], int lesY_S2[], tPlateau plateau, char *direction, int objectifX, int objectifY, bool changement)
+void directionSerpentVersObjectif2(tCorps *corps_S2, tCorps *corps_S1, tPlateau plateau, const tPortails *portails, char *direction, int objectifX, int objectifY, bool changement)
+{
+	int rang[4], scores[4];
+
+	// ordre de préférence des directions : verticalité d'abord, ou horizontalité si changement
+	rangDirections(objectifX - anneauxX(corps_S2)[0], objectifY - anneauxY(corps_S2)[0], changement, *direction, rang);
+	// évalue les quatre directions en une passe puis garde la meilleure
+	evaluerDirections(corps_S2, corps_S1, plateau, portails, objectifX, objectifY, rang, scores);
+	*direction = LES_DIRECTIONS[meilleureDirection(scores)];
+}
+
+/**
+ * @brief Procédure qui donne l'objectif du serpent : l'entrée (trou ou portail) du meilleur
+ * chemin tant qu'il ne s'est pas téléporté, la pomme ensuite ou si le chemin direct est le
+ * plus court.
+ * @param portails de type tPortails, Entrée : les portails de la partie et les chemins de l'IA
+ * @param meilleureDistance de type int, Entrée : le meilleur chemin (CHEMIN_HAUT ... CHEMIN_POMME, ou CHEMIN_PORTAIL + k)
+ * @param teleporter de type bool, Entrée : true si le serpent a déjà traversé un trou
+ * @param pommeX de type int, Entrée : les coordonnées en X de la pomme
+ * @param pommeY de type int, Entrée : les coordonnées en Y de la pomme
+ * @param objectifX de type int, Sortie : les coordonnées en X de l'objectif
+ * @param objectifY de type int, Sortie : les coordonnées en Y de l'objectif
+ */
+void choisirObjectif(const tPortails *portails, int meilleureDistance, bool teleporter, int pommeX, int pommeY, int *objectifX, int *objectifY)
+{
+	*objectifX = pommeX;
+	*objectifY = pommeY;
+	int rang = rangDuChemin(meilleureDistance);
+	if (!teleporter && rang >= 0 && rang < portails->nbChemins && portails->entreesX[rang] >= 0)
+	{
+		// se dirige vers l'entrée du chemin : le trou d'un côté, ou un bout de portail
+		*objectifX = portails->entreesX[rang];
+		*objectifY = portails->entreesY[rang];
+	}
+}
+
+/**
+ * @brief Procédure qui prend la décision d'un serpent pour le tour selon sa stratégie.
+ * C'est le seul point d'entrée des décisions : le jeu, les fils de décision, l'ordonnanceur
+ * et toutes les parties sans affichage passent par elle. Les stratégies intégrées sont
+ * choisies par un switch sur leur numéro, en appels directs, pour que les boucles de
+ * parties n'aient aucun appel indirect ; seule une stratégie enregistrée est appelée par
+ * son pointeur, un appel indirect par décision que l'on accepte : il ne coûte que
+ * quelques nanosecondes, quand la décision elle-même en prend des milliers. L'état de la partie n'est que lu, à part les compteurs de recherche et la
+ * mémoire du serpent : les variables de décision de l'IA habituelle sont passées à part
+ * pour que l'appelant puisse décider sur des copies.
+ * @param etat de type tEtatJeu, Entrée : la partie
+ * @param numero de type int, Entrée : le numéro du serpent (1 ou 2)
+ * @param direction de type char, Entrée/Sortie : la direction du serpent
+ * @param changement de type bool, Entrée/Sortie : true pour prioriser l'horizontalité
+ * @param sortieDuTrou de type bool, Entrée/Sortie : true si le serpent vient de sortir d'un trou
+ */
+void deciderSerpent(tEtatJeu *etat, int numero, char *direction, bool *changement, bool *sortieDuTrou)
+{
+	int strategie = etat->serpents[numero - 1].strategie;
+	bool trouve = false;
+
+	// plusieurs pommes : la plus proche de celles que le serpent atteint le premier, sauf
+	// pour la politique, dont les caractéristiques voient déjà toutes les pommes
+	if (strategie != STRATEGIE_POLITIQUE && etat->nbPommesPlateau > 1 && directionPommes(etat, numero, direction))
+	{
+		return;
+	}
+	switch (strategie)
+	{
+	case STRATEGIE_VERSION2:
+	case STRATEGIE_VERSION3:
+		directionVersionPrecedente(etat, numero, direction);
+		trouve = true;
+		break;
+	case STRATEGIE_VERSION4:
+		break;
+	case STRATEGIE_JPS: // plus court chemin vers la pomme
+		trouve = directionJPS(etat, numero, direction);
+		break;
+	case STRATEGIE_VORONOI: // course à la pomme gagnée ou plus grand territoire
+		trouve = directionVoronoi(etat, numero, direction);
+		break;
+	case STRATEGIE_POLITIQUE:
+		trouve = etat->contexte->modele != NULL && directionPolitique(etat, numero, direction);
+		break;
+	default:
+		trouve = etat->contexte->strategies[strategie].decider(etat, numero, direction);
+		break;
+	}
+
+	// IA habituelle, ou repli d'une stratégie qui n'a trouvé aucun coup
+	if (!trouve)
+	{
+		deciderVersion4(etat, numero, direction, changement, sortieDuTrou);
+	}
+}
+
+/**
+ * @brief Procédure qui prend la décision de l'IA habituelle : mode de direction à la
+ * sortie d'un trou, objectif, puis direction vers cet objectif.
+ * @param etat de type tEtatJeu, Entrée : la partie
+ * @param numero de type int, Entrée : le numéro du serpent (1 ou 2)
+ * @param direction de type char, Entrée/Sortie : la direction du serpent
+ * @param changement de type bool, Entrée/Sortie : true pour prioriser l'horizontalité
+ * @param sortieDuTrou de type bool, Entrée/Sortie : true si le serpent vient de sortir d'un trou
+ */
+void deciderVersion4(tEtatJeu *etat, int numero, char *direction, bool *changement, bool *sortieDuTrou)
 {
-	// Calcul des directions possibles
-	int dx = objectifX - lesX_S1[0]; // Différence en X
-	int dy = objectifY - lesY_S1[0]; // Différence en Y
+	tSerpent *serpent = &etat->serpents[numero - 1];
+	tCorps *corps = &serpent->corps;
+	tCorps *corpsAutre = &etat->serpents[2 - numero].corps;
+	int objectifX, objectifY;
+
+	// change ou non le mode de direction à la sortie d'un trou
+	if (*sortieDuTrou)
+	{
+		*changement = changementDirection(etat, numero);
+		*sortieDuTrou = false;
+	}
 
-	//si pas de changement, priorise la verticalitée
-	if(!changement){
-		// Essayer de se déplacer dans la direction verticale
-		if (dy != 0)
+	choisirObjectif(&etat->contexte->portails, serpent->meilleureDistance, serpent->teleporter, etat->pommeX, etat->pommeY, &objectifX, &objectifY);
+	// un mur de la carte entre la tête et l'objectif : l'approche gloutonne ne le contourne pas
+	if (contournerMurs(etat, numero, objectifX, objectifY, direction))
+	{
+		return;
+	}
+	if (numero == 1)
+	{
+		directionSerpentVersObjectif1(corps, corpsAutre, etat->plateau, portailsPartie(etat), direction, objectifX, objectifY, *changement);
+	}
+	else
+	{
+		if (serpent->meilleureDistance == CHEMIN_POMME)
 		{
-			*direction = (dy > 0) ? BAS : HAUT;
-			if (verifierCollision1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, plateau, *direction))
-			{
-				// Si collision, essayer la direction horizontale
-				*direction = (dx > 0) ? DROITE : GAUCHE;
-				if (verifierCollision1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, plateau, *direction))
-				{
-					// Si collision, essayer l'autre direction horizontale
-					*direction = (dx > 0) ? GAUCHE : DROITE;
-					if (verifierCollision1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, plateau, *direction))
-					{
-						// Si collision, essayer l'autre direction verticale
-						*direction = (dy > 0) ? HAUT : BAS;
-					}
-				}
-			}
+			*changement = changementDirectionCasIsole(corps, corpsAutre);
 		}
+		directionSerpentVersObjectif2(corps, corpsAutre, etat->plateau, portailsPartie(etat), direction, objectifX, objectifY, *changement);
+	}
+}
+
+/**
+ * @brief Fonction qui compte les murs d'une carte (hors du bord et des pavés) dans un
+ * rectangle, en quatre lectures de la table cumulée du contexte.
+ * @param contexte de type tContexte, Entrée : le contexte de la partie
+ * @param x1 de type int, Entrée : le X d'un coin du rectangle
+ * @param y1 de type int, Entrée : le Y d'un coin du rectangle
+ * @param x2 de type int, Entrée : le X du coin opposé
+ * @param y2 de type int, Entrée : le Y du coin opposé
+ * @return le nombre de murs du rectangle, bords compris
+ */
+int compterMurs(const tContexte *contexte, int x1, int y1, int x2, int y2)
+{
+	int gauche = (x1 < x2) ? x1 : x2, droite = (x1 < x2) ? x2 : x1;
+	int haut = (y1 < y2) ? y1 : y2, bas = (y1 < y2) ? y2 : y1;
+	return contexte->mursCumules[droite][bas] - contexte->mursCumules[gauche - 1][bas]
+		 - contexte->mursCumules[droite][haut - 1] + contexte->mursCumules[gauche - 1][haut - 1];
+}
+
+/**
+ * @brief Fonction qui dirige le serpent de l'IA habituelle autour des murs d'une carte.
+ * Tant qu'aucun mur (hors du bord et des pavés, que l'approche gloutonne sait longer) n'est
+ * dans le rectangle entre la tête et l'objectif, elle laisse faire l'approche gloutonne ;
+ * sinon le serpent prend le premier pas d'un plus court chemin vers l'objectif, trouvé par
+ * un parcours en largeur qui évite les deux corps. Un objectif au-delà d'un trou est visé
+ * sur la case du trou ; un bout de portail, depuis l'une de ses voisines.
+ * @param etat de type tEtatJeu, Entrée : la partie
+ * @param numero de type int, Entrée : le numéro du serpent (1 ou 2)
+ * @param objectifX de type int, Entrée : les coordonnées en X de l'objectif
+ * @param objectifY de type int, Entrée : les coordonnées en Y de l'objectif
+ * @param direction de type char, Sortie : la direction du premier pas, si elle est choisie
+ * @return true si la direction a été choisie, false pour s'en tenir à l'approche gloutonne
+ * (aucun mur entre la tête et l'objectif, ou objectif inaccessible)
+ */
+bool contournerMurs(const tEtatJeu *etat, int numero, int objectifX, int objectifY, char *direction)
+{
+	const tContexte *contexte = etat->contexte;
+	const tCorps *corps = &etat->serpents[numero - 1].corps;
+	int teteX = corps->lesX[corps->tete], teteY = corps->lesY[corps->tete];
+	int x = (objectifX < 1) ? 1 : (objectifX > LARGEUR_PLATEAU) ? LARGEUR_PLATEAU : objectifX;
+	int y = (objectifY < 1) ? 1 : (objectifY > HAUTEUR_PLATEAU) ? HAUTEUR_PLATEAU : objectifY;
+	if (contexte->nbMurs == 0 || abs(teteX - x) + abs(teteY - y) <= 1 || compterMurs(contexte, teteX, teteY, x, y) == 0)
+	{
+		return false;
+	}
 
-		// Si pas de déplacement verticale possible, essayer horizontale
-		else if (dx != 0)
+	const tPortails *portails = portailsPartie(etat);
+	char cases[NB_CASES];
+	int distances[NB_CASES], file[NB_CASES];
+	signed char premiers[NB_CASES];
+	bloquerCorps(etat, cases);
+	int nbAtteintes = parcourirDepuisTete(cases, portails, cellule_80x40(&GEOMETRIE_PLATEAU, teteX, teteY), distances, premiers, file);
+
+	// la case de l'objectif, ou la plus proche de ses voisines s'il est un bout de portail,
+	// dont on ressort aussitôt sans que le parcours la compte
+	bool vues[NB_CASES] = {false};
+	for (int i = 0; i < nbAtteintes; i++)
+	{
+		vues[file[i]] = true;
+	}
+	int objectif = cellule_80x40(&GEOMETRIE_PLATEAU, x, y);
+	int arrivee = vues[objectif] ? objectif : -1;
+	for (int d = 0; arrivee < 0 && portails != NULL && portails->sorties[objectif] != 0 && d < 4; d++)
+	{
+		int vx = x + DECALAGE_X[d], vy = y + DECALAGE_Y[d];
+		int voisine = cellule_80x40(&GEOMETRIE_PLATEAU, vx, vy);
+		if (vx >= 1 && vx <= LARGEUR_PLATEAU && vy >= 1 && vy <= HAUTEUR_PLATEAU && vues[voisine])
 		{
-			*direction = (dx > 0) ? DROITE : GAUCHE;
-			if (verifierCollision1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, plateau, *direction))
-			{
-				// Si collision, essayer la direction verticale
-				*direction = (dy > 0) ? BAS : HAUT;
-				if (verifierCollision1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, plateau, *direction))
-				{
-					// Si collision, essayer l'autre direction verticale
-					*direction = (dy > 0) ? HAUT : BAS;
-					if (verifierCollision1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, plateau, *direction))
-					{
-						// Si collision, essayer l'autre direction horizontale
-						*direction = (dx > 0) ? GAUCHE : DROITE;
-					}
-				}
-			}
+			arrivee = voisine;
 		}
 	}
+	for (int d = 0; arrivee != objectif && arrivee >= 0 && d < 4; d++)
+	{
+		int vx = x + DECALAGE_X[d], vy = y + DECALAGE_Y[d];
+		int voisine = cellule_80x40(&GEOMETRIE_PLATEAU, vx, vy);
+		if (vx >= 1 && vx <= LARGEUR_PLATEAU && vy >= 1 && vy <= HAUTEUR_PLATEAU && vues[voisine] && distances[voisine] < distances[arrivee])
+		{
+			arrivee = voisine;
+		}
+	}
+	if (arrivee < 0)
+	{
+		return false;
+	}
+	*direction = LES_DIRECTIONS[premiers[arrivee]];
+	return true;
+}
 
-	//si changement, priorise l'horizontalité
-	else if(changement){
-		// Essayer de se déplacer dans la direction horizontale
-		if (dx != 0)
+/**
+ * @brief Fonction exécutée par le fil de décision d'un serpent en mode parallèle :
+ * à chaque tour, attend l'instantané, décide, puis rejoint la barrière de fin de tour.
+ * @param decideur de type tDecideur, Entrée/Sortie : le serpent à faire décider
+ */
+void *filDecision(void *decideur)
+{
+	tDecideur *d = decideur;
+	while (true)
+	{
+		pthread_barrier_wait(d->debutTour);
+		if (*d->finPartie)
 		{
-			*direction = (dx > 0) ? DROITE : GAUCHE;
-			if (verifierCollision1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, plateau, *direction))
-			{
-				// Si collision, essayer la direction verticale
-				*direction = (dy > 0) ? BAS : HAUT;
-				if (verifierCollision1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, plateau, *direction))
-				{
-					// Si collision, essayer l'autre direction verticale
-					*direction = (dx > 0) ? GAUCHE : DROITE;
-					if (verifierCollision1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, plateau, *direction))
-					{
-						// Si collision, essayer l'autre direction horizontale
-						*direction = (dy > 0) ? HAUT : BAS;
-					}
-				}
-			}
+			break;
 		}
-		// Si pas de déplacement horizontale possible, essayer verticale
-		else if (dy != 0)
+		tSerpent *serpent = &d->etat->serpents[d->numero - 1];
+		deciderSerpent(d->etat, d->numero, &serpent->direction, &serpent->changement, &serpent->sortieDuTrou);
+		pthread_barrier_wait(d->finTour);
+	}
+	return NULL;
+}
+
+/**
+ * @brief Procédure qui résout les conflits des déplacements simultanés, de la même façon
+ * quel que soit l'ordre des serpents : les deux têtes visent la même case ou se croisent
+ * de face, et les deux serpents entrent en collision ; une tête vise la case de la queue
+ * de l'autre serpent, et ce serpent-là entre en collision, que la queue la quitte ou non.
+ * (progresser1, joué en premier, trouve encore la queue du serpent 2 à sa place ;
+ * progresser2 ne trouverait plus celle du serpent 1.)
+ * @param etat de type tEtatJeu, Entrée/Sortie : la partie, avec la direction choisie par
+ * chaque serpent ; la collision des deux serpents passe à true en cas de conflit
+ * @param journal de type tJournal, Entrée/Sortie : le journal d'annulation, ou NULL
+ */
+void resoudreConflits(tEtatJeu *etat, tJournal *journal)
+{
+	tSerpent *serpent_S1 = &etat->serpents[0], *serpent_S2 = &etat->serpents[1];
+	int *lesX_S1 = anneauxX(&serpent_S1->corps), *lesY_S1 = anneauxY(&serpent_S1->corps);
+	int *lesX_S2 = anneauxX(&serpent_S2->corps), *lesY_S2 = anneauxY(&serpent_S2->corps);
+	const tPortails *portails = portailsPartie(etat);
+	int x1, y1, x2, y2;
+	projeterCasePortails(portails, lesX_S1[0], lesY_S1[0], indiceDirection(serpent_S1->direction), &x1, &y1);
+	projeterCasePortails(portails, lesX_S2[0], lesY_S2[0], indiceDirection(serpent_S2->direction), &x2, &y2);
+
+	bool memeCase = (x1 == x2 && y1 == y2);
+	bool faceAFace = (x1 == lesX_S2[0] && y1 == lesY_S2[0] && x2 == lesX_S1[0] && y2 == lesY_S1[0]);
+	if (memeCase || faceAFace)
+	{
+		NOTER(journal, serpent_S1->collision);
+		NOTER(journal, serpent_S2->collision);
+		serpent_S1->collision = true;
+		serpent_S2->collision = true;
+	}
+	int queue1 = serpent_S1->corps.taille - 1, queue2 = serpent_S2->corps.taille - 1;
+	if (x1 == lesX_S2[queue2] && y1 == lesY_S2[queue2])
+	{
+		NOTER(journal, serpent_S1->collision);
+		serpent_S1->collision = true;
+	}
+	if (x2 == lesX_S1[queue1] && y2 == lesY_S1[queue1])
+	{
+		NOTER(journal, serpent_S2->collision);
+		serpent_S2->collision = true;
+	}
+}
+
+/**
+ * @brief Procédure qui donne le rang de préférence (0 = préférée) de chaque direction,
+ * dans l'ordre où les essayait l'ancienne cascade de verifierCollision.
+ * @param dx de type int, Entrée : la différence en X entre l'objectif et la tête
+ * @param dy de type int, Entrée : la différence en Y entre l'objectif et la tête
+ * @param changement de type bool, Entrée : true pour prioriser l'horizontalité
+ * @param directionCourante de type char, Entrée : la direction actuelle du serpent
+ * @param rang de type int tableau, Sortie : le rang de chaque direction (HAUT, BAS, GAUCHE, DROITE)
+ */
+void rangDirections(int dx, int dy, bool changement, char directionCourante, int rang[4])
+{
+	char verticale = (dy > 0) ? BAS : HAUT;			// direction verticale vers l'objectif
+	char verticaleOpposee = (dy > 0) ? HAUT : BAS;
+	char horizontale = (dx > 0) ? DROITE : GAUCHE;	// direction horizontale vers l'objectif
+	char horizontaleOpposee = (dx > 0) ? GAUCHE : DROITE;
+	char ordre[4];
+
+	if (!changement && dy != 0)
+	{
+		ordre[0] = verticale; ordre[1] = horizontale; ordre[2] = horizontaleOpposee; ordre[3] = verticaleOpposee;
+	}
+	else if (!changement && dx != 0)
+	{
+		ordre[0] = horizontale; ordre[1] = verticale; ordre[2] = verticaleOpposee; ordre[3] = horizontaleOpposee;
+	}
+	else if (changement && dx != 0)
+	{
+		ordre[0] = horizontale; ordre[1] = verticale; ordre[2] = horizontaleOpposee; ordre[3] = verticaleOpposee;
+	}
+	else if (changement && dy != 0)
+	{
+		ordre[0] = verticale; ordre[1] = horizontaleOpposee; ordre[2] = verticaleOpposee; ordre[3] = horizontale;
+	}
+	else // objectif atteint : garder la direction courante si elle est libre
+	{
+		ordre[0] = directionCourante; ordre[1] = HAUT; ordre[2] = BAS; ordre[3] = GAUCHE;
+		for (int i = 1; i < 4; i++)
 		{
-			*direction = (dy > 0) ? BAS : HAUT;
-			if (verifierCollision1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, plateau, *direction))
+			if (ordre[i] == directionCourante)
 			{
-				// Si collision, essayer la direction horizontale
-				*direction = (dx > 0) ? GAUCHE : DROITE;
-				if (verifierCollision1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, plateau, *direction))
-				{
-					// Si collision, essayer l'autre direction horizontale
-						*direction = (dy > 0) ? HAUT : BAS;
-					if (verifierCollision1(lesX_S1, lesY_S1, lesX_S2, lesY_S2, plateau, *direction))
-					{
-						// Si collision, essayer l'autre direction verticale
-						*direction = (dx > 0) ? DROITE : GAUCHE;
-					}
-				}
+				ordre[i] = DROITE;
 			}
 		}
 	}
+
+	for (int i = 0; i < 4; i++)
+	{
+		rang[indiceDirection(ordre[i])] = i;
+	}
 }
 
 /**
- * @brief Procédure qui choisit la direction la plus optimiser et courte pour atteindre l'objectif
- * @param lesX de type int tableau, Entrée : le tableau des X de N élément
- * @param lesY de type int tableau, Entrée : le tableau des Y de N élément
+ * @brief Procédure qui évalue en une seule passe les quatre déplacements possibles de la tête :
+ * case projetée, blocage (bordure, pavé, corps des deux serpents) et distance à l'objectif.
+ * Un pas dans un bout de portail qui n'est pas l'objectif, ou que la tête de l'autre serpent
+ * touche, n'est pris qu'à défaut d'un autre.
+ * @param corps de type tCorps, Entrée : le corps du serpent qui se déplace
+ * @param corpsAutre de type tCorps, Entrée : le corps de l'autre serpent
  * @param plateau de type tPlateau, qui donne en Entrée le plateau du jeu
- * @param direction de type char, Entrée/Sortie : la direction du serpent attribuée aux touches 'z' 'q' 's' 'd'
+ * @param portails de type tPortails, Entrée : les portails de la partie, ou NULL
  * @param objectifX de type int, Entrée : les coordonnées en X de l'objecif à atteindre
  * @param objectifY de type int, Entrée : les coordonnées en Y de l'objecif à atteindre
- * @param changement de type bool, Entre : l'etat (true/false) de la variable "changement" dans le main
+ * @param rang de type int tableau, Entrée : le rang de préférence de chaque direction
+ * @param scores de type int tableau, Sortie : le score de chaque direction (plus petit = meilleur)
  */
-void directionSerpentVersObjectif2(int lesX_S2[], int lesY_S2[], int lesX_S1[], int lesY_S1[], tPlateau plateau, char *direction, int objectifX, int objectifY, bool changement)
+void evaluerDirections(tCorps *corps, tCorps *corpsAutre, tPlateau plateau, const tPortails *portails, int objectifX, int objectifY, const int rang[4], int scores[4])
 {
-	// Calcul des directions possibles
-	int dx = objectifX - lesX_S2[0]; // Différence en X
-	int dy = objectifY - lesY_S2[0]; // Différence en Y
+	int *lesX = anneauxX(corps);
+	int *lesY = anneauxY(corps);
+	int projeteX[4], projeteY[4];	// cases atteintes sans passer par un trou, pour la distance
+	int candidatsX[4], candidatsY[4];	// cases réellement occupées après un éventuel passage de trou
 
-	//si pas de changement, priorise la verticalitée
-	if(!changement){
-		// Essayer de se déplacer dans la direction verticale
-		if (dy != 0)
-		{
-			*direction = (dy > 0) ? BAS : HAUT;
-			if (verifierCollision2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, plateau, *direction))
-			{
-				// Si collision, essayer la direction horizontale
-				*direction = (dx > 0) ? DROITE : GAUCHE;
-				if (verifierCollision2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, plateau, *direction))
-				{
-					// Si collision, essayer l'autre direction horizontale
-					*direction = (dx > 0) ? GAUCHE : DROITE;
-					if (verifierCollision2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, plateau, *direction))
-					{
-						// Si collision, essayer l'autre direction verticale
-						*direction = (dy > 0) ? HAUT : BAS;
-					}
-				}
-			}
-		}
+	for (int d = 0; d < 4; d++)
+	{
+		projeteX[d] = lesX[0] + DECALAGE_X[d];
+		projeteY[d] = lesY[0] + DECALAGE_Y[d];
+		projeterCasePortails(portails, lesX[0], lesY[0], d, &candidatsX[d], &candidatsY[d]);
+	}
+
+	// les quatre cases candidates sont testées ensemble contre chaque corps
+	int masqueCorps = collisionCandidats(lesX, lesY, corps->taille, candidatsX, candidatsY) |
+					  collisionCandidats(anneauxX(corpsAutre), anneauxY(corpsAutre), corpsAutre->taille, candidatsX, candidatsY);
 
-		// Si pas de déplacement verticale possible, essayer horizontale
-		else if (dx != 0)
+	for (int d = 0; d < 4; d++)
+	{
+		int bloque = (plateau[candidatsX[d]][candidatsY[d]] == BORDURE) | ((masqueCorps >> d) & 1);
+		// un bout de portail qui n'est pas l'objectif mène loin de lui, à l'autre bout ; celui
+		// qui l'est n'a qu'une sortie, où les deux serpents arriveraient ensemble si l'autre
+		// y entrait au même tour. Ces pas ne sont pris que si tous les autres sont bloqués.
+		int detour = 0;
+		if (portails != NULL && portails->sorties[cellule_80x40(&GEOMETRIE_PLATEAU, projeteX[d], projeteY[d])] != 0)
 		{
-			*direction = (dx > 0) ? DROITE : GAUCHE;
-			if (verifierCollision2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, plateau, *direction))
+			if (projeteX[d] != objectifX || projeteY[d] != objectifY)
 			{
-				// Si collision, essayer la direction verticale
-				*direction = (dy > 0) ? BAS : HAUT;
-				if (verifierCollision2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, plateau, *direction))
-				{
-					// Si collision, essayer l'autre direction verticale
-					*direction = (dy > 0) ? HAUT : BAS;
-					if (verifierCollision2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, plateau, *direction))
-					{
-						// Si collision, essayer l'autre direction horizontale
-						*direction = (dx > 0) ? GAUCHE : DROITE;
-					}
-				}
+				detour = 1;
+				projeteX[d] = candidatsX[d];
+				projeteY[d] = candidatsY[d];
 			}
+			detour |= (abs(anneauxX(corpsAutre)[0] - projeteX[d]) + abs(anneauxY(corpsAutre)[0] - projeteY[d]) == 1);
 		}
+		int distance = abs(objectifX - projeteX[d]) + abs(objectifY - projeteY[d]);
+		// le rang ne départage que les directions à distance égale
+		scores[d] = bloque * PENALITE_BLOCAGE + detour * PENALITE_PORTAIL + distance * 4 + rang[d];
 	}
+}
 
-	//si changement, priorise l'horizontalité
-	else if(changement){
-		// Essayer de se déplacer dans la direction horizontale
-		if (dx != 0)
-		{
-			*direction = (dx > 0) ? DROITE : GAUCHE;
-			if (verifierCollision2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, plateau, *direction))
-			{
-				// Si collision, essayer la direction verticale
-				*direction = (dy > 0) ? BAS : HAUT;
-				if (verifierCollision2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, plateau, *direction))
-				{
-					// Si collision, essayer l'autre direction verticale
-					*direction = (dx > 0) ? GAUCHE : DROITE;
-					if (verifierCollision2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, plateau, *direction))
-					{
-						// Si collision, essayer l'autre direction horizontale
-						*direction = (dy > 0) ? HAUT : BAS;
-					}
-				}
-			}
-		}
-		// Si pas de déplacement horizontale possible, essayer verticale
-		else if (dy != 0)
-		{
-			*direction = (dy > 0) ? BAS : HAUT;
-			if (verifierCollision2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, plateau, *direction))
-			{
-				// Si collision, essayer la direction horizontale
-				*direction = (dx > 0) ? GAUCHE : DROITE;
-				if (verifierCollision2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, plateau, *direction))
-				{
-					// Si collision, essayer l'autre direction horizontale
-						*direction = (dy > 0) ? HAUT : BAS;
-					if (verifierCollision2(lesX_S2, lesY_S2, lesX_S1, lesY_S1, plateau, *direction))
-					{
-						// Si collision, essayer l'autre direction verticale
-						*direction = (dx > 0) ? DROITE : GAUCHE;
-					}
-				}
-			}
-		}
+/**
+ * @brief Fonction qui renvoie l'indice de la direction de plus petit score, sans branchement
+ * @param scores de type int tableau, Entrée : le score des quatre directions
+ * @return l'indice (0 à 3) de la meilleure direction
+ */
+int meilleureDirection(const int scores[4])
+{
+	int meilleur01 = (scores[1] < scores[0]);
+	int meilleur23 = 2 + (scores[3] < scores[2]);
+	return (scores[meilleur23] < scores[meilleur01]) ? meilleur23 : meilleur01;
+}
+
+/**
+ * @brief Fonction qui renvoie l'indice (0 à 3) d'une direction dans LES_DIRECTIONS
+ * @param direction de type char, Entrée : la direction 'z' 's' 'q' ou 'd'
+ */
+int indiceDirection(char direction)
+{
+	int indice = 0;
+	switch (direction)
+	{
+	case HAUT:
+		indice = 0;
+		break;
+	case BAS:
+		indice = 1;
+		break;
+	case GAUCHE:
+		indice = 2;
+		break;
+	case DROITE:
+		indice = 3;
+		break;
 	}
+	return indice;
 }
 
 /**
  * @brief Fonction qui renvoit "changement" en false ou true selon ou est situé la pomme part rapport au pavé et selon l'emplacement du serpent
- * @param lesX de type int tableau, Entrée : le tableau des X de N élément
- * @param lesY de type int tableau, Entrée : le tableau des Y de N élément
- * @param nbPommesMangee de type int, Entrée : le nombre de pommes mangés
- * @param meilleureDistancePave de type int, Entrée : l'indice du pavée le plus proche de la pomme
+ * @param etat de type tEtatJeu, Entrée : la partie (pomme, pavés, pavé le plus proche de la pomme)
+ * @param numero de type int, Entrée : le numéro du serpent (1 ou 2)
  * */
-bool changementDirection(int lesX[], int lesY[], int nbPommesMangee, int meilleureDistancePave){
+bool changementDirection(tEtatJeu *etat, int numero){
+	int *lesX = anneauxX(&etat->serpents[numero - 1].corps);
+	int *lesY = anneauxY(&etat->serpents[numero - 1].corps);
+	int pommeX = etat->pommeX, pommeY = etat->pommeY;
+	int meilleureDistancePave = etat->DistancePommePave;
+	const int *lesPavesX = etat->lesPavesX, *lesPavesY = etat->lesPavesY;
 	int changement  = false;
 
+	// une carte sans pavé ne change jamais le mode de direction
+	if (etat->nbPaves == 0){
+		return false;
+	}
+
 	if (lesPavesX[meilleureDistancePave]+2 < lesX[0] && lesPavesY[meilleureDistancePave]+2 > lesY[0] && lesPavesX[meilleureDistancePave]+2 > LARGEUR_PLATEAU/2){ // Sortie trou droit, pave en bas a droite du plateau
-		if(lesPommesX[nbPommesMangee] < lesPavesX[meilleureDistancePave] + 5 && lesPommesY[nbPommesMangee] < lesPavesY[meilleureDistancePave] + 5){ // si pomme dans la diagonale suprieure gauche du pave
+		if(pommeX < lesPavesX[meilleureDistancePave] + 5 && pommeY < lesPavesY[meilleureDistancePave] + 5){ // si pomme dans la diagonale suprieure gauche du pave
 			changement = true;
 		}
 	}
 	else if (lesPavesX[meilleureDistancePave]+2 < lesX[0] && lesPavesY[meilleureDistancePave]+2 < lesY[0] && lesPavesX[meilleureDistancePave]+2 > LARGEUR_PLATEAU/2){ // Sortie trou droit, pave en haut a droite du plateau
-		if(lesPommesX[nbPommesMangee] < lesPavesX[meilleureDistancePave] + 5 && lesPommesY[nbPommesMangee] > lesPavesY[meilleureDistancePave] - 1){ // si pomme dans la diagonale infrieure gauche du pave
+		if(pommeX < lesPavesX[meilleureDistancePave] + 5 && pommeY > lesPavesY[meilleureDistancePave] - 1){ // si pomme dans la diagonale infrieure gauche du pave
 			changement = true;
 		}
 	}
 	else if (lesPavesX[meilleureDistancePave]+2 > lesX[0] && lesPavesY[meilleureDistancePave]+2 > lesY[0] && lesPavesX[meilleureDistancePave]+2 < LARGEUR_PLATEAU/2){ // Sortie trou gauche, pave en bas a gauche  du plateau
-		if(lesPommesX[nbPommesMangee] > lesPavesX[meilleureDistancePave] -1 && lesPommesY[nbPommesMangee] < lesPavesY[meilleureDistancePave] + 5){ // si pomme dans la diagonale suprieure droite du pave
+		if(pommeX > lesPavesX[meilleureDistancePave] -1 && pommeY < lesPavesY[meilleureDistancePave] + 5){ // si pomme dans la diagonale suprieure droite du pave
 			changement = true;
 		}
 	}
 	else if (lesPavesX[meilleureDistancePave]+2 > lesX[0] && lesPavesY[meilleureDistancePave]+2 < lesY[0] && lesPavesX[meilleureDistancePave]+2 < LARGEUR_PLATEAU/2){ // Sortie trou gauche, pave en haut a gauche du plateau
-		if(lesPommesX[nbPommesMangee] > lesPavesX[meilleureDistancePave] -1 && lesPommesY[nbPommesMangee] > lesPavesY[meilleureDistancePave] - 1){ // si pomme dans la diagonale infrieure droite du pave
+		if(pommeX > lesPavesX[meilleureDistancePave] -1 && pommeY > lesPavesY[meilleureDistancePave] - 1){ // si pomme dans la diagonale infrieure droite du pave
 			changement = true;
 		}
 	}
 	else if (lesPavesX[meilleureDistancePave]+2 > lesX[0] && lesPavesY[meilleureDistancePave]+2 > lesY[0] && lesPavesY[meilleureDistancePave]+2 < HAUTEUR_PLATEAU/2){ // Sortie trou haut, pave en haut a droite du plateau
-		if(lesPommesX[nbPommesMangee] < lesPavesX[meilleureDistancePave] + 5 && lesPommesY[nbPommesMangee] > lesPavesY[meilleureDistancePave] - 1){ // si pomme dans la diagonale infrieure gauche du pave
+		if(pommeX < lesPavesX[meilleureDistancePave] + 5 && pommeY > lesPavesY[meilleureDistancePave] - 1){ // si pomme dans la diagonale infrieure gauche du pave
 			changement = true;
 		}
 	}
 	else if (lesPavesX[meilleureDistancePave]+2 < lesX[0] && lesPavesY[meilleureDistancePave]+2 > lesY[0] && lesPavesY[meilleureDistancePave]+2 < HAUTEUR_PLATEAU/2){ // Sortie trou haut, pave en haut a gauche du plateau
-		if(lesPommesX[nbPommesMangee] > lesPavesX[meilleureDistancePave] - 1 && lesPommesY[nbPommesMangee] > lesPavesY[meilleureDistancePave] - 1){ // si pomme dans la diagonale infrieure droite du pave
+		if(pommeX > lesPavesX[meilleureDistancePave] - 1 && pommeY > lesPavesY[meilleureDistancePave] - 1){ // si pomme dans la diagonale infrieure droite du pave
+			changement = true;
+		}
+	}
+	else if (lesPavesX[meilleureDistancePave]+2 > lesX[0] && lesPavesY[meilleureDistancePave]+2 < lesY[0] && lesPavesY[meilleureDistancePave]+2 > HAUTEUR_PLATEAU/2){ // Sortie trou bas, pave en bas a droite du plateau
+		if(pommeX < lesPavesX[meilleureDistancePave] + 5 && pommeY < lesPavesY[meilleureDistancePave] +5){ // si pomme dans la diagonale suprieure gauche du pave
 			changement = true;
 		}
 	}
-	else if (lesPavesX[meilleureDistancePave]+2 > lesX[0] && lesPavesY[meilleureDistancePave]+2 < lesY[0] && lesPavesY[meilleureDistancePave]+2 > HAUTEUR_PLATEAU/2){ // Sortie trou bas, pave en bas a droite du plateau
-		if(lesPommesX[nbPommesMangee] < lesPavesX[meilleureDistancePave] + 5 && lesPommesY[nbPommesMangee] < lesPavesY[meilleureDistancePave] +5){ // si pomme dans la diagonale suprieure gauche du pave
-			changement = true;
-		}
+	else if (lesPavesX[meilleureDistancePave]+2 < lesX[0] && lesPavesY[meilleureDistancePave]+2 < lesY[0] && lesPavesY[meilleureDistancePave]+2 > HAUTEUR_PLATEAU/2){ // Sortie trou bas, pave en bas a gauche du plateau
+		if(pommeX > lesPavesX[meilleureDistancePave] - 1 && pommeY < lesPavesY[meilleureDistancePave] +5){ // si pomme dans la diagonale suprieure droite du pave
+			changement = true;
+		}
+	}
+
+	return changement;
+}
+
+
+/**
+ * @brief Fonction qui regarde si un pavé arrive devant le serpent
+ * @param corps_S2 de type tCorps, Entrée : le corps du serpent 2
+ * @param corps_S1 de type tCorps, Entrée : le corps du serpent 1
+ */
+bool changementDirectionCasIsole(tCorps *corps_S2, tCorps *corps_S1){ // Utile dans un seul cas, si la coordonne du pave se trouve en lesX[0] - 1
+	bool changement = false;
+	int *lesX_S1 = anneauxX(corps_S1), *lesY_S1 = anneauxY(corps_S1);
+	int *lesX_S2 = anneauxX(corps_S2), *lesY_S2 = anneauxY(corps_S2);
+	int nouvelleX = lesX_S2[0]; // projeter des coordonnées en X
+	int nouvelleY = lesY_S2[0]; // projeter des coordonnées en Y
+
+	for (int i = 0; i < corps_S1->taille; i++)
+	{
+		if (lesX_S1[i] + 2 == nouvelleX && lesY_S1[i] == nouvelleY)
+		{
+			return true; // Collision avec le corps du serpent
+		}
+	}
+	for (int i = 0; i < corps_S2->taille; i++)
+	{
+		if (lesX_S2[i] == nouvelleX && lesY_S2[i] == nouvelleY)
+		{
+			return true; // Collision avec le corps du serpent
+		}
+	}
+	return changement;
+}
+
+/**
+ * @brief Fonction qui calcule puis renvoie le chemin le plus rapide
+ * @param lesX de type int tableau, Entrée : le tableau des X de N élément
+ * @param lesY de type int tableau, Entrée : le tableau des Y de N élément
+ * @param pommeX de type int, Entrée : les coordonnées des pommes en X
+ * @param pommeY de type int, Entrée : les coordonnées des pommes en Y
+ * @param portails de type tPortails, Entrée : les portails de la partie et les chemins de l'IA
+ */
+int calculerDistance1(int lesX_S1[], int lesY_S1[], int pommeX, int pommeY, const tPortails *portails)
+{
+	return meilleurChemin(portails, lesX_S1[0], lesY_S1[0], pommeX, pommeY);
+}
+
+/**
+ * @brief Fonction qui calcule puis renvoie le chemin le plus rapide
+ * @param lesX de type int tableau, Entrée : le tableau des X de N élément
+ * @param lesY de type int tableau, Entrée : le tableau des Y de N élément
+ * @param pommeX de type int, Entrée : les coordonnées des pommes en X
+ * @param pommeY de type int, Entrée : les coordonnées des pommes en Y
+ * @param portails de type tPortails, Entrée : les portails de la partie et les chemins de l'IA
+ */
+int calculerDistance2(int lesX_S2[], int lesY_S2[], int pommeX, int pommeY, const tPortails *portails)
+{
+	return meilleurChemin(portails, lesX_S2[0], lesY_S2[0], pommeX, pommeY);
+}
+
+/**
+ * @brief Fonction qui compare le chemin direct vers la pomme aux chemins par chaque trou et
+ * chaque portail de la partie : de la tête jusqu'à l'entrée, puis de la sortie jusqu'à
+ * la pomme, le passage lui-même ne comptant pas, chaque morceau contournant les bouts de
+ * portail qu'il ne vise pas (distanceHorsPortails). À égalité, le chemin direct passe avant les
+ * trous, et les trous dans l'ordre haut, bas, gauche, droite, puis les autres.
+ * @param portails de type tPortails, Entrée : les portails de la partie et les chemins de l'IA
+ * @param teteX de type int, Entrée : les coordonnées en X de la tête
+ * @param teteY de type int, Entrée : les coordonnées en Y de la tête
+ * @param pommeX de type int, Entrée : les coordonnées en X de la pomme
+ * @param pommeY de type int, Entrée : les coordonnées en Y de la pomme
+ * @return le meilleur chemin (CHEMIN_HAUT ... CHEMIN_POMME, ou CHEMIN_PORTAIL + k)
+ */
+int meilleurChemin(const tPortails *portails, int teteX, int teteY, int pommeX, int pommeY)
+{
+	int meilleure = distanceHorsPortails(portails, teteX, teteY, pommeX, pommeY);
+	int resultat = CHEMIN_POMME;
+	for (int i = 0; i < portails->nbChemins; i++)
+	{
+		if (portails->entreesX[i] < 0)
+		{
+			continue; // côté sans trou
+		}
+		int distance = distanceHorsPortails(portails, teteX, teteY, portails->entreesX[i], portails->entreesY[i])
+					 + distanceHorsPortails(portails, portails->sortiesX[i], portails->sortiesY[i], pommeX, pommeY);
+		if (distance < meilleure)
+		{
+			meilleure = distance;
+			resultat = (i < 4) ? CHEMIN_HAUT + i : CHEMIN_PORTAIL + i - 4;
+		}
+	}
+	return resultat;
+}
+
+/**
+ * @brief Fonction qui estime la longueur d'un chemin entre deux cases sans passer par un
+ * portail : la distance de Manhattan, plus le détour de deux pas autour d'un bout de
+ * portail posé sur la ligne droite qui les joint (un chemin qui n'est pas en ligne droite
+ * le contourne sans allonger).
+ * @param portails de type tPortails, Entrée : les portails de la partie
+ * @param x1 de type int, Entrée : les coordonnées en X de la case de départ
+ * @param y1 de type int, Entrée : les coordonnées en Y de la case de départ
+ * @param x2 de type int, Entrée : les coordonnées en X de la case d'arrivée
+ * @param y2 de type int, Entrée : les coordonnées en Y de la case d'arrivée
+ */
+int distanceHorsPortails(const tPortails *portails, int x1, int y1, int x2, int y2)
+{
+	const int pas = HAUTEUR_PLATEAU + 1;
+	int distance = abs(x1 - x2) + abs(y1 - y2);
+	for (int b = 0; (x1 == x2 || y1 == y2) && b < 2 * portails->nbPaires; b++)
+	{
+		int x = portails->bouts[b] / pas, y = portails->bouts[b] % pas;
+		bool entre = (x1 == x2) ? (x == x1 && y > ((y1 < y2) ? y1 : y2) && y < ((y1 < y2) ? y2 : y1))
+								: (y == y1 && x > ((x1 < x2) ? x1 : x2) && x < ((x1 < x2) ? x2 : x1));
+		if (entre)
+		{
+			return distance + 2;
+		}
+	}
+	return distance;
+}
+
+/**
+ * @brief Fonction qui donne le rang d'un chemin dans la table des portails (tPortails).
+ * @param chemin de type int, Entrée : le chemin (CHEMIN_HAUT ... CHEMIN_POMME, ou CHEMIN_PORTAIL + k)
+ * @return le rang, -1 pour le chemin direct
+ */
+int rangDuChemin(int chemin)
+{
+	return (chemin == CHEMIN_POMME) ? -1 : (chemin < CHEMIN_POMME) ? chemin - CHEMIN_HAUT : chemin - CHEMIN_PORTAIL + 4;
+}
+
+/**
+ * @brief Fonction qui donne l'indice du pavé dont le centre est le plus proche de la pomme.
+ * @param etat de type tEtatJeu, Entrée : la partie (pomme et pavés)
+ */
+int calculerDistancePommePave(const tEtatJeu *etat)
+{
+	// définition des variables
+	int distancePommePave, meilleureDistancePommePave, iMeilleureDistancePave;
+
+	meilleureDistancePommePave = 0;
+	iMeilleureDistancePave = 0;
+
+	// calcul la distance pour chaque chemin du serpent vers la pomme
+	for (int i = 0; i<etat->nbPaves; i++){
+		distancePommePave = abs(etat->pommeX - (etat->lesPavesX[i] + 2)) + abs(etat->pommeY - (etat->lesPavesY[i] + 2)); //distance par rapport au centre du pavé
+		if (meilleureDistancePommePave == 0){
+			meilleureDistancePommePave = distancePommePave;
+			iMeilleureDistancePave = i;
+		}
+		else if(distancePommePave < meilleureDistancePommePave){
+			meilleureDistancePommePave = distancePommePave;
+			iMeilleureDistancePave = i;
+		}
+	}
+
+	
+	return iMeilleureDistancePave;
+}
+
+/**
+ * @brief Vérifie si le prochain déplacement du serpent dans la direction spécifiée entraîne une collision.
+ * @param corps_S1 corps du serpent 1, qui se déplace.
+ * @param corps_S2 corps du serpent 2.
+ * @param plateau tableau représentant le plateau de jeu.
+ * @param directionProchaine direction vers laquelle le serpent va se déplacer.
+ * @return true si une collision est détectée, false sinon.
+ */
+bool verifierCollision1(tCorps *corps_S1, tCorps *corps_S2, tPlateau plateau, const tPortails *portails, char directionProchaine)
+{
+	int nouvelleX, nouvelleY;
+
+	// Calcul de la nouvelle position en fonction de la direction donnée, en passant les trous
+	projeterCasePortails(portails, anneauxX(corps_S1)[0], anneauxY(corps_S1)[0], indiceDirection(directionProchaine), &nouvelleX, &nouvelleY);
+
+	// Vérification des collisions avec les bords du tableau
+	if (plateau[nouvelleX][nouvelleY] == BORDURE)
+	{
+		return true; // Collision avec une bordure
+	}
+
+	// Vérification des collisions avec le corps des deux serpents
+	if (collisionCorps(anneauxX(corps_S1), anneauxY(corps_S1), corps_S1->taille, nouvelleX, nouvelleY) ||
+		collisionCorps(anneauxX(corps_S2), anneauxY(corps_S2), corps_S2->taille, nouvelleX, nouvelleY))
+	{
+		return true; // Collision avec le corps du serpent
+	}
+
+	return false; // Pas de collision
+}
+
+/**
+ * @brief Vérifie si le prochain déplacement du serpent dans la direction spécifiée entraîne une collision.
+ * @param corps_S2 corps du serpent 2, qui se déplace.
+ * @param corps_S1 corps du serpent 1.
+ * @param plateau tableau représentant le plateau de jeu.
+ * @param directionProchaine direction vers laquelle le serpent va se déplacer.
+ * @return true si une collision est détectée, false sinon.
+ */
+bool verifierCollision2(tCorps *corps_S2, tCorps *corps_S1, tPlateau plateau, const tPortails *portails, char directionProchaine)
+{
+	int nouvelleX, nouvelleY;
+
+	// Calcul de la nouvelle position en fonction de la direction donnée, en passant les trous
+	projeterCasePortails(portails, anneauxX(corps_S2)[0], anneauxY(corps_S2)[0], indiceDirection(directionProchaine), &nouvelleX, &nouvelleY);
+
+	// Vérification des collisions avec les bords du tableau
+	if (plateau[nouvelleX][nouvelleY] == BORDURE)
+	{
+		return true; // Collision avec une bordure
+	}
+
+	// Vérification des collisions avec le corps des deux serpents
+	if (collisionCorps(anneauxX(corps_S2), anneauxY(corps_S2), corps_S2->taille, nouvelleX, nouvelleY) ||
+		collisionCorps(anneauxX(corps_S1), anneauxY(corps_S1), corps_S1->taille, nouvelleX, nouvelleY))
+	{
+		return true; // Collision avec le corps du serpent
+	}
+
+	return false; // Pas de collision
+}
+
+/**
+ * @brief Fonction qui dit si la tête d'un serpent est sur l'un de ses propres anneaux ou sur
+ * un anneau de l'autre serpent.
+ * @param etat de type tEtatJeu, Entrée : la partie
+ * @param numero de type int, Entrée : le numéro du serpent (1 ou 2)
+ * @return true si la tête partage sa case avec un autre anneau
+ */
+bool teteSurUnCorps(tEtatJeu *etat, int numero)
+{
+	tCorps *corps = &etat->serpents[numero - 1].corps;
+	tCorps *corpsAutre = &etat->serpents[2 - numero].corps;
+	int *lesX = anneauxX(corps), *lesY = anneauxY(corps);
+	return collisionCorps(lesX + 1, lesY + 1, corps->taille - 1, lesX[0], lesY[0])
+		|| collisionCorps(anneauxX(corpsAutre), anneauxY(corpsAutre), corpsAutre->taille, lesX[0], lesY[0]);
+}
+
+/**
+ * @brief Procédure qui calcule la prochaine position du serpent et qui l'affiche,
+ * elle permet aussi de savoir si le serpent entre en collision avec une bordure, un pavé,
+ * un anneau de l'un des deux serpents, ou une pomme.
+ * Seules la case quittée par la queue et les deux cases de tête sont redessinées.
+ * @param etat de type tEtatJeu, Entrée/Sortie : la partie ; le serpent avance dans sa direction
+ * (et grandit s'il lui reste des anneaux à ajouter), l'index des cases libres est tenu à jour et
+ * les indicateurs collision, pommeMangee, teleporter et sortieDuTrou du serpent sont mis à jour
+ * @param journal de type tJournal, Entrée/Sortie : le journal d'annulation, ou NULL
+ */
+void progresser1(tEtatJeu *etat, tJournal *journal)
+{
+	tSerpent *serpent = &etat->serpents[0];
+	tCorps *corps = &serpent->corps;
+	tCasesLibres *casesLibres = &etat->casesLibres;
+	int *lesX = anneauxX(corps);
+	int *lesY = anneauxY(corps);
+	int xTete, yTete;
+	bool grandir = corps->aGrandir > 0;
+
+	// faire progresser la tete dans la nouvelle direction, en ressortant
+	// de l'autre côté quand le serpent traverse un trou
+	if (projeterCasePortails(portailsPartie(etat), lesX[0], lesY[0], indiceDirection(serpent->direction), &xTete, &yTete))
+	{
+		NOTER(journal, serpent->teleporter);
+		NOTER(journal, serpent->sortieDuTrou);
+		serpent->teleporter = true;
+		serpent->sortieDuTrou = true;
+	}
+
+	// le dernier élément quitte sa case, sauf si le serpent grandit
+	if (grandir)
+	{
+		NOTER(journal, corps->aGrandir);
+		corps->aGrandir--;
+	}
+	else
+	{
+		if (etat->affichage)
+		{
+			effacer(lesX[corps->taille - 1], lesY[corps->taille - 1], portailsPartie(etat));
+		}
+		libererCase(casesLibres, lesX[corps->taille - 1], lesY[corps->taille - 1], journal);
+	}
+	// l'ancienne tête devient un anneau
+	if (etat->affichage)
+	{
+		afficher(lesX[0], lesY[0], CORPS);
+	}
+	ajouterTete(corps, xTete, yTete, grandir, journal);
+	lesX = anneauxX(corps);
+	lesY = anneauxY(corps);
+	occuperCase(casesLibres, lesX[0], lesY[0], journal);
+
+	NOTER(journal, serpent->pommeMangee);
+	serpent->pommeMangee = false;
+	// détection d'une "collision" avec une pomme
+	if (etat->plateau[lesX[0]][lesY[0]] == POMME)
+	{
+		serpent->pommeMangee = true;
+		// la pomme disparait du plateau
+		NOTER(journal, etat->plateau[lesX[0]][lesY[0]]);
+		etat->plateau[lesX[0]][lesY[0]] = VIDE;
+		libererCase(casesLibres, lesX[0], lesY[0], journal);
+	}
+	// détection d'une collision avec la bordure, ou avec un anneau : la queue, si elle
+	// vient de quitter sa case, n'est plus dans le corps
+	else if (etat->plateau[lesX[0]][lesY[0]] == BORDURE || teteSurUnCorps(etat, 1))
+	{
+		NOTER(journal, serpent->collision);
+		serpent->collision = true;
+	}
+
+	if (etat->affichage)
+	{
+		afficher(lesX[0], lesY[0], TETE_SERPENT1);
+	}
+}
+
+/**
+ * @brief Procédure qui calcule la prochaine position du serpent et qui l'affiche,
+ * elle permet aussi de savoir si le serpent entre en collision avec une bordure, un pavé,
+ * un anneau de l'un des deux serpents, ou une pomme.
+ * Seules la case quittée par la queue et les deux cases de tête sont redessinées.
+ * @param etat de type tEtatJeu, Entrée/Sortie : la partie ; le serpent avance dans sa direction
+ * (et grandit s'il lui reste des anneaux à ajouter), l'index des cases libres est tenu à jour et
+ * les indicateurs collision, pommeMangee, teleporter et sortieDuTrou du serpent sont mis à jour
+ * @param journal de type tJournal, Entrée/Sortie : le journal d'annulation, ou NULL
+ */
+void progresser2(tEtatJeu *etat, tJournal *journal)
+{
+	tSerpent *serpent = &etat->serpents[1];
+	tCorps *corps = &serpent->corps;
+	tCasesLibres *casesLibres = &etat->casesLibres;
+	int *lesX = anneauxX(corps);
+	int *lesY = anneauxY(corps);
+	int xTete, yTete;
+	bool grandir = corps->aGrandir > 0;
+
+	// faire progresser la tete dans la nouvelle direction, en ressortant
+	// de l'autre côté quand le serpent traverse un trou
+	if (projeterCasePortails(portailsPartie(etat), lesX[0], lesY[0], indiceDirection(serpent->direction), &xTete, &yTete))
+	{
+		NOTER(journal, serpent->teleporter);
+		NOTER(journal, serpent->sortieDuTrou);
+		serpent->teleporter = true;
+		serpent->sortieDuTrou = true;
+	}
+
+	// le dernier élément quitte sa case, sauf si le serpent grandit
+	if (grandir)
+	{
+		NOTER(journal, corps->aGrandir);
+		corps->aGrandir--;
+	}
+	else
+	{
+		if (etat->affichage)
+		{
+			effacer(lesX[corps->taille - 1], lesY[corps->taille - 1], portailsPartie(etat));
+		}
+		libererCase(casesLibres, lesX[corps->taille - 1], lesY[corps->taille - 1], journal);
+	}
+	// l'ancienne tête devient un anneau
+	if (etat->affichage)
+	{
+		afficher(lesX[0], lesY[0], CORPS);
+	}
+	ajouterTete(corps, xTete, yTete, grandir, journal);
+	lesX = anneauxX(corps);
+	lesY = anneauxY(corps);
+	occuperCase(casesLibres, lesX[0], lesY[0], journal);
+
+	NOTER(journal, serpent->pommeMangee);
+	serpent->pommeMangee = false;
+	// détection d'une "collision" avec une pomme
+	if (etat->plateau[lesX[0]][lesY[0]] == POMME)
+	{
+		serpent->pommeMangee = true;
+		// la pomme disparait du plateau
+		NOTER(journal, etat->plateau[lesX[0]][lesY[0]]);
+		etat->plateau[lesX[0]][lesY[0]] = VIDE;
+		libererCase(casesLibres, lesX[0], lesY[0], journal);
+	}
+	// détection d'une collision avec la bordure, ou avec un anneau : la queue, si elle
+	// vient de quitter sa case, n'est plus dans le corps
+	else if (etat->plateau[lesX[0]][lesY[0]] == BORDURE || teteSurUnCorps(etat, 2))
+	{
+		NOTER(journal, serpent->collision);
+		serpent->collision = true;
+	}
+
+	if (etat->affichage)
+	{
+		afficher(lesX[0], lesY[0], TETE_SERPENT2);
+	}
+}
+
+/**
+ * @brief Procédure appelée quand un serpent a mangé une pomme : compte la pomme, fait
+ * grandir le serpent en mode croissance, remet à zéro les modes de direction, puis
+ * remplace la pomme et recalcule les chemins. Avec plusieurs pommes sur le plateau, les
+ * deux serpents peuvent en manger une chacun au même tour. La partie est gagnée quand
+ * toutes les pommes sont mangées ou quand plus aucune case n'est libre pour la suivante.
+ * @param etat de type tEtatJeu, Entrée/Sortie : la partie
+ * @param journal de type tJournal, Entrée/Sortie : le journal d'annulation, ou NULL
+ */
+void traiterPommeMangee(tEtatJeu *etat, tJournal *journal)
+{
+	tSerpent *serpent_S1 = &etat->serpents[0];
+	tSerpent *serpent_S2 = &etat->serpents[1];
+
+	NOTER(journal, etat->nbPommesMangee);
+	etat->nbPommesMangee += serpent_S1->pommeMangee + serpent_S2->pommeMangee;
+	if (serpent_S1->pommeMangee){
+		NOTER(journal, serpent_S1->nbPommesMangees);
+		serpent_S1->nbPommesMangees++;
+		if (etat->croissance)
+		{
+			NOTER(journal, serpent_S1->corps.aGrandir);
+			serpent_S1->corps.aGrandir++;
+		}
+	}
+	if (serpent_S2->pommeMangee){
+		NOTER(journal, serpent_S2->nbPommesMangees);
+		serpent_S2->nbPommesMangees++;
+		if (etat->croissance)
+		{
+			NOTER(journal, serpent_S2->corps.aGrandir);
+			serpent_S2->corps.aGrandir++;
+		}
+	}
+	NOTER(journal, etat->gagne);
+	etat->gagne = (!etat->croissance && etat->nbPommesMangee >= NB_POMMES);
+	for (int s = 0; s < 2; s++)
+	{
+		NOTER(journal, etat->serpents[s].teleporter);
+		NOTER(journal, etat->serpents[s].changement);
+		NOTER(journal, etat->serpents[s].sortieDuTrou);
+		etat->serpents[s].teleporter = false; // remet en false pour pouvoir se retéléporter après avoir manger une pomme
+		etat->serpents[s].changement = false;
+		etat->serpents[s].sortieDuTrou = false;
+	}
+
+	// une pomme remplace chaque pomme mangée ; plus aucune case libre : le plateau est plein
+	for (int s = 0; s < 2 && !etat->gagne; s++)
+	{
+		if (etat->serpents[s].pommeMangee)
+		{
+			etat->gagne = !ajouterPomme(etat, journal);
+		}
+	}
+	if (!etat->gagne)
+	{
+		NOTER(journal, serpent_S1->meilleureDistance);
+		serpent_S1->meilleureDistance = calculerDistance1(anneauxX(&serpent_S1->corps), anneauxY(&serpent_S1->corps), etat->pommeX, etat->pommeY, &etat->contexte->portails); // recalcul la meilleur position après l'apparition d'une nouvelle pomme
+		NOTER(journal, serpent_S2->meilleureDistance);
+		serpent_S2->meilleureDistance = calculerDistance2(anneauxX(&serpent_S2->corps), anneauxY(&serpent_S2->corps), etat->pommeX, etat->pommeY, &etat->contexte->portails); // recalcul la meilleur position après l'apparition d'une nouvelle pomme
+		NOTER(journal, etat->DistancePommePave);
+		etat->DistancePommePave = calculerDistancePommePave(etat); // recalcul quel pave est le plus proche de la pomme
+		if(serpent_S1->meilleureDistance == CHEMIN_POMME){
+			NOTER(journal, serpent_S1->changement);
+			NOTER(journal, serpent_S1->teleporter);
+			serpent_S1->changement = changementDirection(etat, 1);
+			serpent_S1->teleporter = true;
+		}
+		if(serpent_S2->meilleureDistance == CHEMIN_POMME){
+			NOTER(journal, serpent_S2->changement);
+			NOTER(journal, serpent_S2->teleporter);
+			serpent_S2->changement = changementDirection(etat, 2);
+			serpent_S2->teleporter = true;
+		}
+		NOTER(journal, serpent_S1->pommeMangee);
+		serpent_S1->pommeMangee = false;
+		NOTER(journal, serpent_S2->pommeMangee);
+		serpent_S2->pommeMangee = false;
+	}
+}
+
+/**
+ * @brief Fonction qui dit si une partie est terminée : collision d'un serpent, toutes les
+ * pommes mangées ou plateau plein.
+ * @param etat de type tEtatJeu, Entrée : la partie
+ */
+bool partieFinie(const tEtatJeu *etat)
+{
+	return etat->gagne || etat->serpents[0].collision || etat->serpents[1].collision;
+}
+
+/**
+ * @brief Fonction qui donne la table des portails à passer aux déplacements : celle de la
+ * carte de la partie si elle a des portails, NULL sinon pour s'en tenir aux noyaux du plateau.
+ * @param etat de type tEtatJeu, Entrée : la partie
+ */
+const tPortails *portailsPartie(const tEtatJeu *etat)
+{
+	return (etat->contexte->portails.nbPaires > 0) ? &etat->contexte->portails : NULL;
+}
+
+/**
+ * @brief Procédure qui joue un tour où les deux serpents se déplacent en même temps,
+ * comme en mode parallèle. Chaque serpent prend la direction imposée, ou décide lui-même
+ * sur l'état du début du tour si aucune direction n'est imposée. Une partie terminée
+ * n'avance plus.
+ * @param etat de type tEtatJeu, Entrée/Sortie : la partie
+ * @param directions de type char tableau, Entrée : la direction imposée à chaque serpent
+ * (HAUT, BAS, GAUCHE, DROITE), ou 0 pour laisser décider le serpent
+ */
+void jouerTourSimultane(tEtatJeu *etat, const char directions[2])
+{
+	if (partieFinie(etat))
+	{
+		return;
+	}
+	deciderTour(etat, directions);
+	appliquerTour(etat, NULL);
+}
+
+/**
+ * @brief Procédure qui fixe la direction de chaque serpent pour le tour : la direction
+ * imposée, ou celle qu'il décide sur l'état du début du tour.
+ * @param etat de type tEtatJeu, Entrée/Sortie : la partie
+ * @param directions de type char tableau, Entrée : la direction imposée à chaque serpent, ou 0
+ */
+void deciderTour(tEtatJeu *etat, const char directions[2])
+{
+	for (int s = 0; s < 2; s++)
+	{
+		tSerpent *serpent = &etat->serpents[s];
+		if (directions[s] == HAUT || directions[s] == BAS || directions[s] == GAUCHE || directions[s] == DROITE)
+		{
+			serpent->direction = directions[s];
+		}
+		else
+		{
+			// chaque décision ne modifie que les variables de son serpent
+			deciderSerpent(etat, s + 1, &serpent->direction, &serpent->changement, &serpent->sortieDuTrou);
+		}
+	}
+}
+
+/**
+ * @brief Procédure qui joue un tour déjà décidé (deciderTour) : conflits, déplacement des
+ * deux serpents et pomme mangée, chaque modification de l'état étant notée dans le journal.
+ * @param etat de type tEtatJeu, Entrée/Sortie : la partie
+ * @param journal de type tJournal, Entrée/Sortie : le journal d'annulation, ou NULL
+ */
+void appliquerTour(tEtatJeu *etat, tJournal *journal)
+{
+	resoudreConflits(etat, journal);
+	progresser1(etat, journal);
+	progresser2(etat, journal);
+	NOTER(journal, etat->serpents[0].deplacements);
+	NOTER(journal, etat->serpents[1].deplacements);
+	etat->serpents[0].deplacements++;
+	etat->serpents[1].deplacements++;
+	if (etat->serpents[0].pommeMangee || etat->serpents[1].pommeMangee)
+	{
+		traiterPommeMangee(etat, journal);
+	}
+}
+
+/************************************************/
+/*			 JOURNAL D'ANNULATION 				*/
+/************************************************/
+
+/**
+ * @brief Procédure qui note l'ancienne valeur d'un champ de l'état avant sa modification.
+ * Sans journal (partie réelle), rien n'est noté.
+ * @param journal de type tJournal, Entrée/Sortie : le journal d'annulation, ou NULL
+ * @param adresse de type void, Entrée : le champ qui va être modifié
+ * @param taille de type int, Entrée : la taille du champ en octets
+ */
+void noterModification(tJournal *journal, void *adresse, int taille)
+{
+	if (journal == NULL)
+	{
+		return;
+	}
+	if (journal->nbModifications == CAPACITE_JOURNAL)
+	{
+		// le journal n'est pas vidé entre deux tours
+		fprintf(stderr, "Journal d'annulation plein (%d modifications)\n", CAPACITE_JOURNAL);
+		exit(EXIT_FAILURE);
+	}
+	tModification *modification = &journal->modifications[journal->nbModifications++];
+	modification->adresse = adresse;
+	modification->taille = taille;
+	memcpy(modification->ancienne, adresse, taille);
+}
+
+/**
+ * @brief Procédure qui note la recopie d'un corps au fond de son tampon : elle s'annule
+ * en recopiant le corps au début du tampon, sans noter chacun de ses anneaux.
+ * @param journal de type tJournal, Entrée/Sortie : le journal d'annulation, ou NULL
+ * @param corps de type tCorps, Entrée : le corps qui va être recopié
+ * @param debut de type int, Entrée : l'indice où commencera le corps recopié
+ */
+void noterRecopieCorps(tJournal *journal, tCorps *corps, int debut)
+{
+	if (journal != NULL)
+	{
+		noterModification(journal, corps, 0);
+		journal->modifications[journal->nbModifications - 1].taille = RECOPIE_CORPS;
+		memcpy(journal->modifications[journal->nbModifications - 1].ancienne, &debut, sizeof(debut));
+	}
+}
+
+/**
+ * @brief Procédure qui ramène l'état à ce qu'il était quand le journal comptait repere
+ * modifications, en remettant les anciennes valeurs de la plus récente à la plus ancienne.
+ * Le coût est proportionnel au nombre de champs notés depuis le repère. Seules les cases
+ * vivantes des corps sont rétablies : la recopie d'un corps au fond de son tampon laisse
+ * au fond des anneaux morts, qui ne sont jamais lus (voir normaliserCorps).
+ * @param journal de type tJournal, Entrée/Sortie : le journal d'annulation
+ * @param repere de type int, Entrée : la valeur de journal->nbModifications à retrouver
+ */
+void annulerJournal(tJournal *journal, int repere)
+{
+	while (journal->nbModifications > repere)
+	{
+		tModification *modification = &journal->modifications[--journal->nbModifications];
+		if (modification->taille == RECOPIE_CORPS)
+		{
+			// la taille du corps est déjà revenue à celle du moment de la recopie
+			tCorps *corps = modification->adresse;
+			int debut;
+			memcpy(&debut, modification->ancienne, sizeof(debut));
+			memmove(corps->lesX, &corps->lesX[debut], corps->taille * sizeof(int));
+			memmove(corps->lesY, &corps->lesY[debut], corps->taille * sizeof(int));
+		}
+		else
+		{
+			memcpy(modification->adresse, modification->ancienne, modification->taille);
+		}
+	}
+}
+
+/**
+ * @brief Procédure qui met à zéro les cases des tampons de corps qui ne portent pas
+ * d'anneau, pour que deux états qui ne diffèrent que par des anneaux morts soient égaux
+ * octet à octet.
+ * @param etat de type tEtatJeu, Entrée/Sortie : la partie
+ */
+void normaliserCorps(tEtatJeu *etat)
+{
+	for (int s = 0; s < 2; s++)
+	{
+		tCorps *corps = &etat->serpents[s].corps;
+		int fin = corps->tete + corps->taille;
+		memset(corps->lesX, 0, corps->tete * sizeof(int));
+		memset(corps->lesY, 0, corps->tete * sizeof(int));
+		memset(&corps->lesX[fin], 0, (CAPACITE_CORPS - fin) * sizeof(int));
+		memset(&corps->lesY[fin], 0, (CAPACITE_CORPS - fin) * sizeof(int));
+	}
+}
+
+/**
+ * @brief Fonction qui vérifie le journal d'annulation sur des parties sans affichage : à
+ * chaque tour, une fois les directions décidées, le tour est joué avec le journal, annulé
+ * et comparé octet à octet à l'état d'avant, puis rejoué sans journal et comparé à l'état
+ * obtenu avec le journal. Le plus grand nombre de modifications notées en un tour est
+ * comparé à CAPACITE_JOURNAL. Après chaque tour, aucune tête ne doit être sur un anneau
+ * sans que son serpent soit en collision : une partie (avec --croissance, jusqu'à des
+ * milliers d'anneaux) ne finit que sur une vraie collision, le plateau plein ou toutes ses
+ * pommes mangées, ou après LIMITE_TOURS_TOURNOI tours ; les fins de partie sont comptées.
+ * @param contexte de type tContexte, Entrée : la carte et les portails des parties
+ * @param nbParties de type int, Entrée : le nombre de parties
+ * @param graine de type uint64_t, Entrée : la graine de la première partie, les suivantes
+ * prenant les graines suivantes
+ * @param pommesProcedurales de type bool, Entrée : pommes tirées parmi les cases libres
+ * @param croissance de type bool, Entrée : serpents qui grandissent
+ * @param nbPommes de type int, Entrée : le nombre de pommes présentes en même temps
+ * @param strategies de type int tableau, Entrée : la stratégie de chaque serpent
+ * @return EXIT_SUCCESS si chaque tour a été annulé et rejoué à l'identique sans qu'une tête
+ * passe sur un corps, EXIT_FAILURE sinon
+ */
+int lancerVerificationJournal(const tContexte *contexte, int nbParties, uint64_t graine, bool pommesProcedurales, bool croissance, int nbPommes, const int strategies[2])
+{
+	tEtatJeu *etats = malloc(3 * sizeof(tEtatJeu));
+	tJournal *journal = malloc(sizeof(tJournal));
+	if (etats == NULL || journal == NULL)
+	{
+		fprintf(stderr, "Mémoire insuffisante pour la vérification du journal\n");
+		free(etats);
+		free(journal);
+		return EXIT_FAILURE;
+	}
+	tEtatJeu *etat = &etats[0], *avant = &etats[1], *apres = &etats[2];
+	const char directionsIA[2] = {0, 0};
+	long long tours = 0, ecartsAnnulation = 0, ecartsRejeu = 0, traversees = 0;
+	int plusLong = 0, plusGrand = 0, gagnees = 0, collisions = 0, arretees = 0;
+	journal->nbModifications = 0;
+	for (int p = 0; p < nbParties; p++)
+	{
+		initEtatJeu(etat, contexte, graine + p, pommesProcedurales, croissance, nbPommes);
+		etat->serpents[0].strategie = strategies[0];
+		etat->serpents[1].strategie = strategies[1];
+		while (!partieFinie(etat) && etat->serpents[0].deplacements < LIMITE_TOURS_TOURNOI)
+		{
+			deciderTour(etat, directionsIA);
+			normaliserCorps(etat);
+			memcpy(avant, etat, sizeof(tEtatJeu));
+
+			appliquerTour(etat, journal);
+			if (journal->nbModifications > plusLong)
+			{
+				plusLong = journal->nbModifications;
+			}
+			memcpy(apres, etat, sizeof(tEtatJeu));
+			normaliserCorps(apres);
+
+			annulerJournal(journal, 0);
+			normaliserCorps(etat);
+			if (memcmp(etat, avant, sizeof(tEtatJeu)) != 0)
+			{
+				ecartsAnnulation++;
+				memcpy(etat, avant, sizeof(tEtatJeu));
+			}
+
+			appliquerTour(etat, NULL);
+			normaliserCorps(etat);
+			if (memcmp(etat, apres, sizeof(tEtatJeu)) != 0)
+			{
+				ecartsRejeu++;
+			}
+			for (int s = 0; s < 2; s++)
+			{
+				traversees += !etat->serpents[s].collision && teteSurUnCorps(etat, s + 1);
+				if (etat->serpents[s].corps.taille > plusGrand)
+				{
+					plusGrand = etat->serpents[s].corps.taille;
+				}
+			}
+			tours++;
+		}
+		gagnees += etat->gagne;
+		collisions += !etat->gagne && partieFinie(etat);
+		arretees += !partieFinie(etat);
+	}
+	printf("%d parties, %lld tours : %lld annulations et %lld rejeux différents, au plus %d modifications par tour (capacité %d)\n",
+		   nbParties, tours, ecartsAnnulation, ecartsRejeu, plusLong, CAPACITE_JOURNAL);
+	printf("Fins de partie : %d gagnées, %d sur une collision, %d arrêtées après %d tours ; serpent le plus long : %d anneaux, %lld têtes sur un corps sans collision\n",
+		   gagnees, collisions, arretees, LIMITE_TOURS_TOURNOI, plusGrand, traversees);
+	free(etats);
+	free(journal);
+	return (ecartsAnnulation == 0 && ecartsRejeu == 0 && traversees == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/************************************************/
+/*			 REPARTITEUR DE TACHES 				*/
+/************************************************/
+
+/**
+ * @brief Procédure qui initialise le répartiteur et lance ses fils ouvriers.
+ * Le fil principal est l'ouvrier 0, qui n'exécute pas de tâche : les fils sont les
+ * ouvriers 1 à nbFils.
+ * @param repartiteur de type tRepartiteur, Sortie : le répartiteur à initialiser
+ * @param nbFils de type int, Entrée : le nombre de fils ouvriers, au moins 1
+ * @return true si tous les fils ont été lancés ; sinon ceux qui l'ont été sont déjà arrêtés
+ */
+bool initRepartiteur(tRepartiteur *repartiteur, int nbFils)
+{
+	int nbOuvriers = nbFils + 1;
+	repartiteur->nbOuvriers = nbOuvriers;
+	atomic_init(&repartiteur->arret, false);
+	atomic_init(&repartiteur->generation, 0);
+	for (int i = 0; i < nbOuvriers; i++)
+	{
+		atomic_init(&repartiteur->files[i].haut, 0);
+		atomic_init(&repartiteur->files[i].bas, 0);
+	}
+	for (int i = 1; i < nbOuvriers; i++)
+	{
+		tOuvrier *ouvrier = malloc(sizeof(tOuvrier));
+		bool lance = false;
+		if (ouvrier != NULL)
+		{
+			ouvrier->repartiteur = repartiteur;
+			ouvrier->indice = i;
+			lance = (pthread_create(&repartiteur->fils[i], NULL, filOuvrier, ouvrier) == 0);
+		}
+		if (!lance)
+		{
+			// les ouvriers déjà lancés n'ont encore aucune tâche : ils s'arrêtent aussitôt
+			fprintf(stderr, "Impossible de lancer l'ouvrier %d\n", i);
+			free(ouvrier);
+			atomic_store(&repartiteur->arret, true);
+			for (int j = 1; j < i; j++)
+			{
+				pthread_join(repartiteur->fils[j], NULL);
+			}
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Procédure qui arrête les fils ouvriers et attend leur fin.
+ * @param repartiteur de type tRepartiteur, Entrée : le répartiteur à arrêter
+ */
+void arreterRepartiteur(tRepartiteur *repartiteur)
+{
+	atomic_store(&repartiteur->arret, true);
+	for (int i = 1; i < repartiteur->nbOuvriers; i++)
+	{
+		pthread_join(repartiteur->fils[i], NULL);
+	}
+}
+
+/**
+ * @brief Fonction qui renvoie true si les tâches de la génération donnée ont été annulées.
+ * Les tâches longues l'appellent régulièrement pour s'arrêter au plus tôt.
+ * @param repartiteur de type tRepartiteur, Entrée : le répartiteur
+ * @param generation de type unsigned, Entrée : la génération au lancement de la tâche
+ */
+bool tacheAnnulee(tRepartiteur *repartiteur, unsigned generation)
+{
+	return atomic_load_explicit(&repartiteur->generation, memory_order_relaxed) != generation;
+}
+
+/**
+ * @brief Fonction qui dépile une tâche par le bas de la file de son propriétaire.
+ * L'écriture de bas et la lecture de haut sont séquentiellement cohérentes, comme celles
+ * des voleurs : un voleur et le propriétaire ne peuvent pas prendre tous deux la dernière tâche.
+ * @return la tâche, ou NULL si la file est vide
+ */
+tTache *depilerTache(tFileTaches *file)
+{
+	long bas = atomic_load_explicit(&file->bas, memory_order_relaxed) - 1;
+	atomic_store_explicit(&file->bas, bas, memory_order_seq_cst);
+	long haut = atomic_load_explicit(&file->haut, memory_order_seq_cst);
+	tTache *tache = NULL;
+
+	if (haut <= bas)
+	{
+		tache = atomic_load_explicit(&file->taches[bas & (CAPACITE_FILE - 1)], memory_order_acquire);
+		if (haut == bas)
+		{
+			// dernière tâche : course possible avec un voleur
+			if (!atomic_compare_exchange_strong_explicit(&file->haut, &haut, haut + 1, memory_order_seq_cst, memory_order_relaxed))
+			{
+				tache = NULL;
+			}
+			atomic_store_explicit(&file->bas, bas + 1, memory_order_relaxed);
+		}
+	}
+	else
+	{
+		atomic_store_explicit(&file->bas, bas + 1, memory_order_relaxed);
+	}
+	return tache;
+}
+
+/**
+ * @brief Fonction qui vole une tâche par le haut de la file d'un autre ouvrier.
+ * La lecture de la case (acquisition) voit la tâche publiée par soumettreTache.
+ * @return la tâche, ou NULL si la file est vide ou si un autre voleur a gagné
+ */
+tTache *volerTache(tFileTaches *file)
+{
+	long haut = atomic_load_explicit(&file->haut, memory_order_seq_cst);
+	long bas = atomic_load_explicit(&file->bas, memory_order_seq_cst);
+	tTache *tache = NULL;
+
+	if (haut < bas)
+	{
+		tache = atomic_load_explicit(&file->taches[haut & (CAPACITE_FILE - 1)], memory_order_acquire);
+		if (!atomic_compare_exchange_strong_explicit(&file->haut, &haut, haut + 1, memory_order_seq_cst, memory_order_relaxed))
+		{
+			tache = NULL;
+		}
+	}
+	return tache;
+}
+
+/**
+ * @brief Procédure qui exécute une tâche puis la retire de son groupe.
+ */
+void executerTache(tRepartiteur *repartiteur, int ouvrier, tTache *tache)
+{
+	tache->fonction(repartiteur, ouvrier, tache->argument);
+	atomic_fetch_sub_explicit(tache->groupe, 1, memory_order_release);
+}
+
+/**
+ * @brief Procédure qui ajoute une tâche dans la file de l'ouvrier qui la crée.
+ * Si la file est pleine, la tâche est exécutée tout de suite.
+ * @param repartiteur de type tRepartiteur, Entrée : le répartiteur
+ * @param ouvrier de type int, Entrée : l'indice de l'ouvrier qui soumet la tâche
+ * @param tache de type tTache, Entrée : la tâche, qui doit rester valide jusqu'à la fin de son groupe
+ */
+void soumettreTache(tRepartiteur *repartiteur, int ouvrier, tTache *tache)
+{
+	tFileTaches *file = &repartiteur->files[ouvrier];
+	long bas = atomic_load_explicit(&file->bas, memory_order_relaxed);
+	long haut = atomic_load_explicit(&file->haut, memory_order_acquire);
+
+	if (bas - haut >= CAPACITE_FILE)
+	{
+		executerTache(repartiteur, ouvrier, tache);
+	}
+	else
+	{
+		// la case puis bas sont publiés (libération) : qui voit l'un voit la tâche entière
+		atomic_store_explicit(&file->taches[bas & (CAPACITE_FILE - 1)], tache, memory_order_release);
+		atomic_store_explicit(&file->bas, bas + 1, memory_order_release);
+	}
+}
+
+/**
+ * @brief Fonction qui cherche une tâche : d'abord dans la file de l'ouvrier, puis en
+ * volant les autres ouvriers à partir d'une victime tirée au hasard.
+ * @param graine de type unsigned, Entrée/Sortie : l'état du tirage de la victime
+ * @return la tâche, ou NULL si aucune n'a été trouvée
+ */
+tTache *trouverTache(tRepartiteur *repartiteur, int ouvrier, unsigned *graine)
+{
+	tTache *tache = depilerTache(&repartiteur->files[ouvrier]);
+	if (tache == NULL && repartiteur->nbOuvriers > 1)
+	{
+		*graine ^= *graine << 13;
+		*graine ^= *graine >> 17;
+		*graine ^= *graine << 5;
+		int depart = *graine % repartiteur->nbOuvriers;
+		for (int i = 0; i < repartiteur->nbOuvriers && tache == NULL; i++)
+		{
+			int victime = (depart + i) % repartiteur->nbOuvriers;
+			if (victime != ouvrier)
+			{
+				tache = volerTache(&repartiteur->files[victime]);
+			}
+		}
+	}
+	return tache;
+}
+
+/**
+ * @brief Fonction exécutée par chaque fil ouvrier : exécute ou vole des tâches jusqu'à l'arrêt,
+ * en laissant la main de plus en plus longtemps quand il n'y a rien à faire.
+ * @param ouvrier de type tOuvrier, Entrée : le répartiteur et l'indice de l'ouvrier
+ */
+void *filOuvrier(void *ouvrier)
+{
+	tOuvrier *o = ouvrier;
+	tRepartiteur *repartiteur = o->repartiteur;
+	int indice = o->indice;
+	unsigned graine = 2654435761u * (indice + 1);
+	int attente = 0;
+	free(o);
+
+	while (!atomic_load_explicit(&repartiteur->arret, memory_order_relaxed))
+	{
+		tTache *tache = trouverTache(repartiteur, indice, &graine);
+		if (tache != NULL)
+		{
+			executerTache(repartiteur, indice, tache);
+			attente = 0;
+		}
+		else if (attente < 64)
+		{
+			attente++;
+			sched_yield();
+		}
+		else
+		{
+			usleep(50);
+		}
+	}
+	return NULL;
+}
+
+/**
+ * @brief Fonction qui attend la fin d'un groupe de tâches en aidant à les exécuter.
+ * Si l'échéance est dépassée, les tâches en cours sont annulées (la génération change)
+ * et l'attente s'arrête aussitôt : l'appelant tient les tâches pas encore finies pour
+ * annulées. Elles désignent encore leurs arguments et le compteur du groupe, que
+ * l'appelant ne réutilise qu'après une nouvelle attente, sans échéance.
+ * @param repartiteur de type tRepartiteur, Entrée : le répartiteur
+ * @param ouvrier de type int, Entrée : l'indice de l'ouvrier qui attend
+ * @param groupe de type atomic_int, Entrée : le nombre de tâches du groupe pas encore finies
+ * @param echeance de type long long, Entrée : l'échéance en microsecondes, 0 pour aucune
+ * @return true si le groupe a fini avant l'échéance, false s'il a été annulé
+ */
+bool attendreGroupe(tRepartiteur *repartiteur, int ouvrier, atomic_int *groupe, long long echeance)
+{
+	unsigned graine = 2654435761u * (ouvrier + 1);
+
+	while (atomic_load_explicit(groupe, memory_order_acquire) > 0)
+	{
+		tTache *tache = trouverTache(repartiteur, ouvrier, &graine);
+		if (tache != NULL)
+		{
+			executerTache(repartiteur, ouvrier, tache);
+		}
+		else
+		{
+			sched_yield();
+		}
+		if (echeance != 0 && maintenantMicro() > echeance)
+		{
+			atomic_fetch_add(&repartiteur->generation, 1);
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief Fonction qui attend la fin d'un groupe de tâches sans en exécuter aucune : c'est
+ * l'attente du fil principal, qui reste ainsi libre d'annuler le groupe dès l'échéance,
+ * comme attendreGroupe, au lieu d'être pris dans une tâche jusqu'à sa fin.
+ * @param repartiteur de type tRepartiteur, Entrée : le répartiteur
+ * @param groupe de type atomic_int, Entrée : le nombre de tâches du groupe pas encore finies
+ * @param echeance de type long long, Entrée : l'échéance en microsecondes, 0 pour aucune
+ * @return true si le groupe a fini avant l'échéance, false s'il a été annulé
+ */
+bool surveillerGroupe(tRepartiteur *repartiteur, atomic_int *groupe, long long echeance)
+{
+	while (atomic_load_explicit(groupe, memory_order_acquire) > 0)
+	{
+		if (echeance != 0 && maintenantMicro() > echeance)
+		{
+			atomic_fetch_add(&repartiteur->generation, 1);
+			return false;
+		}
+		sched_yield();
+	}
+	return true;
+}
+
+/**
+ * @brief Tâche de décision d'un serpent : lance une sous-tâche de remplissage par direction,
+ * prend la décision habituelle, puis l'écarte si elle mène dans un espace trop petit pour
+ * le serpent alors qu'une autre direction libre offre plus de place.
+ * La décision est écrite dans l'instantané, puis l'issue passe à DECISION_PRISE si le fil
+ * principal ne l'a pas annulée avant ; sinon le serpent garde sa direction.
+ * Les remplissages et l'attente s'arrêtent à l'échéance du tour ; seule la décision
+ * habituelle, de durée bornée, n'est pas interrompue.
+ * @param argument de type tDecisionTour, Entrée/Sortie : le serpent, son instantané et ses remplissages
+ */
+void tacheDecision(tRepartiteur *repartiteur, int ouvrier, void *argument)
+{
+	tDecisionTour *tour = argument;
+	tDecideur *d = &tour->decideur;
+	atomic_int groupe = 4;
+
+	if (tacheAnnulee(repartiteur, tour->generation))
+	{
+		return;
+	}
+	for (int i = 0; i < 4; i++)
+	{
+		tour->remplissages[i] = (tRemplissage){d, tour->generation, tour->echeance, i, 0};
+		tour->sousTaches[i] = (tTache){tacheRemplissage, &tour->remplissages[i], &groupe};
+		soumettreTache(repartiteur, ouvrier, &tour->sousTaches[i]);
+	}
+
+	// décision habituelle pendant que les remplissages sont volés par les autres ouvriers
+	tSerpent *serpent = &d->etat->serpents[d->numero - 1];
+	char direction = serpent->direction;
+	bool changement = serpent->changement;
+	bool sortieDuTrou = serpent->sortieDuTrou;
+	deciderSerpent(d->etat, d->numero, &direction, &changement, &sortieDuTrou);
+
+	// à l'échéance, les remplissages restants s'arrêtent aussitôt : le groupe, sur la pile
+	// de cette tâche, est attendu jusqu'au bout avant de la quitter
+	if (!attendreGroupe(repartiteur, ouvrier, &groupe, tour->echeance))
+	{
+		attendreGroupe(repartiteur, ouvrier, &groupe, 0);
+	}
+	if (!tacheAnnulee(repartiteur, tour->generation))
+	{
+		int choisie = indiceDirection(direction);
+		int plusGrand = choisie;
+		for (int i = 0; i < 4; i++)
+		{
+			if (tour->remplissages[i].espace > tour->remplissages[plusGrand].espace)
+			{
+				plusGrand = i;
+			}
+		}
+		if (tour->remplissages[choisie].espace < serpent->corps.taille)
+		{
+			direction = LES_DIRECTIONS[plusGrand];
+		}
+		serpent->direction = direction;
+		serpent->changement = changement;
+		serpent->sortieDuTrou = sortieDuTrou;
+		int enCours = DECISION_EN_COURS;
+		atomic_compare_exchange_strong(&tour->issue, &enCours, DECISION_PRISE);
+	}
+}
+
+/**
+ * @brief Tâche qui mesure l'espace libre accessible après un coup du serpent.
+ * @param argument de type tRemplissage, Entrée/Sortie : le serpent, la direction et le résultat
+ */
+void tacheRemplissage(tRepartiteur *repartiteur, int ouvrier, void *argument)
+{
+	tRemplissage *remplissage = argument;
+	(void)ouvrier;
+	remplissage->espace = compterEspaceLibre(remplissage->decideur, remplissage->direction, repartiteur,
+											 remplissage->generation, remplissage->echeance);
+}
+
+/**
+ * @brief Fonction qui compte, par un parcours en largeur sur le plateau en bits, les cases
+ * libres accessibles depuis la case où mène la direction donnée ; les corps des deux
+ * serpents sont des murs. Le parcours s'arrête dès que la tâche est annulée ou que son
+ * échéance est passée, vérifiées à chaque couche.
+ * @param decideur de type tDecideur, Entrée : le serpent et l'état du tour
+ * @param direction de type int, Entrée : l'indice de la direction jouée
+ * @param repartiteur de type tRepartiteur, Entrée : le répartiteur, pour l'annulation, ou
+ * NULL hors répartiteur
+ * @param generation de type unsigned, Entrée : la génération de la tâche
+ * @param echeance de type long long, Entrée : l'échéance de la tâche en microsecondes, 0 pour aucune
+ * @return le nombre de cases accessibles, 0 si le coup est bloqué
+ */
+int compterEspaceLibre(tDecideur *decideur, int direction, tRepartiteur *repartiteur, unsigned generation, long long echeance)
+{
+	char cases[(LARGEUR_PLATEAU + 1) * (HAUTEUR_PLATEAU + 1)];
+	tBitboard restantes, frontiere = {{0}};
+	int x, y;
+
+	tEtatJeu *etat = decideur->etat;
+	tCorps *corps = &etat->serpents[decideur->numero - 1].corps;
+	const tPortails *portails = portailsPartie(etat);
+	bloquerCorps(etat, cases);
+	rangerBitboard(cases, &restantes);
+
+	projeterCasePortails(portails, anneauxX(corps)[0], anneauxY(corps)[0], direction, &x, &y);
+	int depart = cellule_80x40(&GEOMETRIE_PLATEAU, x, y);
+	if (cases[depart] == BORDURE)
+	{
+		return 0;
+	}
+	poserBit(&frontiere, depart);
+	restantes.colonnes[x] &= ~frontiere.colonnes[x];
+
+	int libres = compterBits(&restantes);
+	while (avancerCouche(&frontiere, &restantes, portails) && (repartiteur == NULL || !tacheAnnulee(repartiteur, generation))
+		   && (echeance == 0 || maintenantMicro() <= echeance))
+	{
+	}
+	// les cases atteintes, départ compris, ne sont plus restantes
+	return 1 + libres - compterBits(&restantes);
+}
+
+/**
+ * @brief Fonction qui renvoie l'heure d'une horloge monotone, en microsecondes
+ */
+long long maintenantMicro()
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1000000LL + t.tv_nsec / 1000;
+}
+
+/**
+ * @brief Fonction qui donne l'heure d'une horloge monotone, en nanosecondes.
+ */
+long long maintenantNano()
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+
+/************************************************/
+/*			 GENERATEUR ALEATOIRE 				*/
+/************************************************/
+
+/**
+ * @brief Procédure qui initialise le générateur d'une partie à partir de sa graine.
+ * Les quatre mots d'état sont tirés par splitmix64 pour ne jamais être tous nuls.
+ * @param generateur de type tGenerateur, Sortie : le générateur à initialiser
+ * @param graine de type uint64_t, Entrée : la graine de la partie
+ */
+void initGenerateur(tGenerateur *generateur, uint64_t graine)
+{
+	for (int i = 0; i < 4; i++)
+	{
+		graine += 0x9E3779B97F4A7C15ULL;
+		uint64_t z = graine;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		generateur->etat[i] = (uint32_t)((z ^ (z >> 31)) >> 32);
+	}
+}
+
+/**
+ * @brief Fonction qui tire le nombre pseudo-aléatoire suivant (xoshiro128**).
+ * @param generateur de type tGenerateur, Entrée/Sortie : le générateur de la partie
+ * @return un entier sur 32 bits
+ */
+uint32_t tirerAleatoire(tGenerateur *generateur)
+{
+	uint32_t *e = generateur->etat;
+	uint32_t resultat = e[1] * 5;
+	resultat = ((resultat << 7) | (resultat >> 25)) * 9;
+	uint32_t t = e[1] << 9;
+
+	e[2] ^= e[0];
+	e[3] ^= e[1];
+	e[1] ^= e[2];
+	e[0] ^= e[3];
+	e[2] ^= t;
+	e[3] = (e[3] << 11) | (e[3] >> 21);
+	return resultat;
+}
+
+/**
+ * @brief Fonction qui tire un entier uniforme dans [0, borne[ sans biais, par multiplication
+ * plutôt que par modulo (méthode de Lemire).
+ * @param generateur de type tGenerateur, Entrée/Sortie : le générateur de la partie
+ * @param borne de type uint32_t, Entrée : la borne exclue, strictement positive
+ */
+uint32_t tirerBorne(tGenerateur *generateur, uint32_t borne)
+{
+	uint64_t produit = (uint64_t)tirerAleatoire(generateur) * borne;
+	uint32_t bas = (uint32_t)produit;
+	if (bas < borne)
+	{
+		uint32_t seuil = -borne % borne;
+		while (bas < seuil)
+		{
+			produit = (uint64_t)tirerAleatoire(generateur) * borne;
+			bas = (uint32_t)produit;
+		}
+	}
+	return (uint32_t)(produit >> 32);
+}
+
+/************************************************/
+/*			 NOYAU DE COLLISION 				*/
+/************************************************/
+
+/**
+ * @brief Procédure qui choisit une seule fois, au lancement, les noyaux de collision, du
+ * plateau en bits et de la politique les plus rapides supportés par le processeur (AVX2,
+ * avec FMA pour la politique, puis SSE2, sinon scalaire).
+ */
+void initNoyauCollision()
+{
+#ifdef NOYAU_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+	{
+		collisionCorps = collisionCorpsAVX2;
+		collisionCandidats = collisionCandidatsAVX2;
+		etendreBitboard = etendreBitboardAVX2;
+		avancerCouche = avancerCoucheAVX2;
+		if (__builtin_cpu_supports("fma"))
+		{
+			appliquerCouche = appliquerCoucheAVX2;
+		}
+	}
+	else if (__builtin_cpu_supports("sse2"))
+	{
+		collisionCorps = collisionCorpsSSE2;
+		collisionCandidats = collisionCandidatsSSE2;
+	}
+#endif
+}
+
+/**
+ * @brief Fonction qui teste si la case (x, y) est occupée par un des anneaux du corps, une case à la fois
+ * @param lesX de type int tableau, Entrée : le tableau des X du corps
+ * @param lesY de type int tableau, Entrée : le tableau des Y du corps
+ * @param taille de type int, Entrée : le nombre d'anneaux à tester
+ * @param x de type int, Entrée : la coordonnée en X de la case
+ * @param y de type int, Entrée : la coordonnée en Y de la case
+ * @return true si un anneau occupe la case, false sinon
+ */
+bool collisionCorpsScalaire(const int lesX[], const int lesY[], int taille, int x, int y)
+{
+	for (int i = 0; i < taille; i++)
+	{
+		if (lesX[i] == x && lesY[i] == y)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Fonction qui teste en une seule passe sur le corps les quatre cases candidates
+ * @param lesX de type int tableau, Entrée : le tableau des X du corps
+ * @param lesY de type int tableau, Entrée : le tableau des Y du corps
+ * @param taille de type int, Entrée : le nombre d'anneaux à tester
+ * @param candidatsX de type int tableau, Entrée : les X des quatre cases candidates
+ * @param candidatsY de type int tableau, Entrée : les Y des quatre cases candidates
+ * @return un masque dont le bit d est à 1 si la case candidate d est occupée
+ */
+int collisionCandidatsScalaire(const int lesX[], const int lesY[], int taille, const int candidatsX[4], const int candidatsY[4])
+{
+	int masque = 0;
+	for (int i = 0; i < taille; i++)
+	{
+		for (int d = 0; d < 4; d++)
+		{
+			if (lesX[i] == candidatsX[d] && lesY[i] == candidatsY[d])
+			{
+				masque |= 1 << d;
+			}
+		}
+	}
+	return masque;
+}
+
+#ifdef NOYAU_X86
+/**
+ * @brief Version SSE2 de collisionCorpsScalaire : 4 anneaux par comparaison.
+ * X et Y sont regroupés dans une clé 32 bits (CLE_CASE) pour ne faire qu'une comparaison par anneau.
+ */
+__attribute__((target("sse2"))) bool collisionCorpsSSE2(const int lesX[], const int lesY[], int taille, int x, int y)
+{
+	__m128i cle = _mm_set1_epi32(CLE_CASE(x, y));
+	int i = 0;
+	for (; i + 8 <= taille; i += 8)
+	{
+		__m128i cles0 = _mm_or_si128(_mm_slli_epi32(_mm_loadu_si128((const __m128i *)&lesX[i]), 16), _mm_loadu_si128((const __m128i *)&lesY[i]));
+		__m128i cles1 = _mm_or_si128(_mm_slli_epi32(_mm_loadu_si128((const __m128i *)&lesX[i + 4]), 16), _mm_loadu_si128((const __m128i *)&lesY[i + 4]));
+		__m128i egal = _mm_or_si128(_mm_cmpeq_epi32(cles0, cle), _mm_cmpeq_epi32(cles1, cle));
+		if (_mm_movemask_epi8(egal))
+		{
+			return true;
+		}
+	}
+	// fin du corps qui ne remplit pas un registre complet
+	return collisionCorpsScalaire(lesX + i, lesY + i, taille - i, x, y);
+}
+
+/**
+ * @brief Version SSE2 de collisionCandidatsScalaire : 4 anneaux par chargement, comparés aux 4 candidats.
+ */
+__attribute__((target("sse2"))) int collisionCandidatsSSE2(const int lesX[], const int lesY[], int taille, const int candidatsX[4], const int candidatsY[4])
+{
+	__m128i cle0 = _mm_set1_epi32(CLE_CASE(candidatsX[0], candidatsY[0]));
+	__m128i cle1 = _mm_set1_epi32(CLE_CASE(candidatsX[1], candidatsY[1]));
+	__m128i cle2 = _mm_set1_epi32(CLE_CASE(candidatsX[2], candidatsY[2]));
+	__m128i cle3 = _mm_set1_epi32(CLE_CASE(candidatsX[3], candidatsY[3]));
+	__m128i egal0 = _mm_setzero_si128();
+	__m128i egal1 = _mm_setzero_si128();
+	__m128i egal2 = _mm_setzero_si128();
+	__m128i egal3 = _mm_setzero_si128();
+	int i = 0;
+	for (; i + 4 <= taille; i += 4)
+	{
+		__m128i cles = _mm_or_si128(_mm_slli_epi32(_mm_loadu_si128((const __m128i *)&lesX[i]), 16), _mm_loadu_si128((const __m128i *)&lesY[i]));
+		egal0 = _mm_or_si128(egal0, _mm_cmpeq_epi32(cles, cle0));
+		egal1 = _mm_or_si128(egal1, _mm_cmpeq_epi32(cles, cle1));
+		egal2 = _mm_or_si128(egal2, _mm_cmpeq_epi32(cles, cle2));
+		egal3 = _mm_or_si128(egal3, _mm_cmpeq_epi32(cles, cle3));
+	}
+	int masque = (_mm_movemask_epi8(egal0) != 0) | (_mm_movemask_epi8(egal1) != 0) << 1 |
+				 (_mm_movemask_epi8(egal2) != 0) << 2 | (_mm_movemask_epi8(egal3) != 0) << 3;
+	return masque | collisionCandidatsScalaire(lesX + i, lesY + i, taille - i, candidatsX, candidatsY);
+}
+
+/**
+ * @brief Version AVX2 de collisionCorpsScalaire : 16 anneaux testés avant chaque branchement.
+ */
+__attribute__((target("avx2"))) bool collisionCorpsAVX2(const int lesX[], const int lesY[], int taille, int x, int y)
+{
+	__m256i cle = _mm256_set1_epi32(CLE_CASE(x, y));
+	int i = 0;
+	for (; i + 16 <= taille; i += 16)
+	{
+		__m256i cles0 = _mm256_or_si256(_mm256_slli_epi32(_mm256_loadu_si256((const __m256i *)&lesX[i]), 16), _mm256_loadu_si256((const __m256i *)&lesY[i]));
+		__m256i cles1 = _mm256_or_si256(_mm256_slli_epi32(_mm256_loadu_si256((const __m256i *)&lesX[i + 8]), 16), _mm256_loadu_si256((const __m256i *)&lesY[i + 8]));
+		__m256i egal = _mm256_or_si256(_mm256_cmpeq_epi32(cles0, cle), _mm256_cmpeq_epi32(cles1, cle));
+		if (!_mm256_testz_si256(egal, egal))
+		{
+			return true;
+		}
+	}
+	// fin du corps qui ne remplit pas deux registres complets
+	return collisionCorpsSSE2(lesX + i, lesY + i, taille - i, x, y);
+}
+
+/**
+ * @brief Version AVX2 de collisionCandidatsScalaire : 8 anneaux par chargement, comparés aux 4 candidats.
+ */
+__attribute__((target("avx2"))) int collisionCandidatsAVX2(const int lesX[], const int lesY[], int taille, const int candidatsX[4], const int candidatsY[4])
+{
+	__m256i cle0 = _mm256_set1_epi32(CLE_CASE(candidatsX[0], candidatsY[0]));
+	__m256i cle1 = _mm256_set1_epi32(CLE_CASE(candidatsX[1], candidatsY[1]));
+	__m256i cle2 = _mm256_set1_epi32(CLE_CASE(candidatsX[2], candidatsY[2]));
+	__m256i cle3 = _mm256_set1_epi32(CLE_CASE(candidatsX[3], candidatsY[3]));
+	__m256i egal0 = _mm256_setzero_si256();
+	__m256i egal1 = _mm256_setzero_si256();
+	__m256i egal2 = _mm256_setzero_si256();
+	__m256i egal3 = _mm256_setzero_si256();
+	int i = 0;
+	for (; i + 8 <= taille; i += 8)
+	{
+		__m256i cles = _mm256_or_si256(_mm256_slli_epi32(_mm256_loadu_si256((const __m256i *)&lesX[i]), 16), _mm256_loadu_si256((const __m256i *)&lesY[i]));
+		egal0 = _mm256_or_si256(egal0, _mm256_cmpeq_epi32(cles, cle0));
+		egal1 = _mm256_or_si256(egal1, _mm256_cmpeq_epi32(cles, cle1));
+		egal2 = _mm256_or_si256(egal2, _mm256_cmpeq_epi32(cles, cle2));
+		egal3 = _mm256_or_si256(egal3, _mm256_cmpeq_epi32(cles, cle3));
+	}
+	int masque = (!_mm256_testz_si256(egal0, egal0)) | (!_mm256_testz_si256(egal1, egal1)) << 1 |
+				 (!_mm256_testz_si256(egal2, egal2)) << 2 | (!_mm256_testz_si256(egal3, egal3)) << 3;
+	return masque | collisionCandidatsSSE2(lesX + i, lesY + i, taille - i, candidatsX, candidatsY);
+}
+#endif
+
+/************************************************/
+/*			   PLUSIEURS POMMES 				*/
+/************************************************/
+
+// Avec --pommes N, N pommes sont sur le plateau en même temps. Un seul parcours en
+// largeur depuis la tête du serpent donne la distance de toutes les pommes à la fois :
+// il part des quatre cases voisines de la tête, chacune marquée par sa direction, et
+// chaque case atteinte hérite de la direction de la case qui l'a atteinte. Un second
+// parcours depuis la tête de l'adversaire donne ses distances ; le serpent vise la plus
+// proche des pommes qu'il atteint avant lui. Le coût d'une décision ne dépend donc pas
+// du nombre de pommes.
+
+/**
+ * @brief Procédure qui recopie le plateau de jeu à plat en bloquant les corps des deux
+ * serpents, têtes comprises.
+ * @param etat de type tEtatJeu, Entrée : la partie
+ * @param cases de type char tableau, Sortie : les NB_CASES cases, BORDURE pour une case bloquée
+ */
+void bloquerCorps(const tEtatJeu *etat, char cases[])
+{
+	memcpy(cases, &etat->plateau[0][0], NB_CASES);
+	for (int s = 0; s < 2; s++)
+	{
+		const tCorps *corps = &etat->serpents[s].corps;
+		const int *lesX = &corps->lesX[corps->tete], *lesY = &corps->lesY[corps->tete];
+		for (int i = 0; i < corps->taille; i++)
+		{
+			cases[cellule_80x40(&GEOMETRIE_PLATEAU, lesX[i], lesY[i])] = BORDURE;
+		}
+	}
+}
+
+/**
+ * @brief Fonction qui parcourt en largeur le plateau depuis les quatre voisines d'une
+ * tête : distance de chaque case et direction du premier pas pour l'atteindre.
+ * @param cases de type char*, Entrée : le plateau à plat, BORDURE pour une case bloquée
+ * @param portails de type tPortails, Entrée : les portails de la partie, ou NULL
+ * @param tete de type int, Entrée : la case de la tête
+ * @param distances de type int tableau, Sortie : la distance de chaque case atteinte
+ * (NB_CASES cases, seules les cases de file sont écrites)
+ * @param premiers de type signed char tableau, Sortie : l'indice de la direction du premier pas
+ * @param file de type int tableau, Sortie : les cases atteintes, par distance croissante
+ * @return le nombre de cases atteintes
+ */
+int parcourirDepuisTete(const char *cases, const tPortails *portails, int tete, int distances[], signed char premiers[], int file[])
+{
+	bool vues[NB_CASES] = {false};
+	bool teleporte;
+	int debut = 0, fin = 0;
+
+	vues[tete] = true;
+	for (int d = 0; d < 4; d++)
+	{
+		int voisine = celluleSuivantePortails(portails, tete, d, &teleporte);
+		if (cases[voisine] != BORDURE && !vues[voisine])
+		{
+			vues[voisine] = true;
+			distances[voisine] = 1;
+			premiers[voisine] = d;
+			file[fin++] = voisine;
+		}
+	}
+	while (debut < fin)
+	{
+		int c = file[debut++];
+		for (int d = 0; d < 4; d++)
+		{
+			int voisine = celluleSuivantePortails(portails, c, d, &teleporte);
+			if (cases[voisine] != BORDURE && !vues[voisine])
+			{
+				vues[voisine] = true;
+				distances[voisine] = distances[c] + 1;
+				premiers[voisine] = premiers[c];
+				file[fin++] = voisine;
+			}
+		}
+	}
+	return fin;
+}
+
+/**
+ * @brief Fonction qui choisit la direction d'un serpent quand plusieurs pommes sont sur le
+ * plateau : le premier pas vers la plus proche des pommes qu'il atteint strictement avant
+ * l'adversaire, ou vers la plus proche de toutes s'il n'y en a aucune.
+ * @param etat de type tEtatJeu, Entrée : la partie
+ * @param numero de type int, Entrée : le numéro du serpent (1 ou 2)
+ * @param direction de type char, Sortie : la direction du serpent, inchangée sans pomme accessible
+ * @return false si aucune pomme n'est accessible : la décision revient alors à l'IA habituelle
+ */
+bool directionPommes(const tEtatJeu *etat, int numero, char *direction)
+{
+	char cases[NB_CASES];
+	int distances[NB_CASES], distancesAutre[NB_CASES];
+	signed char premiers[NB_CASES], premiersAutre[NB_CASES];
+	int file[NB_CASES], fileAutre[NB_CASES];
+	bool atteintesAutre[NB_CASES] = {false};
+	const tCorps *corps = &etat->serpents[numero - 1].corps;
+	const tCorps *corpsAutre = &etat->serpents[2 - numero].corps;
+
+	bloquerCorps(etat, cases);
+	int tete = cellule_80x40(&GEOMETRIE_PLATEAU, corps->lesX[corps->tete], corps->lesY[corps->tete]);
+	int teteAutre = cellule_80x40(&GEOMETRIE_PLATEAU, corpsAutre->lesX[corpsAutre->tete], corpsAutre->lesY[corpsAutre->tete]);
+	const tPortails *portails = portailsPartie(etat);
+	int nbAtteintes = parcourirDepuisTete(cases, portails, tete, distances, premiers, file);
+	int nbAtteintesAutre = parcourirDepuisTete(cases, portails, teteAutre, distancesAutre, premiersAutre, fileAutre);
+	for (int i = 0; i < nbAtteintesAutre; i++)
+	{
+		atteintesAutre[fileAutre[i]] = true;
+	}
+
+	// la file est rangée par distance croissante : la première pomme trouvée est la plus proche
+	int plusProche = -1;
+	for (int i = 0; i < nbAtteintes; i++)
+	{
+		int c = file[i];
+		if (cases[c] != POMME)
+		{
+			continue;
+		}
+		if (!atteintesAutre[c] || distances[c] < distancesAutre[c])
+		{
+			*direction = LES_DIRECTIONS[premiers[c]];
+			return true;
+		}
+		if (plusProche < 0)
+		{
+			plusProche = c;
+		}
+	}
+	if (plusProche < 0)
+	{
+		return false;
+	}
+	*direction = LES_DIRECTIONS[premiers[plusProche]];
+	return true;
+}
+
+/************************************************/
+/*			 TERRITOIRES DE VORONOI 			*/
+/************************************************/
+
+// Avec --voronoi, chaque serpent essaie ses coups en partageant le plateau entre les cases
+// qu'il atteint avant l'adversaire et celles que l'adversaire atteint avant lui
+// (territoires de Voronoi ; les cases atteintes en même temps ne sont à personne). Les
+// deux parcours avancent ensemble sur le plateau en bits, une couche de distance à la fois.
+// Le serpent prend la pomme s'il peut l'atteindre le premier, et sinon le coup qui lui
+// laisse le plus grand territoire plutôt que de perdre la course.
+
+/**
+ * @brief Procédure qui partage le plateau entre deux têtes par un parcours en largeur
+ * simultané, et mesure leur distance à une case visée.
+ * @param libres de type tBitboard, Entrée : les cases libres (rangerBitboard)
+ * @param portails de type tPortails, Entrée : les portails de la partie, ou NULL
+ * @param sources de type int tableau, Entrée : les cases de départ des deux parcours
+ * (elles peuvent être bloquées, comme la tête d'un serpent)
+ * @param visee de type int, Entrée : la case visée, la pomme
+ * @param voronoi de type tVoronoi, Sortie : les territoires et les distances à la case visée
+ */
+void partagerTerritoires(const tBitboard *libres, const tPortails *portails, const int sources[2], int visee, tVoronoi *voronoi)
+{
+	tBitboard restantes = *libres;
+	tBitboard frontieres[2] = {{{0}}, {{0}}};
+	tBitboard suivantes[2];
+	tBitboard territoires[2] = {{{0}}, {{0}}};
+
+	for (int s = 0; s < 2; s++)
+	{
+		poserBit(&frontieres[s], sources[s]);
+		restantes.colonnes[sources[s] / (HAUTEUR_PLATEAU + 1)] &= ~frontieres[s].colonnes[sources[s] / (HAUTEUR_PLATEAU + 1)];
+		voronoi->distances[s] = (sources[s] == visee) ? 0 : -1;
+	}
+
+	bool avance = true;
+	for (int distance = 1; avance; distance++)
+	{
+		avance = false;
+		for (int s = 0; s < 2; s++)
+		{
+			etendreBitboard(&frontieres[s], &restantes, &suivantes[s]);
+			if (portails != NULL)
+			{
+				passerPortailsBitboard(portails, &frontieres[s], &restantes, &suivantes[s]);
+			}
+		}
+		for (int s = 0; s < 2; s++)
+		{
+			if (voronoi->distances[s] < 0 && testerBit(&suivantes[s], visee))
+			{
+				voronoi->distances[s] = distance;
+			}
+		}
+		for (int x = 1; x <= LARGEUR_PLATEAU; x++)
+		{
+			// une case atteinte par les deux en même temps n'est à personne et n'avance plus
+			uint64_t communes = suivantes[0].colonnes[x] & suivantes[1].colonnes[x];
+			restantes.colonnes[x] &= ~(suivantes[0].colonnes[x] | suivantes[1].colonnes[x]);
+			for (int s = 0; s < 2; s++)
+			{
+				frontieres[s].colonnes[x] = suivantes[s].colonnes[x] & ~communes;
+				territoires[s].colonnes[x] |= frontieres[s].colonnes[x];
+				avance |= frontieres[s].colonnes[x] != 0;
+			}
+		}
+	}
+	voronoi->territoires[0] = compterBits(&territoires[0]);
+	voronoi->territoires[1] = compterBits(&territoires[1]);
+}
+
+/**
+ * @brief Fonction qui choisit la direction d'un serpent en mode --voronoi : parmi les coups
+ * qui lui font atteindre la pomme avant l'adversaire, le plus court (puis le plus grand
+ * territoire) ; s'il n'y en a aucun, celui qui lui laisse le plus grand territoire. Un coup
+ * vers une case que la tête adverse peut prendre au même tour ne passe qu'en dernier.
+ * @param etat de type tEtatJeu, Entrée : la partie
+ * @param numero de type int, Entrée : le numéro du serpent (1 ou 2)
+ * @param direction de type char, Sortie : la direction du serpent, inchangée si tout coup est bloqué
+ * @return false si tous les coups sont bloqués : la décision revient alors à l'IA habituelle
+ */
+bool directionVoronoi(const tEtatJeu *etat, int numero, char *direction)
+{
+	char cases[NB_CASES];
+	tBitboard libres;
+	const tCorps *corps = &etat->serpents[numero - 1].corps;
+	const tCorps *corpsAutre = &etat->serpents[2 - numero].corps;
+	const tPortails *portails = portailsPartie(etat);
+	bool teleporte;
+
+	bloquerCorps(etat, cases);
+	rangerBitboard(cases, &libres);
+	int tete = cellule_80x40(&GEOMETRIE_PLATEAU, corps->lesX[corps->tete], corps->lesY[corps->tete]);
+	int sources[2] = {-1, cellule_80x40(&GEOMETRIE_PLATEAU, corpsAutre->lesX[corpsAutre->tete], corpsAutre->lesY[corpsAutre->tete])};
+	int pomme = cellule_80x40(&GEOMETRIE_PLATEAU, etat->pommeX, etat->pommeY);
+
+	// cases où la tête adverse peut arriver à ce tour
+	int disputees[4];
+	for (int d = 0; d < 4; d++)
+	{
+		disputees[d] = celluleSuivantePortails(portails, sources[1], d, &teleporte);
+	}
+
+	int meilleure = -1;
+	bool meilleureGagnee = false, meilleureDisputee = false;
+	tVoronoi voronoi, meilleurVoronoi = {{0}, {0}};
+	for (int d = 0; d < 4; d++)
+	{
+		sources[0] = celluleSuivantePortails(portails, tete, d, &teleporte);
+		if (cases[sources[0]] == BORDURE)
+		{
+			continue;
+		}
+		partagerTerritoires(&libres, portails, sources, pomme, &voronoi);
+		// à égalité, l'adversaire joue avant le prochain coup du serpent : la course est perdue
+		bool gagnee = voronoi.distances[0] >= 0 && (voronoi.distances[1] < 0 || voronoi.distances[0] < voronoi.distances[1]);
+		bool disputee = false;
+		for (int e = 0; e < 4; e++)
+		{
+			disputee |= disputees[e] == sources[0];
+		}
+		bool mieux;
+		if (meilleure >= 0 && disputee != meilleureDisputee)
+		{
+			mieux = !disputee;
+		}
+		else if (meilleure < 0 || gagnee != meilleureGagnee)
+		{
+			mieux = meilleure < 0 || gagnee;
+		}
+		else if (gagnee && voronoi.distances[0] != meilleurVoronoi.distances[0])
+		{
+			mieux = voronoi.distances[0] < meilleurVoronoi.distances[0];
+		}
+		else
+		{
+			mieux = voronoi.territoires[0] > meilleurVoronoi.territoires[0];
+		}
+		if (mieux)
+		{
+			meilleure = d;
+			meilleureGagnee = gagnee;
+			meilleureDisputee = disputee;
+			meilleurVoronoi = voronoi;
+		}
+	}
+	if (meilleure < 0)
+	{
+		return false;
+	}
+	*direction = LES_DIRECTIONS[meilleure];
+	return true;
+}
+
+/************************************************/
+/*				 OBSERVATIONS 					*/
+/************************************************/
+
+// Une observation (voir observation.h) est écrite directement dans le tampon de
+// l'appelant, sans allocation ni appel par case : les colonnes du plateau ont déjà la
+// disposition des canaux, donc murs et pommes se remplissent en un passage que le
+// compilateur vectorise, les trous ne sont que le tour du plateau, et les corps ne
+// coûtent qu'une écriture par anneau. DEFINIR_OBSERVATION génère la version en réels,
+// pour un contrôleur dans le même processus, et celle en octets, quatre fois plus
+// petite, pour les jeux de données.
+_Static_assert(OBSERVATION_LARGEUR == LARGEUR_PLATEAU && OBSERVATION_HAUTEUR == HAUTEUR_PLATEAU, "observation : dimensions du plateau");
+
+// âge de l'anneau i d'un serpent de taille anneaux : le maximum pour la tête, et la queue
+// reste au-dessus de 0
+#define AGE_REEL(i, taille) (1.0f - (float)(i) / (float)(taille))
+#define AGE_OCTET(i, taille) ((uint8_t)(255 - 254 * (i) / (taille)))
+
+// indice d'une case (x, y) dans un canal
+#define CASE_OBSERVATION(x, y) (((x) - 1) * OBSERVATION_HAUTEUR + (y) - 1)
+
+#define DEFINIR_OBSERVATION(SUFFIXE, TYPE, PLEIN, AGE)                                            \
+                                                                                                  \
+	/* observation de la partie par le serpent numero (1 ou 2), OBSERVATION_TAILLE valeurs */     \
+	void observer##SUFFIXE(const tEtatJeu *etat, int numero, TYPE *sortie)                        \
+	{                                                                                             \
+		TYPE *murs = sortie + CANAL_MURS * OBSERVATION_CASES;                                     \
+		TYPE *corps = sortie + CANAL_CORPS * OBSERVATION_CASES;                                   \
+		TYPE *autre = sortie + CANAL_AUTRE * OBSERVATION_CASES;                                   \
+		TYPE *pommes = sortie + CANAL_POMMES * OBSERVATION_CASES;                                 \
+		TYPE *trous = sortie + CANAL_TROUS * OBSERVATION_CASES;                                   \
+		for (int x = 1; x <= LARGEUR_PLATEAU; x++)                                                \
+		{                                                                                         \
+			const char *colonne = &etat->plateau[x][1];                                           \
+			TYPE *colonneMurs = &murs[CASE_OBSERVATION(x, 1)];                                    \
+			TYPE *colonnePommes = &pommes[CASE_OBSERVATION(x, 1)];                                \
+			for (int y = 0; y < HAUTEUR_PLATEAU; y++)                                             \
+			{                                                                                     \
+				colonneMurs[y] = (TYPE)(colonne[y] == BORDURE) * (PLEIN);                         \
+				colonnePommes[y] = (TYPE)(colonne[y] == POMME) * (PLEIN);                         \
+			}                                                                                     \
+		}                                                                                         \
+		/* un trou est une case libre du tour du plateau */                                       \
+		memset(trous, 0, OBSERVATION_CASES * sizeof(TYPE));                                       \
+		for (int x = 1; x <= LARGEUR_PLATEAU; x++)                                                \
+		{                                                                                         \
+			trous[CASE_OBSERVATION(x, 1)] = (TYPE)(etat->plateau[x][1] != BORDURE) * (PLEIN);     \
+			trous[CASE_OBSERVATION(x, HAUTEUR_PLATEAU)] = (TYPE)(etat->plateau[x][HAUTEUR_PLATEAU] != BORDURE) * (PLEIN); \
+		}                                                                                         \
+		for (int y = 2; y < HAUTEUR_PLATEAU; y++)                                                 \
+		{                                                                                         \
+			trous[CASE_OBSERVATION(1, y)] = (TYPE)(etat->plateau[1][y] != BORDURE) * (PLEIN);     \
+			trous[CASE_OBSERVATION(LARGEUR_PLATEAU, y)] = (TYPE)(etat->plateau[LARGEUR_PLATEAU][y] != BORDURE) * (PLEIN); \
+		}                                                                                         \
+		/* les bouts des portails de la carte mènent aussi ailleurs */                            \
+		for (int b = 0; b < 2 * etat->contexte->portails.nbPaires; b++)                           \
+		{                                                                                         \
+			int c = etat->contexte->portails.bouts[b];                                            \
+			trous[CASE_OBSERVATION(c / (HAUTEUR_PLATEAU + 1), c % (HAUTEUR_PLATEAU + 1))] = (PLEIN); \
+		}                                                                                         \
+		/* corps de la queue vers la tête : une tête entrée dans son corps reste visible */       \
+		memset(corps, 0, OBSERVATION_CASES * sizeof(TYPE));                                       \
+		memset(autre, 0, OBSERVATION_CASES * sizeof(TYPE));                                       \
+		const tCorps *soi = &etat->serpents[numero - 1].corps;                                    \
+		const int *soiX = &soi->lesX[soi->tete], *soiY = &soi->lesY[soi->tete];                   \
+		for (int i = soi->taille - 1; i >= 0; i--)                                                \
+		{                                                                                         \
+			corps[CASE_OBSERVATION(soiX[i], soiY[i])] = AGE(i, soi->taille);                      \
+		}                                                                                         \
+		const tCorps *lui = &etat->serpents[2 - numero].corps;                                    \
+		const int *luiX = &lui->lesX[lui->tete], *luiY = &lui->lesY[lui->tete];                   \
+		for (int i = 0; i < lui->taille; i++)                                                     \
+		{                                                                                         \
+			autre[CASE_OBSERVATION(luiX[i], luiY[i])] = (PLEIN);                                  \
+		}                                                                                         \
+	}                                                                                             \
+                                                                                                  \
+	/* observations d'un lot de parties, serpent 1 puis serpent 2 de chaque partie : la k-ième */ \
+	/* commence à sortie + k * pas (pas >= OBSERVATION_TAILLE, pour écrire dans des exemples) */  \
+	void observerLot##SUFFIXE(const tEtatJeu *const parties[], int nbParties, TYPE *sortie, size_t pas) \
+	{                                                                                             \
+		for (int p = 0; p < nbParties; p++)                                                       \
+		{                                                                                         \
+			observer##SUFFIXE(parties[p], 1, sortie + (size_t)(2 * p) * pas);                     \
+			observer##SUFFIXE(parties[p], 2, sortie + (size_t)(2 * p + 1) * pas);                 \
+		}                                                                                         \
+	}
+
+// observations en réels, entre 0 et 1
+DEFINIR_OBSERVATION(Reels, float, 1.0f, AGE_REEL)
+// observations en octets, entre 0 et 255
+DEFINIR_OBSERVATION(Octets, uint8_t, 255, AGE_OCTET)
+
+/**
+ * @brief Fonction qui joue des parties sans affichage et écrit un jeu de données : pour
+ * chaque serpent et chaque tour, son observation avant le tour, le coup qu'il a joué et les
+ * événements du tour (voir observation.h). Toutes les parties avancent ensemble d'un tour :
+ * les observations du tour sont écrites d'un bloc dans un seul tampon d'exemples, envoyé au
+ * fichier en une écriture. Les serpents jouent en même temps, comme en mode hôte.
+ * @param contexte de type tContexte, Entrée : la carte et les portails des parties
+ * @param chemin de type char tableau, Entrée : le fichier du jeu de données
+ * @param nbParties de type int, Entrée : le nombre de parties
+ * @param graine de type uint64_t, Entrée : la graine de la première partie, les suivantes
+ * prennent graine + 1, graine + 2, ...
+ * @param pommesProcedurales de type bool, Entrée : pommes tirées parmi les cases libres
+ * @param croissance de type bool, Entrée : serpents qui grandissent
+ * @param nbPommes de type int, Entrée : pommes présentes en même temps sur le plateau
+ * @param strategies de type int tableau, Entrée : la stratégie de chaque serpent
+ * @return EXIT_SUCCESS, ou EXIT_FAILURE si le fichier n'a pas pu être écrit
+ */
+int lancerJeuDeDonnees(const tContexte *contexte, const char *chemin, int nbParties, uint64_t graine, bool pommesProcedurales, bool croissance, int nbPommes, const int strategies[2])
+{
+	tEtatJeu *parties = malloc(nbParties * sizeof(tEtatJeu));
+	tEtatJeu **enCours = malloc(nbParties * sizeof(tEtatJeu *));
+	tExemple *exemples = malloc(2 * (size_t)nbParties * sizeof(tExemple));
+	FILE *fichier = fopen(chemin, "wb");
+	if (parties == NULL || enCours == NULL || exemples == NULL || fichier == NULL)
+	{
+		if (fichier == NULL)
+		{
+			perror(chemin);
+		}
+		else
+		{
+			fprintf(stderr, "Mémoire insuffisante pour %d parties\n", nbParties);
+			fclose(fichier);
+		}
+		free(parties);
+		free(enCours);
+		free(exemples);
+		return EXIT_FAILURE;
+	}
+	for (int p = 0; p < nbParties; p++)
+	{
+		initEtatJeu(&parties[p], contexte, graine + p, pommesProcedurales, croissance, nbPommes);
+		parties[p].serpents[0].strategie = strategies[0];
+		parties[p].serpents[1].strategie = strategies[1];
+		enCours[p] = &parties[p];
 	}
-	else if (lesPavesX[meilleureDistancePave]+2 < lesX[0] && lesPavesY[meilleureDistancePave]+2 < lesY[0] && lesPavesY[meilleureDistancePave]+2 > HAUTEUR_PLATEAU/2){ // Sortie trou bas, pave en bas a gauche du plateau
-		if(lesPommesX[nbPommesMangee] > lesPavesX[meilleureDistancePave] - 1 && lesPommesY[nbPommesMangee] < lesPavesY[meilleureDistancePave] +5){ // si pomme dans la diagonale suprieure droite du pave
-			changement = true;
+	tEnteteDonnees entete = {DONNEES_MAGIQUE, NB_CANAUX, OBSERVATION_LARGEUR, OBSERVATION_HAUTEUR, sizeof(tExemple)};
+	bool ecrit = fwrite(&entete, sizeof(entete), 1, fichier) == 1;
+
+	signal(SIGINT, demanderArret);
+	signal(SIGTERM, demanderArret);
+	long long debut = maintenantNano();
+	long long dureeObservations = 0;
+	long long nbExemples = 0;
+	int nbEnCours = nbParties;
+	const char directionsIA[2] = {0, 0};
+	while (nbEnCours > 0 && ecrit && !arretDemande)
+	{
+		long long debutObservations = maintenantNano();
+		observerLotOctets((const tEtatJeu *const *)enCours, nbEnCours, exemples[0].observation, sizeof(tExemple));
+		dureeObservations += maintenantNano() - debutObservations;
+		for (int p = 0; p < nbEnCours; p++)
+		{
+			tEtatJeu *etat = enCours[p];
+			tAvantTour avant;
+			tDelta delta;
+			noterAvantTour(etat, &avant);
+			jouerTourSimultane(etat, directionsIA);
+			coderDelta(etat, &avant, &delta);
+			for (int s = 0; s < 2; s++)
+			{
+				exemples[2 * p + s].direction = indiceDirection(etat->serpents[s].direction);
+				exemples[2 * p + s].evenements = delta.evenements;
+			}
+		}
+		ecrit = fwrite(exemples, sizeof(tExemple), 2 * nbEnCours, fichier) == (size_t)(2 * nbEnCours);
+		nbExemples += 2 * nbEnCours;
+		// les parties terminées sortent du lot, sans changer l'ordre des autres
+		int restantes = 0;
+		for (int p = 0; p < nbEnCours; p++)
+		{
+			if (!partieFinie(enCours[p]))
+			{
+				enCours[restantes++] = enCours[p];
+			}
 		}
+		nbEnCours = restantes;
 	}
+	ecrit = (fclose(fichier) == 0) && ecrit;
+	double duree = (maintenantNano() - debut) / 1e9;
 
-	return changement;
+	if (!ecrit)
+	{
+		perror(chemin);
+	}
+	printf("%d parties, %lld exemples (%.1f Mo) écrits dans %s en %.2f s\n", nbParties, nbExemples,
+		   nbExemples * (double)sizeof(tExemple) / 1e6, chemin, duree);
+	printf("Observations : %.0f par seconde, %.2f Go/s\n", nbExemples / (dureeObservations / 1e9),
+		   nbExemples * (double)OBSERVATION_TAILLE / dureeObservations);
+	free(parties);
+	free(enCours);
+	free(exemples);
+	return ecrit ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
+/************************************************/
+/*					STRATEGIES 					*/
+/************************************************/
 
 /**
- * @brief Fonction qui regarde si un pavé arrive devant le serpent
- * @param lesX de type int tableau, Entrée : le tableau des X de N élément
- * @param lesY de type int tableau, Entrée : le tableau des Y de N élément
+ * @brief Fonction qui ajoute une stratégie aux stratégies connues : elle peut ensuite être
+ * choisie par son nom (--strategies, tournoi) comme les stratégies intégrées. C'est là,
+ * au moment de la configuration, que se fait le seul choix dynamique ; pendant les parties
+ * son pointeur est appelé par deciderSerpent. Le contexte ne doit être désigné par aucune
+ * partie en cours.
+ * @param contexte de type tContexte, Entrée/Sortie : le contexte qui connaîtra la stratégie
+ * @param nom de type char tableau, Entrée : le nom de la stratégie, qui doit rester valide
+ * @param decider de type tDecider, Entrée : la fonction de décision
+ * @return le numéro de la stratégie, ou -1 si le nom est déjà pris ou s'il n'y a plus de place
  */
-bool changementDirectionCasIsole(int lesX_S2[], int lesY_S2[], int lesX_S1[], int lesY_S1[]){ // Utile dans un seul cas, si la coordonne du pave se trouve en lesX[0] - 1
-	bool changement = false;
-	int nouvelleX = lesX_S2[0]; // projeter des coordonnées en X
-	int nouvelleY = lesY_S2[0]; // projeter des coordonnées en Y
+int enregistrerStrategie(tContexte *contexte, const char *nom, tDecider decider)
+{
+	if (decider == NULL || contexte->nbStrategies == MAX_STRATEGIES || trouverStrategie(contexte, nom) >= 0)
+	{
+		return -1;
+	}
+	contexte->strategies[contexte->nbStrategies].nom = nom;
+	contexte->strategies[contexte->nbStrategies].decider = decider;
+	return contexte->nbStrategies++;
+}
 
-	for (int i = 0; i < TAILLE; i++)
+/**
+ * @brief Fonction qui donne le numéro d'une stratégie d'après son nom.
+ * @param contexte de type tContexte, Entrée : le contexte et ses stratégies connues
+ * @param nom de type char tableau, Entrée : le nom de la stratégie
+ * @return le numéro de la stratégie, ou -1 si aucune ne porte ce nom
+ */
+int trouverStrategie(const tContexte *contexte, const char *nom)
+{
+	for (int i = 0; i < contexte->nbStrategies; i++)
 	{
-		if ((lesX_S1[i] + 2 == nouvelleX && lesY_S1[i] == nouvelleY) || (lesX_S2[i] == nouvelleX && lesY_S2[i] == nouvelleY))
+		if (strcmp(nom, contexte->strategies[i].nom) == 0)
 		{
-			return true; // Collision avec le corps du serpent
+			return i;
 		}
 	}
-	return changement;
+	return -1;
 }
 
 /**
- * @brief Fonction qui calcule puis renvoie le chemin le plus rapide
- * @param lesX de type int tableau, Entrée : le tableau des X de N élément
- * @param lesY de type int tableau, Entrée : le tableau des Y de N élément
- * @param pommeX de type int, Entrée : les coordonnées des pommes en X
- * @param pommeY de type int, Entrée : les coordonnées des pommes en Y
+ * @brief Fonction qui lit les stratégies des deux serpents : "NOM" pour les deux, ou
+ * "NOM1,NOM2" pour le serpent 1 puis le serpent 2.
+ * @param contexte de type tContexte, Entrée : le contexte et ses stratégies connues
+ * @param liste de type char tableau, Entrée : les noms
+ * @param strategies de type int tableau, Sortie : la stratégie de chaque serpent
+ * @return false, avec un message, si un nom est inconnu ou s'il y en a plus de deux
  */
-int calculerDistance1(int lesX_S1[], int lesY_S1[], int pommeX, int pommeY)
+bool lireStrategies(const tContexte *contexte, const char *liste, int strategies[2])
 {
-	// définition des variables
-	int passageTrouGauche, passageTrouDroit, passageTrouHaut, passageTrouBas, passageDirectPomme, resultat;
-
-	// calcul la distance pour chaque chemin du serpent vers la pomme
-	passageTrouGauche = abs(lesX_S1[0] - TROU_GAUCHE_X) + abs(lesY_S1[0] - TROU_GAUCHE_Y) + abs(pommeX - TROU_DROITE_X) + abs(pommeY - TROU_DROITE_Y);
-	passageTrouDroit = abs(lesX_S1[0] - TROU_DROITE_X) + abs(lesY_S1[0] - TROU_DROITE_Y) + abs(pommeX - TROU_GAUCHE_X) + abs(pommeY - TROU_GAUCHE_Y);
-	passageTrouHaut = abs(lesX_S1[0] - TROU_HAUT_X) + abs(lesY_S1[0] - TROU_HAUT_Y) + abs(pommeX - TROU_BAS_X) + abs(pommeY - TROU_BAS_Y);
-	passageTrouBas = abs(lesX_S1[0] - TROU_BAS_X) + abs(lesY_S1[0] - TROU_BAS_Y) + abs(pommeX - TROU_HAUT_X) + abs(pommeY - TROU_HAUT_Y);
-	passageDirectPomme = abs(lesX_S1[0] - pommeX) + abs(lesY_S1[0] - pommeY);
-
-	// compare les résultats pour obtenir le meilleur chemin
-	if (passageDirectPomme <= passageTrouHaut && passageDirectPomme <= passageTrouBas &&
-		passageDirectPomme <= passageTrouGauche && passageDirectPomme <= passageTrouDroit) // chemin direct vers la pomme sans passer dans un trou
+	char noms[256];
+	int nbNoms = 0;
+	snprintf(noms, sizeof(noms), "%s", liste);
+	for (char *nom = strtok(noms, ","); nom != NULL; nom = strtok(NULL, ","))
 	{
-		resultat = CHEMIN_POMME;
+		int strategie = trouverStrategie(contexte, nom);
+		if (strategie < 0 || nbNoms == 2)
+		{
+			fprintf(stderr, (strategie < 0) ? "Stratégie inconnue : %s\n" : "Une partie n'a que deux serpents : %s\n", nom);
+			return false;
+		}
+		strategies[nbNoms++] = strategie;
 	}
-	else if (passageTrouHaut <= passageTrouBas && passageTrouHaut <= passageTrouGauche && passageTrouHaut <= passageTrouDroit) // chemin vers la pomme en passant par le trou du haut
+	if (nbNoms == 1)
 	{
-		resultat = CHEMIN_HAUT;
+		strategies[1] = strategies[0];
 	}
-	else if (passageTrouBas <= passageTrouGauche && passageTrouBas <= passageTrouDroit) // chemin vers la pomme en passant par le trou du bas
+	return nbNoms > 0;
+}
+
+/**
+ * @brief Fonction de décision de la stratégie "prudent", enregistrée par main comme
+ * exemple de stratégie extérieure : parmi les coups qui laissent au moins autant de
+ * cases accessibles que le serpent a d'anneaux, elle prend le plus proche de la pomme,
+ * et à défaut celui qui laisse le plus de place.
+ * @param etat de type tEtatJeu, Entrée : la partie
+ * @param numero de type int, Entrée : le numéro du serpent (1 ou 2)
+ * @param direction de type char, Sortie : la direction choisie
+ * @return false si tous les coups sont bloqués (l'IA habituelle joue alors)
+ */
+bool directionPrudente(tEtatJeu *etat, int numero, char *direction)
+{
+	tDecideur decideur = {numero, etat, NULL, NULL, NULL};
+	tCorps *corps = &etat->serpents[numero - 1].corps;
+	int meilleure = -1, meilleurEspace = 0, meilleureDistance = 0;
+
+	for (int i = 0; i < 4; i++)
 	{
-		resultat = CHEMIN_BAS;
+		int espace = compterEspaceLibre(&decideur, i, NULL, 0, 0);
+		int x, y;
+		projeterCasePortails(portailsPartie(etat), anneauxX(corps)[0], anneauxY(corps)[0], i, &x, &y);
+		int distance = abs(x - etat->pommeX) + abs(y - etat->pommeY);
+		bool sur = espace >= corps->taille, meilleureSure = meilleurEspace >= corps->taille;
+		if (espace > 0 && (meilleure < 0 || (sur && (!meilleureSure || distance < meilleureDistance))
+						   || (!sur && !meilleureSure && espace > meilleurEspace)))
+		{
+			meilleure = i;
+			meilleurEspace = espace;
+			meilleureDistance = distance;
+		}
 	}
-	else if (passageTrouGauche <= passageTrouDroit) // chemin vers la pomme en passant par le trou de gauche
+	if (meilleure < 0)
 	{
-		resultat = CHEMIN_GAUCHE;
+		return false;
 	}
-	else // chemin vers la pomme en passant par le trou de droite
+	*direction = LES_DIRECTIONS[meilleure];
+	return true;
+}
+
+/**
+ * @brief Fonction qui donne la longueur d'un chemin vers la pomme par un trou : de la tête
+ * jusqu'au trou, puis du trou opposé, où le serpent ressort, jusqu'à la pomme (le premier
+ * trou de chaque côté de la table des portails).
+ * @param portails de type tPortails, Entrée : les portails de la partie et les chemins de l'IA
+ * @param chemin de type int, Entrée : le trou emprunté (CHEMIN_HAUT ... CHEMIN_DROITE)
+ * @param teteX de type int, Entrée : les coordonnées en X de la tête
+ * @param teteY de type int, Entrée : les coordonnées en Y de la tête
+ * @param pommeX de type int, Entrée : les coordonnées en X de la pomme
+ * @param pommeY de type int, Entrée : les coordonnées en Y de la pomme
+ */
+int distanceParTrou(const tPortails *portails, int chemin, int teteX, int teteY, int pommeX, int pommeY)
+{
+	int rang = rangDuChemin(chemin);
+	if (portails->entreesX[rang] < 0)
 	{
-		resultat = CHEMIN_DROITE;
+		return INT32_MAX / 2; // côté sans trou sur cette carte
 	}
-
-	return resultat;
+	return abs(teteX - portails->entreesX[rang]) + abs(teteY - portails->entreesY[rang])
+		 + abs(pommeX - portails->sortiesX[rang]) + abs(pommeY - portails->sortiesY[rang]);
 }
 
 /**
- * @brief Fonction qui calcule puis renvoie le chemin le plus rapide
- * @param lesX de type int tableau, Entrée : le tableau des X de N élément
- * @param lesY de type int tableau, Entrée : le tableau des Y de N élément
- * @param pommeX de type int, Entrée : les coordonnées des pommes en X
- * @param pommeY de type int, Entrée : les coordonnées des pommes en Y
+ * @brief Fonction qui choisit le chemin vers la pomme comme version2Sacha.c : selon le quart
+ * du plateau où est la pomme, le chemin direct est comparé aux deux trous qui mènent de
+ * son côté. Une pomme au centre ou sur un axe du plateau est visée directement.
+ * @param portails de type tPortails, Entrée : les portails de la partie et les chemins de l'IA
+ * @param teteX de type int, Entrée : les coordonnées en X de la tête
+ * @param teteY de type int, Entrée : les coordonnées en Y de la tête
+ * @param pommeX de type int, Entrée : les coordonnées en X de la pomme
+ * @param pommeY de type int, Entrée : les coordonnées en Y de la pomme
+ * @return le chemin (CHEMIN_HAUT ... CHEMIN_POMME)
  */
-int calculerDistance2(int lesX_S2[], int lesY_S2[], int pommeX, int pommeY)
+int cheminVersion2(const tPortails *portails, int teteX, int teteY, int pommeX, int pommeY)
 {
-	// définition des variables
-	int passageTrouGauche, passageTrouDroit, passageTrouHaut, passageTrouBas, passageDirectPomme, resultat;
-
-	// calcul la distance pour chaque chemin du serpent vers la pomme
-	passageTrouGauche = abs(lesX_S2[0] - TROU_GAUCHE_X) + abs(lesY_S2[0] - TROU_GAUCHE_Y) + abs(pommeX - TROU_DROITE_X) + abs(pommeY - TROU_DROITE_Y);
-	passageTrouDroit = abs(lesX_S2[0] - TROU_DROITE_X) + abs(lesY_S2[0] - TROU_DROITE_Y) + abs(pommeX - TROU_GAUCHE_X) + abs(pommeY - TROU_GAUCHE_Y);
-	passageTrouHaut = abs(lesX_S2[0] - TROU_HAUT_X) + abs(lesY_S2[0] - TROU_HAUT_Y) + abs(pommeX - TROU_BAS_X) + abs(pommeY - TROU_BAS_Y);
-	passageTrouBas = abs(lesX_S2[0] - TROU_BAS_X) + abs(lesY_S2[0] - TROU_BAS_Y) + abs(pommeX - TROU_HAUT_X) + abs(pommeY - TROU_HAUT_Y);
-	passageDirectPomme = abs(lesX_S2[0] - pommeX) + abs(lesY_S2[0] - pommeY);
-
-	// compare les résultats pour obtenir le meilleur chemin
-	if (passageDirectPomme <= passageTrouHaut && passageDirectPomme <= passageTrouBas &&
-		passageDirectPomme <= passageTrouGauche && passageDirectPomme <= passageTrouDroit) // chemin direct vers la pomme sans passer dans un trou
+	const int centreX = LARGEUR_PLATEAU / 2, centreY = HAUTEUR_PLATEAU / 2;
+	int premier, second;
+	if (pommeX > centreX && pommeY > centreY) // en bas à droite
 	{
-		resultat = CHEMIN_POMME;
+		premier = CHEMIN_HAUT;
+		second = CHEMIN_GAUCHE;
 	}
-	else if (passageTrouHaut <= passageTrouBas && passageTrouHaut <= passageTrouGauche && passageTrouHaut <= passageTrouDroit) // chemin vers la pomme en passant par le trou du haut
+	else if (pommeX < centreX && pommeY < centreY) // en haut à gauche
 	{
-		resultat = CHEMIN_HAUT;
+		premier = CHEMIN_BAS;
+		second = CHEMIN_DROITE;
 	}
-	else if (passageTrouBas <= passageTrouGauche && passageTrouBas <= passageTrouDroit) // chemin vers la pomme en passant par le trou du bas
+	else if (pommeX > centreX && pommeY < centreY) // en haut à droite
 	{
-		resultat = CHEMIN_BAS;
+		premier = CHEMIN_GAUCHE;
+		second = CHEMIN_BAS;
 	}
-	else if (passageTrouGauche <= passageTrouDroit) // chemin vers la pomme en passant par le trou de gauche
+	else if (pommeX < centreX && pommeY > centreY) // en bas à gauche
 	{
-		resultat = CHEMIN_GAUCHE;
+		premier = CHEMIN_DROITE;
+		second = CHEMIN_HAUT;
 	}
-	else // chemin vers la pomme en passant par le trou de droite
+	else
 	{
-		resultat = CHEMIN_DROITE;
+		return CHEMIN_POMME;
 	}
 
-	return resultat;
+	int direct = abs(teteX - pommeX) + abs(teteY - pommeY);
+	int distancePremier = distanceParTrou(portails, premier, teteX, teteY, pommeX, pommeY);
+	int distanceSecond = distanceParTrou(portails, second, teteX, teteY, pommeX, pommeY);
+	if (direct < distancePremier && direct < distanceSecond)
+	{
+		return CHEMIN_POMME;
+	}
+	return (distancePremier < distanceSecond && distancePremier < direct) ? premier : second;
 }
 
 /**
- * @brief Vérifie si le prochain déplacement du serpent dans la direction spécifiée entraîne une collision.
- * @param pommeX de type int, Entrée : coordonnée de la pomme en X
- * @param pommeY de type int, Entrée : coordonnée de la pomme en Y
+ * @brief Vérifie, comme les versions 2 et 3, si le prochain déplacement du serpent entraîne
+ * une collision avec une bordure, un pavé ou son propre corps ; l'autre serpent est ignoré.
+ * @param etat de type tEtatJeu, Entrée : la partie
+ * @param numero de type int, Entrée : le numéro du serpent (1 ou 2)
+ * @param directionProchaine de type char, Entrée : la direction vers laquelle le serpent va se déplacer
+ * @return true si une collision est détectée, false sinon
  */
-int calculerDistancePommePave(int pommeX, int pommeY)
+bool collisionVersionPrecedente(tEtatJeu *etat, int numero, char directionProchaine)
 {
-	// définition des variables
-	int distancePommePave, meilleureDistancePommePave, iMeilleureDistancePave;
-
-	meilleureDistancePommePave = 0;
-	iMeilleureDistancePave = 0;
+	tCorps *corps = &etat->serpents[numero - 1].corps;
+	int nouvelleX, nouvelleY;
+	projeterCasePortails(portailsPartie(etat), anneauxX(corps)[0], anneauxY(corps)[0], indiceDirection(directionProchaine), &nouvelleX, &nouvelleY);
+	return etat->plateau[nouvelleX][nouvelleY] == BORDURE || collisionCorps(anneauxX(corps), anneauxY(corps), corps->taille, nouvelleX, nouvelleY);
+}
 
-	// calcul la distance pour chaque chemin du serpent vers la pomme
-	for (int i = 0; i<NB_PAVES; i++){
-		distancePommePave = abs(pommeX - (lesPavesX[i] + 2)) + abs(pommeY - (lesPavesY[i] + 2)); //distance par rapport au centre du pavé
-		if (meilleureDistancePommePave == 0){
-			meilleureDistancePommePave = distancePommePave;
-			iMeilleureDistancePave = i;
+/**
+ * @brief Procédure qui dirige le serpent vers l'objectif comme version2Sacha.c : horizontalité
+ * d'abord, verticalité si la case est prise.
+ * @param etat de type tEtatJeu, Entrée : la partie
+ * @param numero de type int, Entrée : le numéro du serpent (1 ou 2)
+ * @param direction de type char, Entrée/Sortie : la direction du serpent
+ * @param objectifX de type int, Entrée : les coordonnées en X de l'objectif
+ * @param objectifY de type int, Entrée : les coordonnées en Y de l'objectif
+ */
+void directionVersion2(tEtatJeu *etat, int numero, char *direction, int objectifX, int objectifY)
+{
+	tCorps *corps = &etat->serpents[numero - 1].corps;
+	int teteX = anneauxX(corps)[0], teteY = anneauxY(corps)[0];
+	if (objectifX != teteX)
+	{
+		*direction = (objectifX < teteX) ? GAUCHE : DROITE;
+		if (collisionVersionPrecedente(etat, numero, *direction))
+		{
+			*direction = (objectifY > teteY) ? BAS : HAUT;
 		}
-		else if(distancePommePave < meilleureDistancePommePave){
-			meilleureDistancePommePave = distancePommePave;
-			iMeilleureDistancePave = i;
+	}
+	else if (objectifY != teteY)
+	{
+		*direction = (objectifY < teteY) ? HAUT : BAS;
+		if (collisionVersionPrecedente(etat, numero, *direction))
+		{
+			*direction = GAUCHE;
+			if (collisionVersionPrecedente(etat, numero, *direction))
+			{
+				*direction = DROITE;
+			}
 		}
 	}
-
-	
-	return iMeilleureDistancePave;
 }
 
 /**
- * @brief Vérifie si le prochain déplacement du serpent dans la direction spécifiée entraîne une collision.
- * @param lesX tableau contenant les positions X du serpent.
- * @param lesY tableau contenant les positions Y du serpent.
- * @param plateau tableau représentant le plateau de jeu.
- * @param directionProchaine direction vers laquelle le serpent va se déplacer.
- * @return true si une collision est détectée, false sinon.
+ * @brief Procédure qui dirige le serpent vers l'objectif comme version3Sacha.c : verticalité
+ * d'abord, ou horizontalité si changement, puis les autres directions dans l'ordre de
+ * cette version si la case est prise.
+ * @param etat de type tEtatJeu, Entrée : la partie
+ * @param numero de type int, Entrée : le numéro du serpent (1 ou 2)
+ * @param direction de type char, Entrée/Sortie : la direction du serpent
+ * @param objectifX de type int, Entrée : les coordonnées en X de l'objectif
+ * @param objectifY de type int, Entrée : les coordonnées en Y de l'objectif
+ * @param changement de type bool, Entrée : true pour prioriser l'horizontalité
  */
-bool verifierCollision1(int lesX_S1[], int lesY_S1[], int lesX_S2[], int lesY_S2[], tPlateau plateau, char directionProchaine)
+void directionVersion3(tEtatJeu *etat, int numero, char *direction, int objectifX, int objectifY, bool changement)
 {
-	int nouvelleX = lesX_S1[0]; // projeter des coordonnées en X
-	int nouvelleY = lesY_S1[0]; // projeter des coordonnées en Y
-
-	// Calcul de la nouvelle position en fonction de la direction donnée
-	switch (directionProchaine)
+	tCorps *corps = &etat->serpents[numero - 1].corps;
+	int dx = objectifX - anneauxX(corps)[0];
+	int dy = objectifY - anneauxY(corps)[0];
+	// chaque direction de l'ordre n'est essayée que si la précédente mène à une collision
+	char ordre[4];
+	if ((!changement && dy != 0) || (changement && dx == 0 && dy != 0))
 	{
-	case HAUT:
-		nouvelleY--;
-		break;
-	case BAS:
-		nouvelleY++;
-		break;
-	case GAUCHE:
-		nouvelleX--;
-		break;
-	case DROITE:
-		nouvelleX++;
-		break;
+		ordre[0] = (dy > 0) ? BAS : HAUT;
+		ordre[1] = (dx > 0) ? (changement ? GAUCHE : DROITE) : (changement ? DROITE : GAUCHE);
+		ordre[2] = changement ? ((dy > 0) ? HAUT : BAS) : ((dx > 0) ? GAUCHE : DROITE);
+		ordre[3] = changement ? ((dx > 0) ? DROITE : GAUCHE) : ((dy > 0) ? HAUT : BAS);
 	}
-
-	// Vérification des collisions avec les bords du tableau
-	if (plateau[nouvelleX][nouvelleY] == BORDURE)
+	else if (dx != 0)
 	{
-		return true; // Collision avec une bordure
+		ordre[0] = (dx > 0) ? DROITE : GAUCHE;
+		ordre[1] = (dy > 0) ? BAS : HAUT;
+		ordre[2] = changement ? ((dx > 0) ? GAUCHE : DROITE) : ((dy > 0) ? HAUT : BAS);
+		ordre[3] = changement ? ((dy > 0) ? HAUT : BAS) : ((dx > 0) ? GAUCHE : DROITE);
 	}
-
-	// Vérification des collisions avec le corps du serpent
-	for (int i = 0; i < TAILLE; i++)
+	else
 	{
-		if ((lesX_S1[i] == nouvelleX && lesY_S1[i] == nouvelleY) || (lesX_S2[i] == nouvelleX && lesY_S2[i] == nouvelleY))
-		{
-			return true; // Collision avec le corps du serpent
-		}
+		return;
 	}
+	int i = 0;
+	while (i < 3 && collisionVersionPrecedente(etat, numero, ordre[i]))
+	{
+		i++;
+	}
+	*direction = ordre[i];
+}
 
-	return false; // Pas de collision
+/**
+ * @brief Fonction qui dit, comme version3Sacha.c, si le serpent doit prioriser
+ * l'horizontalité : sa tête est juste à droite de la colonne d'un pavé.
+ * @param etat de type tEtatJeu, Entrée : la partie (pavés)
+ * @param teteX de type int, Entrée : les coordonnées en X de la tête
+ */
+bool changementPaves(const tEtatJeu *etat, int teteX)
+{
+	bool changement = false;
+	for (int i = 0; i < etat->nbPaves; i++)
+	{
+		changement = changement || (teteX - 1 == etat->lesPavesX[i]);
+	}
+	return changement;
 }
 
 /**
- * @brief Vérifie si le prochain déplacement du serpent dans la direction spécifiée entraîne une collision.
- * @param lesX tableau contenant les positions X du serpent.
- * @param lesY tableau contenant les positions Y du serpent.
- * @param plateau tableau représentant le plateau de jeu.
- * @param directionProchaine direction vers laquelle le serpent va se déplacer.
- * @return true si une collision est détectée, false sinon.
+ * @brief Procédure qui prend la décision d'un serpent des stratégies version2 et version3 :
+ * le chemin est choisi à l'apparition de chaque pomme et le serpent vise le trou de ce
+ * chemin jusqu'à l'avoir traversé, puis la pomme.
+ * @param etat de type tEtatJeu, Entrée : la partie (seule la mémoire du serpent change)
+ * @param numero de type int, Entrée : le numéro du serpent (1 ou 2)
+ * @param direction de type char, Entrée/Sortie : la direction du serpent
  */
-bool verifierCollision2(int lesX_S2[], int lesY_S2[], int lesX_S1[], int lesY_S1[], tPlateau plateau, char directionProchaine)
+void directionVersionPrecedente(tEtatJeu *etat, int numero, char *direction)
 {
-	int nouvelleX = lesX_S2[0]; // projeter des coordonnées en X
-	int nouvelleY = lesY_S2[0]; // projeter des coordonnées en Y
+	tSerpent *serpent = &etat->serpents[numero - 1];
+	tMemoireRoute *memoire = &serpent->memoire;
+	int teteX = anneauxX(&serpent->corps)[0], teteY = anneauxY(&serpent->corps)[0];
+	int objectifX, objectifY;
 
-	// Calcul de la nouvelle position en fonction de la direction donnée
-	switch (directionProchaine)
+	// nouveau chemin pour une nouvelle pomme, trou traversé quand la tête saute
+	if (memoire->pommeX != etat->pommeX || memoire->pommeY != etat->pommeY)
 	{
-	case HAUT:
-		nouvelleY--;
-		break;
-	case BAS:
-		nouvelleY++;
-		break;
-	case GAUCHE:
-		nouvelleX--;
-		break;
-	case DROITE:
-		nouvelleX++;
-		break;
+		memoire->pommeX = etat->pommeX;
+		memoire->pommeY = etat->pommeY;
+		memoire->chemin = (serpent->strategie == STRATEGIE_VERSION2) ? cheminVersion2(&etat->contexte->portails, teteX, teteY, etat->pommeX, etat->pommeY)
+			: calculerDistance1(anneauxX(&serpent->corps), anneauxY(&serpent->corps), etat->pommeX, etat->pommeY, &etat->contexte->portails);
+		memoire->passe = false;
 	}
-
-	// Vérification des collisions avec les bords du tableau
-	if (plateau[nouvelleX][nouvelleY] == BORDURE)
+	else if (abs(teteX - memoire->teteX) + abs(teteY - memoire->teteY) > 1)
 	{
-		return true; // Collision avec une bordure
+		memoire->passe = true;
 	}
-
-	// Vérification des collisions avec le corps du serpent
-	for (int i = 0; i < TAILLE; i++)
+	memoire->teteX = teteX;
+	memoire->teteY = teteY;
+	choisirObjectif(&etat->contexte->portails, memoire->chemin, memoire->passe, etat->pommeX, etat->pommeY, &objectifX, &objectifY);
+	if (serpent->strategie == STRATEGIE_VERSION2)
+	{
+		directionVersion2(etat, numero, direction, objectifX, objectifY);
+	}
+	else
 	{
-		if ((lesX_S2[i] == nouvelleX && lesY_S2[i] == nouvelleY) || (lesX_S1[i] == nouvelleX && lesY_S1[i] == nouvelleY))
+		if (memoire->chemin == CHEMIN_POMME || memoire->passe)
 		{
-			return true; // Collision avec le corps du serpent
+			memoire->changement = changementPaves(etat, teteX);
 		}
+		directionVersion3(etat, numero, direction, objectifX, objectifY, memoire->changement);
 	}
-
-	return false; // Pas de collision
 }
 
+/************************************************/
+/*			 FLUX DES SPECTATEURS 				*/
+/************************************************/
+
 /**
- * @brief Procédure qui calcule la prochaine position du serpent et qui l'affiche,
- * elle permet aussi de savoir si le serpent entre en collision avec une bordure, un pavé, ou une pomme.
- * @param lesX de type int tableau, Entrée : le tableau des X de N élément
- * @param lesY de type int tableau, Entrée : le tableau des Y de N élément
- * @param plateau de type tPlateau, qui donne en Entrée le plateau du jeu
- * @param direction de type char, Entrée : la direction du serpent attribuée aux touches 'z' 'q' 's' 'd'
- * @param collision de type bool, vérifie si il y a une collision
- * @param pomme de type bool, vérifie si une pomme est mangée
- * @param teleporter de type bool, vérifie si le serpent s'est téléporter
+ * @brief Procédure qui relève avant un tour ce qu'il faut pour en coder le delta.
+ * @param etat de type tEtatJeu, Entrée : la partie
+ * @param avant de type tAvantTour, Sortie : le repère du tour
  */
-void progresser1(int lesX[], int lesY[], char direction, tPlateau plateau, bool *collision, bool *pomme, bool *teleporter, bool *sortieDuTrou)
+void noterAvantTour(tEtatJeu *etat, tAvantTour *avant)
 {
-	// efface le dernier élément avant d'actualiser la position de tous les
-	// élémentds du serpent avant de le  redessiner et détecte une
-	// collision avec une pomme ou avec une bordure
-	effacer(lesX[TAILLE - 1], lesY[TAILLE - 1]);
-
-	for (int i = TAILLE - 1; i > 0; i--)
+	avant->finie = partieFinie(etat);
+	for (int s = 0; s < 2; s++)
 	{
-		lesX[i] = lesX[i - 1];
-		lesY[i] = lesY[i - 1];
-	}
-	// faire progresser la tete dans la nouvelle direction
-	switch (direction)
-	{
-	case HAUT:
-		lesY[0] = lesY[0] - 1;
-		break;
-	case BAS:
-		lesY[0] = lesY[0] + 1;
-		break;
-	case DROITE:
-		lesX[0] = lesX[0] + 1;
-		break;
-	case GAUCHE:
-		lesX[0] = lesX[0] - 1;
-		break;
+		tCorps *corps = &etat->serpents[s].corps;
+		avant->queueX[s] = anneauxX(corps)[corps->taille - 1];
+		avant->queueY[s] = anneauxY(corps)[corps->taille - 1];
+		avant->taille[s] = corps->taille;
+		avant->nbPommes[s] = etat->serpents[s].nbPommesMangees;
 	}
+}
 
-	// Faire des trous dans les bordures
-	for (int i = 1; i < TAILLE; i++)
+/**
+ * @brief Procédure qui code ce qui a changé pendant un tour : nouvelles têtes, cases
+ * quittées par les queues, nouvelle pomme et événements.
+ * @param etat de type tEtatJeu, Entrée : la partie après le tour
+ * @param avant de type tAvantTour, Entrée : le repère pris avant le tour
+ * @param delta de type tDelta, Sortie : le delta du tour
+ */
+void coderDelta(tEtatJeu *etat, const tAvantTour *avant, tDelta *delta)
+{
+	memset(delta, 0, sizeof(*delta));
+	for (int s = 0; s < 2; s++)
 	{
-		if (lesX[0] <= 0)
+		tSerpent *serpent = &etat->serpents[s];
+		delta->teteX[s] = anneauxX(&serpent->corps)[0];
+		delta->teteY[s] = anneauxY(&serpent->corps)[0];
+		if (avant->finie)
 		{
-			lesX[0] = LARGEUR_PLATEAU; // faire apparaitre à gauche
-			*teleporter = true;		   // quand le serpent traverse le trou
-			*sortieDuTrou = true;
+			continue;
 		}
-		else if (lesX[0] > LARGEUR_PLATEAU)
+		// la queue n'a quitté sa case que si le serpent n'a pas grandi
+		if (serpent->corps.taille == avant->taille[s])
 		{
-			lesX[0] = 1;		// faire apparaitre à droite
-			*teleporter = true; // quand le serpent traverse le trou
-			*sortieDuTrou = true;
+			delta->queueX[s] = avant->queueX[s];
+			delta->queueY[s] = avant->queueY[s];
 		}
-		else if (lesY[0] <= 0)
+		if (serpent->nbPommesMangees != avant->nbPommes[s])
 		{
-			lesY[0] = HAUTEUR_PLATEAU; // faire apparaitre en haut
-			*teleporter = true;		   // quand le serpent traverse le trou
-			*sortieDuTrou = true;
+			delta->evenements |= (s == 0) ? EVENEMENT_POMME_S1 : EVENEMENT_POMME_S2;
+			if (!etat->gagne)
+			{
+				delta->pommeX = etat->pommeX;
+				delta->pommeY = etat->pommeY;
+			}
 		}
-		else if (lesY[0] > HAUTEUR_PLATEAU)
+	}
+	delta->evenements |= etat->serpents[0].collision ? EVENEMENT_COLLISION_S1 : 0;
+	delta->evenements |= etat->serpents[1].collision ? EVENEMENT_COLLISION_S2 : 0;
+	delta->evenements |= partieFinie(etat) ? EVENEMENT_FIN : 0;
+}
+
+/**
+ * @brief Procédure qui code la position de départ d'une partie.
+ * @param etat de type tEtatJeu, Entrée : la partie qui vient d'être initialisée
+ * @param initial de type tEtatInitial, Sortie : les anneaux des deux serpents et la pomme
+ */
+void coderEtatInitial(tEtatJeu *etat, tEtatInitial *initial)
+{
+	for (int s = 0; s < 2; s++)
+	{
+		for (int i = 0; i < PROTOCOLE_TAILLE_INITIALE; i++)
 		{
-			lesY[0] = 1;		// faire apparaitre en bas
-			*teleporter = true; // quand le serpent traverse le trou
-			*sortieDuTrou = true;
+			initial->anneauxX[s][i] = anneauxX(&etat->serpents[s].corps)[i];
+			initial->anneauxY[s][i] = anneauxY(&etat->serpents[s].corps)[i];
 		}
 	}
+	initial->pommeX = etat->pommeX;
+	initial->pommeY = etat->pommeY;
+}
 
-	*pomme = false;
-	// détection d'une "collision" avec une pomme
-	if (plateau[lesX[0]][lesY[0]] == POMME)
+/**
+ * @brief Fonction qui ouvre le flux de spectateur et y écrit le plateau et la position de
+ * départ (voir protocole.h). Un tube nommé attend ici qu'un spectateur l'ouvre.
+ * @param chemin de type char tableau, Entrée : le fichier ou le tube nommé du flux
+ * @param etat de type tEtatJeu, Entrée : la partie qui vient d'être initialisée
+ * @return le descripteur du flux, ou -1 en cas d'erreur
+ */
+int ouvrirFlux(const char *chemin, tEtatJeu *etat)
+{
+	int flux = open(chemin, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (flux < 0)
 	{
-		*pomme = true;
-		// la pomme disparait du plateau
-		plateau[lesX[0]][lesY[0]] = VIDE;
+		perror(chemin);
+		return -1;
+	}
+	// un spectateur qui part ne doit pas arrêter la partie
+	signal(SIGPIPE, SIG_IGN);
+
+	tEntete entete = {MESSAGE_PLATEAU, 0, 1};
+	tDimensions dimensions = {LARGEUR_PLATEAU, HAUTEUR_PLATEAU};
+	char cases[LARGEUR_PLATEAU * HAUTEUR_PLATEAU];
+	for (int x = 1; x <= LARGEUR_PLATEAU; x++)
+	{
+		memcpy(&cases[(x - 1) * HAUTEUR_PLATEAU], &etat->plateau[x][1], HAUTEUR_PLATEAU);
 	}
-	// détection d'une collision avec la bordure
-	else if (plateau[lesX[0]][lesY[0]] == BORDURE)
+	tEtatInitial initial;
+	coderEtatInitial(etat, &initial);
+	tEntete enteteEtat = {MESSAGE_ETATS, 0, 1};
+	if (!ecrireFlux(flux, &entete, sizeof(entete)) || !ecrireFlux(flux, &dimensions, sizeof(dimensions))
+		|| !ecrireFlux(flux, cases, sizeof(cases)) || !ecrireFlux(flux, &enteteEtat, sizeof(enteteEtat))
+		|| !ecrireFlux(flux, &initial, sizeof(initial)))
 	{
-		*collision = true;
+		perror(chemin);
+		close(flux);
+		return -1;
 	}
+	return flux;
+}
 
-	dessinerSerpent1(lesX, lesY);
+/**
+ * @brief Fonction qui écrit des octets en entier dans le flux.
+ * @param flux de type int, Entrée : le descripteur du flux
+ * @param octets de type void*, Entrée : les octets à écrire
+ * @param taille de type size_t, Entrée : leur nombre
+ * @return false si l'écriture a échoué
+ */
+bool ecrireFlux(int flux, const void *octets, size_t taille)
+{
+	const unsigned char *debut = octets;
+	while (taille > 0)
+	{
+		ssize_t ecrits = write(flux, debut, taille);
+		if (ecrits < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			return false;
+		}
+		debut += ecrits;
+		taille -= ecrits;
+	}
+	return true;
 }
 
 /**
- * @brief Procédure qui calcule la prochaine position du serpent et qui l'affiche,
- * elle permet aussi de savoir si le serpent entre en collision avec une bordure, un pavé, ou une pomme.
- * @param lesX de type int tableau, Entrée : le tableau des X de N élément
- * @param lesY de type int tableau, Entrée : le tableau des Y de N élément
- * @param plateau de type tPlateau, qui donne en Entrée le plateau du jeu
- * @param direction de type char, Entrée : la direction du serpent attribuée aux touches 'z' 'q' 's' 'd'
- * @param collision de type bool, vérifie si il y a une collision
- * @param pomme de type bool, vérifie si une pomme est mangée
- * @param teleporter de type bool, vérifie si le serpent s'est téléporter
+ * @brief Fonction qui publie le delta d'un tour : un seul appel système par tour.
+ * @param flux de type int, Entrée : le descripteur du flux
+ * @param delta de type tDelta, Entrée : le delta du tour
+ * @return false si le flux est fermé
  */
-void progresser2(int lesX[], int lesY[], char direction, tPlateau plateau, bool *collision, bool *pomme, bool *teleporter, bool *sortieDuTrou)
+bool publierDelta(int flux, const tDelta *delta)
 {
-	// efface le dernier élément avant d'actualiser la position de tous les
-	// élémentds du serpent avant de le  redessiner et détecte une
-	// collision avec une pomme ou avec une bordure
-	effacer(lesX[TAILLE - 1], lesY[TAILLE - 1]);
+	unsigned char message[sizeof(tEntete) + sizeof(tDelta)];
+	tEntete entete = {MESSAGE_DELTAS, 0, 1};
+	memcpy(message, &entete, sizeof(entete));
+	memcpy(message + sizeof(entete), delta, sizeof(*delta));
+	return ecrireFlux(flux, message, sizeof(message));
+}
 
-	for (int i = TAILLE - 1; i > 0; i--)
+/************************************************/
+/*				 TELEMETRIE 					*/
+/************************************************/
+
+/**
+ * @brief Fonction qui crée le segment de mémoire partagée de télémétrie et le projette
+ * en mémoire. Le segment existant d'une partie précédente est réutilisé.
+ * @param nom de type char tableau, Entrée : le nom POSIX du segment, commençant par '/'
+ * @return le segment projeté, ou NULL en cas d'erreur (message affiché)
+ */
+tSegmentTelemetrie *ouvrirTelemetrie(const char *nom)
+{
+	int descripteur = shm_open(nom, O_CREAT | O_RDWR, 0644);
+	if (descripteur < 0)
 	{
-		lesX[i] = lesX[i - 1];
-		lesY[i] = lesY[i - 1];
+		perror("shm_open");
+		return NULL;
 	}
-	// faire progresser la tete dans la nouvelle direction
-	switch (direction)
+	if (ftruncate(descripteur, sizeof(tSegmentTelemetrie)) < 0)
 	{
-	case HAUT:
-		lesY[0] = lesY[0] - 1;
-		break;
-	case BAS:
-		lesY[0] = lesY[0] + 1;
-		break;
-	case DROITE:
-		lesX[0] = lesX[0] + 1;
-		break;
-	case GAUCHE:
-		lesX[0] = lesX[0] - 1;
-		break;
+		perror("ftruncate");
+		close(descripteur);
+		return NULL;
 	}
-
-	// Faire des trous dans les bordures
-	for (int i = 1; i < TAILLE; i++)
+	tSegmentTelemetrie *segment = mmap(NULL, sizeof(tSegmentTelemetrie), PROT_READ | PROT_WRITE, MAP_SHARED, descripteur, 0);
+	close(descripteur);
+	if (segment == MAP_FAILED)
 	{
-		if (lesX[0] <= 0)
-		{
-			lesX[0] = LARGEUR_PLATEAU; // faire apparaitre à gauche
-			*teleporter = true;		   // quand le serpent traverse le trou
-			*sortieDuTrou = true;
-		}
-		else if (lesX[0] > LARGEUR_PLATEAU)
-		{
-			lesX[0] = 1;		// faire apparaitre à droite
-			*teleporter = true; // quand le serpent traverse le trou
-			*sortieDuTrou = true;
-		}
-		else if (lesY[0] <= 0)
-		{
-			lesY[0] = HAUTEUR_PLATEAU; // faire apparaitre en haut
-			*teleporter = true;		   // quand le serpent traverse le trou
-			*sortieDuTrou = true;
-		}
-		else if (lesY[0] > HAUTEUR_PLATEAU)
-		{
-			lesY[0] = 1;		// faire apparaitre en bas
-			*teleporter = true; // quand le serpent traverse le trou
-			*sortieDuTrou = true;
-		}
+		perror("mmap");
+		return NULL;
 	}
+	segment->pid = getpid();
+	atomic_store(&segment->sequence, 0);
+	memset(&segment->mesures, 0, sizeof(segment->mesures));
+	segment->magique = TELEMETRIE_MAGIQUE;
+	return segment;
+}
 
-	*pomme = false;
-	// détection d'une "collision" avec une pomme
-	if (plateau[lesX[0]][lesY[0]] == POMME)
+/**
+ * @brief Procédure qui relève les mesures d'un tour dans l'état de la partie.
+ * La plus longue latence est gardée d'un appel à l'autre dans mesures, mis à zéro au départ.
+ * @param etat de type tEtatJeu, Entrée : la partie
+ * @param tour de type uint64_t, Entrée : le numéro du tour
+ * @param latence de type long long, Entrée : la durée des décisions du tour, en nanosecondes
+ * @param mesures de type tMesures, Entrée/Sortie : les mesures à remplir
+ */
+void mesurerPartie(const tEtatJeu *etat, uint64_t tour, long long latence, tMesures *mesures)
+{
+	mesures->tour = tour;
+	for (int s = 0; s < 2; s++)
 	{
-		*pomme = true;
-		// la pomme disparait du plateau
-		plateau[lesX[0]][lesY[0]] = VIDE;
+		const tSerpent *serpent = &etat->serpents[s];
+		mesures->pommes[s] = serpent->nbPommesMangees;
+		mesures->deplacements[s] = serpent->deplacements;
+		mesures->tailles[s] = serpent->corps.taille;
+		// même règle que choisirObjectif : le trou tant que le serpent ne l'a pas traversé
+		mesures->objectifs[s] = serpent->teleporter ? CHEMIN_POMME : serpent->meilleureDistance;
 	}
-	// détection d'une collision avec la bordure
-	else if (plateau[lesX[0]][lesY[0]] == BORDURE)
+	mesures->latenceDecision = latence;
+	if ((uint64_t)latence > mesures->latenceMax)
 	{
-		*collision = true;
+		mesures->latenceMax = latence;
 	}
+	mesures->enCours = !etat->gagne && !etat->serpents[0].collision && !etat->serpents[1].collision;
+}
 
-	dessinerSerpent2(lesX, lesY);
+/**
+ * @brief Procédure qui détache le segment de télémétrie et retire son nom : un moniteur
+ * qui l'a déjà ouvert garde les dernières mesures.
+ * @param segment de type tSegmentTelemetrie, Entrée : le segment projeté
+ * @param nom de type char tableau, Entrée : le nom POSIX du segment
+ */
+void fermerTelemetrie(tSegmentTelemetrie *segment, const char *nom)
+{
+	munmap(segment, sizeof(tSegmentTelemetrie));
+	shm_unlink(nom);
 }
 
 /************************************************/
 /*				 FONCTIONS UTILITAIRES 			*/
 /************************************************/
 
+// passe à true sur SIGINT ou SIGTERM pour arrêter proprement la boucle du serveur, de l'hôte,
+// du tournoi, du banc de cartes ou du jeu de données
+volatile sig_atomic_t arretDemande = false;
+
+/**
+ * @brief Procédure appelée sur SIGINT ou SIGTERM : demande l'arrêt de la boucle en cours.
+ */
+void demanderArret(int signal)
+{
+	(void)signal;
+	arretDemande = true;
+}
+
 /**
  * @brief Procédure qui va aux coordonées X et Y donnée en parametre
  * @param x de type int, Entrée : la coordonnée de x